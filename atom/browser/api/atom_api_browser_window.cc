@@ -4,6 +4,7 @@
 
 #include "atom/browser/api/atom_api_browser_window.h"
 
+#include <algorithm>
 #include <memory>
 
 #include "atom/browser/browser.h"
@@ -14,10 +15,13 @@
 #include "atom/common/api/constructor.h"
 #include "atom/common/color_util.h"
 #include "atom/common/native_mate_converters/callback.h"
+#include "atom/common/native_mate_converters/gfx_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "content/browser/renderer_host/render_widget_host_impl.h"
+#include "content/public/browser/render_frame_host.h"
 #include "content/public/browser/render_process_host.h"
 #include "content/public/browser/render_view_host.h"
 #include "native_mate/dictionary.h"
@@ -29,6 +33,28 @@ namespace atom {
 
 namespace api {
 
+namespace {
+
+// Returns whether |changes| to a list of |old_size| regions set every region
+// added by growing it to |size|.
+bool AreDraggableRegionChangesComplete(
+    size_t old_size,
+    uint32_t size,
+    const std::vector<DraggableRegionChange>& changes) {
+  if (size <= old_size)
+    return true;
+  if (size - old_size > changes.size())
+    return false;
+  std::vector<bool> added(size - old_size, false);
+  for (const DraggableRegionChange& change : changes) {
+    if (change.index >= old_size && change.index < size)
+      added[change.index - old_size] = true;
+  }
+  return std::find(added.begin(), added.end(), false) == added.end();
+}
+
+}  // namespace
+
 BrowserWindow::BrowserWindow(v8::Isolate* isolate,
                              v8::Local<v8::Object> wrapper,
                              const mate::Dictionary& options)
@@ -94,6 +120,12 @@ BrowserWindow::BrowserWindow(v8::Isolate* isolate,
 
   // Init window after everything has been setup.
   window()->InitFromOptions(options);
+
+  static bool first_window = true;
+  if (first_window) {
+    first_window = false;
+    RecordStartupMark("FirstBrowserWindow");
+  }
 }
 
 BrowserWindow::~BrowserWindow() {
@@ -178,12 +210,45 @@ bool BrowserWindow::OnMessageReceived(const IPC::Message& message,
   bool handled = true;
   IPC_BEGIN_MESSAGE_MAP_WITH_PARAM(BrowserWindow, message, rfh)
     IPC_MESSAGE_HANDLER(AtomFrameHostMsg_UpdateDraggableRegions,
-                        UpdateDraggableRegions)
+                        OnUpdateDraggableRegions)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
   return handled;
 }
 
+void BrowserWindow::OnUpdateDraggableRegions(
+    content::RenderFrameHost* rfh,
+    uint32_t version,
+    uint32_t size,
+    const std::vector<DraggableRegionChange>& changes) {
+  // The changes can only be applied to the previous version of the same
+  // frame, and must describe every region the list grows by, otherwise ask
+  // for the whole list.
+  auto frame_id =
+      std::make_pair(rfh->GetProcess()->GetID(), rfh->GetRoutingID());
+  bool is_reset = version == 1;
+  if ((!is_reset && (frame_id != draggable_regions_frame_id_ ||
+                     version != draggable_regions_version_ + 1)) ||
+      !AreDraggableRegionChangesComplete(
+          is_reset ? 0 : draggable_regions_.size(), size, changes)) {
+    rfh->Send(new AtomFrameMsg_ResendDraggableRegions(rfh->GetRoutingID()));
+    return;
+  }
+  if (is_reset) {
+    draggable_regions_.clear();
+    draggable_regions_frame_id_ = frame_id;
+  }
+  draggable_regions_version_ = version;
+
+  draggable_regions_.resize(size);
+  for (const DraggableRegionChange& change : changes) {
+    if (change.index >= size)
+      continue;
+    draggable_regions_[change.index] = change.region;
+  }
+  UpdateDraggableRegions(rfh, draggable_regions_);
+}
+
 void BrowserWindow::OnCloseContents() {
   DCHECK(web_contents());
 
@@ -342,6 +407,18 @@ bool BrowserWindow::IsWebViewFocused() {
   return host_view && host_view->HasFocus();
 }
 
+std::vector<mate::Dictionary> BrowserWindow::GetDraggableRegions(
+    v8::Isolate* isolate) {
+  std::vector<mate::Dictionary> regions;
+  for (const DraggableRegion& region : draggable_regions_) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("draggable", region.draggable);
+    dict.Set("bounds", region.bounds);
+    regions.push_back(dict);
+  }
+  return regions;
+}
+
 v8::Local<v8::Value> BrowserWindow::GetWebContents(v8::Isolate* isolate) {
   if (web_contents_.IsEmpty())
     return v8::Null(isolate);
@@ -417,6 +494,7 @@ void BrowserWindow::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("focusOnWebView", &BrowserWindow::FocusOnWebView)
       .SetMethod("blurWebView", &BrowserWindow::BlurWebView)
       .SetMethod("isWebViewFocused", &BrowserWindow::IsWebViewFocused)
+      .SetMethod("_getDraggableRegions", &BrowserWindow::GetDraggableRegions)
       .SetProperty("webContents", &BrowserWindow::GetWebContents);
 }
 
@@ -7,6 +7,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "atom/browser/api/atom_api_top_level_window.h"
@@ -80,6 +81,10 @@ class BrowserWindow : public TopLevelWindow,
   bool IsWebViewFocused();
   v8::Local<v8::Value> GetWebContents(v8::Isolate* isolate);
 
+  // The draggable regions of the window as the browser sees them, used to
+  // test the incremental updates.
+  std::vector<mate::Dictionary> GetDraggableRegions(v8::Isolate* isolate);
+
  private:
 #if defined(OS_MACOSX)
   void OverrideNSWindowContentView(brightray::InspectableWebContents* iwc);
@@ -87,7 +92,15 @@ class BrowserWindow : public TopLevelWindow,
 
   // Helpers.
 
-  // Called when the window needs to update its draggable region.
+  // Applies an update of the draggable regions sent by the renderer.
+  void OnUpdateDraggableRegions(
+      content::RenderFrameHost* rfh,
+      uint32_t version,
+      uint32_t size,
+      const std::vector<DraggableRegionChange>& changes);
+
+  // Called when the window needs to update its draggable region, |rfh| is
+  // nullptr when the update is not caused by a change of the regions.
   void UpdateDraggableRegions(content::RenderFrameHost* rfh,
                               const std::vector<DraggableRegion>& regions);
 
@@ -108,8 +121,15 @@ class BrowserWindow : public TopLevelWindow,
   // it should be cancelled when we can prove that the window is responsive.
   base::CancelableClosure window_unresponsive_closure_;
 
-#if defined(OS_MACOSX)
+  // The draggable regions of the frame that sent them last, and the version
+  // the frame gave them.
   std::vector<DraggableRegion> draggable_regions_;
+  std::pair<int, int> draggable_regions_frame_id_;
+  uint32_t draggable_regions_version_ = 0;
+
+#if defined(OS_MACOSX)
+  // The rects excluded from dragging by the last update.
+  std::vector<gfx::Rect> drag_exclude_rects_;
 #endif
 
   v8::Global<v8::Value> web_contents_;
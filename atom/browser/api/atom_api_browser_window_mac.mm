@@ -80,6 +80,22 @@ void BrowserWindow::UpdateDraggableRegions(
   NSInteger webViewWidth = NSWidth([webView bounds]);
   NSInteger webViewHeight = NSHeight([webView bounds]);
 
+  // Draggable regions is implemented by having the whole web view draggable
+  // (mouseDownCanMoveWindow) and overlaying regions that are not draggable.
+  std::vector<gfx::Rect> drag_exclude_rects;
+  if (regions.empty()) {
+    drag_exclude_rects.push_back(gfx::Rect(0, 0, webViewWidth, webViewHeight));
+  } else {
+    drag_exclude_rects = CalculateNonDraggableRegions(
+        DraggableRegionsToSkRegion(regions), webViewWidth, webViewHeight);
+  }
+
+  // Rebuilding the views is expensive, skip it when the renderer sent
+  // regions that exclude the same rects.
+  if (rfh && drag_exclude_rects == drag_exclude_rects_)
+    return;
+  drag_exclude_rects_ = drag_exclude_rects;
+
   if ([webView respondsToSelector:@selector(setMouseDownCanMoveWindow:)]) {
     [webView setMouseDownCanMoveWindow:YES];
   }
@@ -93,17 +109,6 @@ void BrowserWindow::UpdateDraggableRegions(
     if ([subview isKindOfClass:[ControlRegionView class]])
       [subview removeFromSuperview];
 
-  // Draggable regions is implemented by having the whole web view draggable
-  // (mouseDownCanMoveWindow) and overlaying regions that are not draggable.
-  draggable_regions_ = regions;
-  std::vector<gfx::Rect> drag_exclude_rects;
-  if (regions.empty()) {
-    drag_exclude_rects.push_back(gfx::Rect(0, 0, webViewWidth, webViewHeight));
-  } else {
-    drag_exclude_rects = CalculateNonDraggableRegions(
-        DraggableRegionsToSkRegion(regions), webViewWidth, webViewHeight);
-  }
-
   if (window_->browser_view())
     window_->browser_view()->UpdateDraggableRegions(drag_exclude_rects);
 
@@ -4,7 +4,11 @@
 
 #include "atom/browser/api/atom_api_browser_window.h"
 
+#include <memory>
+#include <utility>
+
 #include "atom/browser/native_window_views.h"
+#include "third_party/skia/include/core/SkRegion.h"
 
 namespace atom {
 
@@ -15,8 +19,11 @@ void BrowserWindow::UpdateDraggableRegions(
     const std::vector<DraggableRegion>& regions) {
   if (window_->has_frame())
     return;
-  static_cast<NativeWindowViews*>(window_.get())
-      ->UpdateDraggableRegions(DraggableRegionsToSkRegion(regions));
+  auto* window = static_cast<NativeWindowViews*>(window_.get());
+  std::unique_ptr<SkRegion> region = DraggableRegionsToSkRegion(regions);
+  if (window->draggable_region() && *window->draggable_region() == *region)
+    return;
+  window->UpdateDraggableRegions(std::move(region));
 }
 
 }  // namespace api
@@ -4,14 +4,19 @@
 
 #include "atom/browser/api/atom_api_cookies.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/request_context_delegate.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/barrier_closure.h"
+#include "base/memory/ref_counted.h"
+#include "base/strings/string_piece.h"
 #include "base/time/time.h"
 #include "base/values.h"
 #include "content/public/browser/browser_context.h"
@@ -80,6 +85,18 @@ struct Converter<net::CookieChangeCause> {
   }
 };
 
+template <>
+struct Converter<atom::CookieDetails> {
+  static v8::Local<v8::Value> ToV8(v8::Isolate* isolate,
+                                   const atom::CookieDetails& val) {
+    mate::Dictionary dict(isolate, v8::Object::New(isolate));
+    dict.Set("cookie", *val.cookie);
+    dict.Set("cause", val.cause);
+    dict.Set("removed", val.removed);
+    return dict.GetHandle();
+  }
+};
+
 }  // namespace mate
 
 namespace atom {
@@ -88,44 +105,64 @@ namespace api {
 
 namespace {
 
-// Returns whether |domain| matches |filter|.
-bool MatchesDomain(std::string filter, const std::string& domain) {
-  // Add a leading '.' character to the filter domain if it doesn't exist.
-  if (net::cookie_util::DomainIsHostOnly(filter))
-    filter.insert(0, ".");
-
-  std::string sub_domain(domain);
-  // Strip any leading '.' character from the input cookie domain.
-  if (!net::cookie_util::DomainIsHostOnly(sub_domain))
-    sub_domain = sub_domain.substr(1);
-
-  // Now check whether the domain argument is a subdomain of the filter domain.
-  for (sub_domain.insert(0, "."); sub_domain.length() >= filter.length();) {
-    if (sub_domain == filter)
-      return true;
-    const size_t next_dot = sub_domain.find('.', 1);  // Skip over leading dot.
-    sub_domain.erase(0, next_dot);
+// The filter of Cookies::Get, read once so matching each cookie of the store
+// neither looks up the dictionary nor copies strings.
+class CookieFilter {
+ public:
+  explicit CookieFilter(const base::DictionaryValue& filter) {
+    has_name_ = filter.GetString("name", &name_);
+    has_path_ = filter.GetString("path", &path_);
+    has_domain_ = filter.GetString("domain", &domain_);
+    // "example.com" and ".example.com" both match example.com and its
+    // subdomains.
+    if (has_domain_ && !net::cookie_util::DomainIsHostOnly(domain_))
+      domain_.erase(0, 1);
+    has_secure_ = filter.GetBoolean("secure", &secure_);
+    has_session_ = filter.GetBoolean("session", &session_);
   }
-  return false;
-}
 
-// Returns whether |cookie| matches |filter|.
-bool MatchesCookie(const base::DictionaryValue* filter,
-                   const net::CanonicalCookie& cookie) {
-  std::string str;
-  bool b;
-  if (filter->GetString("name", &str) && str != cookie.Name())
-    return false;
-  if (filter->GetString("path", &str) && str != cookie.Path())
-    return false;
-  if (filter->GetString("domain", &str) && !MatchesDomain(str, cookie.Domain()))
-    return false;
-  if (filter->GetBoolean("secure", &b) && b != cookie.IsSecure())
-    return false;
-  if (filter->GetBoolean("session", &b) && b != !cookie.IsPersistent())
-    return false;
-  return true;
-}
+  bool Matches(const net::CanonicalCookie& cookie) const {
+    if (has_name_ && name_ != cookie.Name())
+      return false;
+    if (has_path_ && path_ != cookie.Path())
+      return false;
+    if (has_domain_ && !MatchesDomain(cookie.Domain()))
+      return false;
+    if (has_secure_ && secure_ != cookie.IsSecure())
+      return false;
+    if (has_session_ && session_ != !cookie.IsPersistent())
+      return false;
+    return true;
+  }
+
+ private:
+  // Returns whether |domain| is the filter's domain or one of its subdomains.
+  bool MatchesDomain(const std::string& domain) const {
+    if (domain_.empty())
+      return false;
+    base::StringPiece host(domain);
+    // Strip any leading '.' character from the cookie domain.
+    if (!net::cookie_util::DomainIsHostOnly(domain))
+      host.remove_prefix(1);
+    if (!host.ends_with(domain_))
+      return false;
+    return host.size() == domain_.size() ||
+           host[host.size() - domain_.size() - 1] == '.';
+  }
+
+  bool has_name_ = false;
+  bool has_path_ = false;
+  bool has_domain_ = false;
+  bool has_secure_ = false;
+  bool has_session_ = false;
+  std::string name_;
+  std::string path_;
+  std::string domain_;
+  bool secure_ = false;
+  bool session_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(CookieFilter);
+};
 
 // Helper to returns the CookieStore.
 inline net::CookieStore* GetCookieStore(
@@ -142,9 +179,10 @@ void RunCallbackInUI(const base::Closure& callback) {
 void FilterCookies(std::unique_ptr<base::DictionaryValue> filter,
                    const Cookies::GetCallback& callback,
                    const net::CookieList& list) {
+  CookieFilter cookie_filter(*filter);
   net::CookieList result;
   for (const auto& cookie : list) {
-    if (MatchesCookie(filter.get(), cookie))
+    if (cookie_filter.Matches(cookie))
       result.push_back(cookie);
   }
   RunCallbackInUI(base::Bind(callback, Cookies::SUCCESS, result));
@@ -190,68 +228,154 @@ void FlushCookieStoreOnIOThread(
   GetCookieStore(getter)->FlushStore(base::BindOnce(RunCallbackInUI, callback));
 }
 
-// Sets cookie with |details| in IO thread.
-void SetCookieOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
-                   std::unique_ptr<base::DictionaryValue> details,
-                   const Cookies::SetCallback& callback) {
+// Creates the cookie described by |details|, returns nullptr if it is invalid.
+std::unique_ptr<net::CanonicalCookie> CreateCookie(
+    const base::DictionaryValue& details) {
   std::string url, name, value, domain, path;
   bool secure = false;
   bool http_only = false;
   double creation_date;
   double expiration_date;
   double last_access_date;
-  details->GetString("url", &url);
-  details->GetString("name", &name);
-  details->GetString("value", &value);
-  details->GetString("domain", &domain);
-  details->GetString("path", &path);
-  details->GetBoolean("secure", &secure);
-  details->GetBoolean("httpOnly", &http_only);
+  details.GetString("url", &url);
+  details.GetString("name", &name);
+  details.GetString("value", &value);
+  details.GetString("domain", &domain);
+  details.GetString("path", &path);
+  details.GetBoolean("secure", &secure);
+  details.GetBoolean("httpOnly", &http_only);
 
   base::Time creation_time;
-  if (details->GetDouble("creationDate", &creation_date)) {
+  if (details.GetDouble("creationDate", &creation_date)) {
     creation_time = (creation_date == 0)
                         ? base::Time::UnixEpoch()
                         : base::Time::FromDoubleT(creation_date);
   }
 
   base::Time expiration_time;
-  if (details->GetDouble("expirationDate", &expiration_date)) {
+  if (details.GetDouble("expirationDate", &expiration_date)) {
     expiration_time = (expiration_date == 0)
                           ? base::Time::UnixEpoch()
                           : base::Time::FromDoubleT(expiration_date);
   }
 
   base::Time last_access_time;
-  if (details->GetDouble("lastAccessDate", &last_access_date)) {
+  if (details.GetDouble("lastAccessDate", &last_access_date)) {
     last_access_time = (last_access_date == 0)
                            ? base::Time::UnixEpoch()
                            : base::Time::FromDoubleT(last_access_date);
   }
 
+  if (url.empty() || name.empty())
+    return nullptr;
   std::unique_ptr<net::CanonicalCookie> canonical_cookie(
       net::CanonicalCookie::CreateSanitizedCookie(
           GURL(url), name, value, domain, path, creation_time, expiration_time,
           last_access_time, secure, http_only,
           net::CookieSameSite::DEFAULT_MODE, net::COOKIE_PRIORITY_DEFAULT));
+  if (!canonical_cookie || !canonical_cookie->IsCanonical())
+    return nullptr;
+  return canonical_cookie;
+}
+
+// Sets cookie with |details| in IO thread.
+void SetCookieOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
+                   std::unique_ptr<base::DictionaryValue> details,
+                   const Cookies::SetCallback& callback) {
   auto completion_callback = base::BindOnce(OnSetCookie, callback);
-  if (!canonical_cookie || !canonical_cookie->IsCanonical()) {
-    std::move(completion_callback).Run(false);
-    return;
-  }
-  if (url.empty()) {
-    std::move(completion_callback).Run(false);
-    return;
-  }
-  if (name.empty()) {
+  std::unique_ptr<net::CanonicalCookie> canonical_cookie =
+      CreateCookie(*details);
+  if (!canonical_cookie) {
     std::move(completion_callback).Run(false);
     return;
   }
+  bool secure = canonical_cookie->IsSecure();
+  bool http_only = canonical_cookie->IsHttpOnly();
   GetCookieStore(getter)->SetCanonicalCookieAsync(
       std::move(canonical_cookie), secure, http_only,
       std::move(completion_callback));
 }
 
+// Collects the results of the cookies set by SetCookiesOnIO, and runs the
+// callback once all of them are done.
+class SetCookiesResult : public base::RefCounted<SetCookiesResult> {
+ public:
+  SetCookiesResult(const Cookies::SetManyCallback& callback, size_t count)
+      : callback_(callback), pending_(count) {
+    if (pending_ == 0)
+      Done();
+  }
+
+  void OnSetCookie(int index, bool success) {
+    if (!success)
+      failed_.push_back(index);
+    if (--pending_ == 0)
+      Done();
+  }
+
+ private:
+  friend class base::RefCounted<SetCookiesResult>;
+  ~SetCookiesResult() {}
+
+  void Done() {
+    std::sort(failed_.begin(), failed_.end());
+    RunCallbackInUI(base::Bind(
+        callback_, failed_.empty() ? Cookies::SUCCESS : Cookies::FAILED,
+        failed_));
+  }
+
+  Cookies::SetManyCallback callback_;
+  size_t pending_;
+  std::vector<int> failed_;
+
+  DISALLOW_COPY_AND_ASSIGN(SetCookiesResult);
+};
+
+// Sets the cookies of |list| in IO thread.
+void SetCookiesOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
+                    std::unique_ptr<base::ListValue> list,
+                    const Cookies::SetManyCallback& callback) {
+  scoped_refptr<SetCookiesResult> result(
+      new SetCookiesResult(callback, list->GetSize()));
+  net::CookieStore* store = GetCookieStore(getter);
+  for (size_t i = 0; i < list->GetSize(); ++i) {
+    const base::DictionaryValue* details = nullptr;
+    std::unique_ptr<net::CanonicalCookie> canonical_cookie;
+    if (list->GetDictionary(i, &details))
+      canonical_cookie = CreateCookie(*details);
+    if (!canonical_cookie) {
+      result->OnSetCookie(static_cast<int>(i), false);
+      continue;
+    }
+    bool secure = canonical_cookie->IsSecure();
+    bool http_only = canonical_cookie->IsHttpOnly();
+    store->SetCanonicalCookieAsync(
+        std::move(canonical_cookie), secure, http_only,
+        base::BindOnce(&SetCookiesResult::OnSetCookie, result,
+                       static_cast<int>(i)));
+  }
+}
+
+// Removes the cookies of |list|, each with an url and a name, in IO thread.
+void RemoveCookiesOnIO(scoped_refptr<net::URLRequestContextGetter> getter,
+                       std::unique_ptr<base::ListValue> list,
+                       const base::Closure& callback) {
+  std::vector<std::pair<GURL, std::string>> cookies;
+  for (const auto& item : list->GetList()) {
+    const base::DictionaryValue* cookie = nullptr;
+    std::string url, name;
+    if (item.GetAsDictionary(&cookie) && cookie->GetString("url", &url) &&
+        cookie->GetString("name", &name))
+      cookies.emplace_back(GURL(url), name);
+  }
+
+  base::RepeatingClosure barrier = base::BarrierClosure(
+      cookies.size(), base::BindOnce(RunCallbackInUI, callback));
+  net::CookieStore* store = GetCookieStore(getter);
+  for (const auto& cookie : cookies)
+    store->DeleteCookieAsync(cookie.first, cookie.second, barrier);
+}
+
 }  // namespace
 
 Cookies::Cookies(v8::Isolate* isolate, AtomBrowserContext* browser_context)
@@ -260,7 +384,7 @@ Cookies::Cookies(v8::Isolate* isolate, AtomBrowserContext* browser_context)
   cookie_change_subscription_ =
       browser_context->GetRequestContextDelegate()
           ->RegisterCookieChangeCallback(
-              base::Bind(&Cookies::OnCookieChanged, base::Unretained(this)));
+              base::Bind(&Cookies::OnCookiesChanged, base::Unretained(this)));
 }
 
 Cookies::~Cookies() {}
@@ -305,8 +429,32 @@ void Cookies::FlushStore(const base::Closure& callback) {
                      callback));
 }
 
-void Cookies::OnCookieChanged(const CookieDetails* details) {
-  Emit("changed", *(details->cookie), details->cause, details->removed);
+void Cookies::SetMany(const base::ListValue& details,
+                      const SetManyCallback& callback) {
+  auto copy = base::ListValue::From(
+      base::Value::ToUniquePtrValue(details.Clone()));
+  auto* getter = browser_context_->GetRequestContext();
+  content::BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(SetCookiesOnIO, base::RetainedRef(getter),
+                     std::move(copy), callback));
+}
+
+void Cookies::RemoveMany(const base::ListValue& cookies,
+                         const base::Closure& callback) {
+  auto copy = base::ListValue::From(
+      base::Value::ToUniquePtrValue(cookies.Clone()));
+  auto* getter = browser_context_->GetRequestContext();
+  content::BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(RemoveCookiesOnIO, base::RetainedRef(getter),
+                     std::move(copy), callback));
+}
+
+void Cookies::OnCookiesChanged(const std::vector<CookieDetails>& changes) {
+  Emit("changes", changes);
+  for (const auto& details : changes)
+    Emit("changed", *(details.cookie), details.cause, details.removed);
 }
 
 // static
@@ -323,6 +471,8 @@ void Cookies::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("get", &Cookies::Get)
       .SetMethod("remove", &Cookies::Remove)
       .SetMethod("set", &Cookies::Set)
+      .SetMethod("setMany", &Cookies::SetMany)
+      .SetMethod("removeMany", &Cookies::RemoveMany)
       .SetMethod("flushStore", &Cookies::FlushStore);
 }
 
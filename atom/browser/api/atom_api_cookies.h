@@ -7,15 +7,18 @@
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/net/cookie_details.h"
+#include "atom/browser/request_context_delegate.h"
 #include "base/callback_list.h"
 #include "native_mate/handle.h"
 #include "net/cookies/canonical_cookie.h"
 
 namespace base {
 class DictionaryValue;
+class ListValue;
 }
 
 namespace net {
@@ -37,6 +40,7 @@ class Cookies : public mate::TrackableObject<Cookies> {
 
   using GetCallback = base::Callback<void(Error, const net::CookieList&)>;
   using SetCallback = base::Callback<void(Error)>;
+  using SetManyCallback = base::Callback<void(Error, const std::vector<int>&)>;
 
   static mate::Handle<Cookies> Create(v8::Isolate* isolate,
                                       AtomBrowserContext* browser_context);
@@ -56,11 +60,18 @@ class Cookies : public mate::TrackableObject<Cookies> {
   void Set(const base::DictionaryValue& details, const SetCallback& callback);
   void FlushStore(const base::Closure& callback);
 
+  // Bulk versions of Set and Remove, which hop to the IO thread only once.
+  void SetMany(const base::ListValue& details,
+               const SetManyCallback& callback);
+  void RemoveMany(const base::ListValue& cookies,
+                  const base::Closure& callback);
+
   // AtomBrowserContext::RegisterCookieChangeCallback subscription:
-  void OnCookieChanged(const CookieDetails*);
+  void OnCookiesChanged(const std::vector<CookieDetails>& changes);
 
  private:
-  std::unique_ptr<base::CallbackList<void(const CookieDetails*)>::Subscription>
+  std::unique_ptr<
+      RequestContextDelegate::CookieChangeCallbackList::Subscription>
       cookie_change_subscription_;
   scoped_refptr<AtomBrowserContext> browser_context_;
 
@@ -167,7 +167,9 @@ void DesktopCapturer::OnSourceMoved(int old_index, int new_index) {}
 
 void DesktopCapturer::OnSourceNameChanged(int index) {}
 
-void DesktopCapturer::OnSourceThumbnailChanged(int index) {}
+void DesktopCapturer::OnSourceThumbnailChanged(int index) {
+  Emit("thumbnail", Source{media_list_->GetSource(index), std::string()});
+}
 
 bool DesktopCapturer::OnRefreshFinished() {
   capture_thread_->PostTask(FROM_HERE,
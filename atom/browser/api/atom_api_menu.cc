@@ -46,18 +46,24 @@ void Menu::AfterInit(v8::Isolate* isolate) {
 }
 
 bool Menu::IsCommandIdChecked(int command_id) const {
+  if (const auto* state = model_->GetCommandState(command_id))
+    return state->checked;
   v8::Locker locker(isolate());
   v8::HandleScope handle_scope(isolate());
   return is_checked_.Run(GetWrapper(), command_id);
 }
 
 bool Menu::IsCommandIdEnabled(int command_id) const {
+  if (const auto* state = model_->GetCommandState(command_id))
+    return state->enabled;
   v8::Locker locker(isolate());
   v8::HandleScope handle_scope(isolate());
   return is_enabled_.Run(GetWrapper(), command_id);
 }
 
 bool Menu::IsCommandIdVisible(int command_id) const {
+  if (const auto* state = model_->GetCommandState(command_id))
+    return state->visible;
   v8::Locker locker(isolate());
   v8::HandleScope handle_scope(isolate());
   return is_visible_.Run(GetWrapper(), command_id);
@@ -67,6 +73,15 @@ bool Menu::GetAcceleratorForCommandIdWithParams(
     int command_id,
     bool use_default_accelerator,
     ui::Accelerator* accelerator) const {
+  if (const auto* state = model_->GetCommandState(command_id)) {
+    if (use_default_accelerator && state->has_default_accelerator) {
+      *accelerator = state->default_accelerator;
+      return true;
+    }
+    if (state->has_accelerator)
+      *accelerator = state->accelerator;
+    return state->has_accelerator;
+  }
   v8::Locker locker(isolate());
   v8::HandleScope handle_scope(isolate());
   v8::Local<v8::Value> val =
@@ -131,8 +146,32 @@ void Menu::SetRole(int index, const base::string16& role) {
   model_->SetRole(index, role);
 }
 
+void Menu::SetCommandState(int command_id,
+                           bool checked,
+                           bool enabled,
+                           bool visible) {
+  auto* state = model_->GetOrCreateCommandState(command_id);
+  state->checked = checked;
+  state->enabled = enabled;
+  state->visible = visible;
+}
+
+void Menu::SetCommandAccelerator(int command_id,
+                                 v8::Local<v8::Value> accelerator,
+                                 v8::Local<v8::Value> default_accelerator) {
+  auto* state = model_->GetOrCreateCommandState(command_id);
+  state->has_accelerator =
+      !accelerator->IsNullOrUndefined() &&
+      mate::ConvertFromV8(isolate(), accelerator, &state->accelerator);
+  state->has_default_accelerator =
+      !default_accelerator->IsNullOrUndefined() &&
+      mate::ConvertFromV8(isolate(), default_accelerator,
+                          &state->default_accelerator);
+}
+
 void Menu::Clear() {
   model_->Clear();
+  model_->ClearCommandStates();
 }
 
 int Menu::GetIndexOfCommandId(int command_id) {
@@ -189,6 +228,8 @@ void Menu::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("setIcon", &Menu::SetIcon)
       .SetMethod("setSublabel", &Menu::SetSublabel)
       .SetMethod("setRole", &Menu::SetRole)
+      .SetMethod("setCommandState", &Menu::SetCommandState)
+      .SetMethod("setCommandAccelerator", &Menu::SetCommandAccelerator)
       .SetMethod("clear", &Menu::Clear)
       .SetMethod("getIndexOfCommandId", &Menu::GetIndexOfCommandId)
       .SetMethod("getItemCount", &Menu::GetItemCount)
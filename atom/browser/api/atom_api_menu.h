@@ -85,6 +85,13 @@ class Menu : public mate::TrackableObject<Menu>,
   void SetIcon(int index, const gfx::Image& image);
   void SetSublabel(int index, const base::string16& sublabel);
   void SetRole(int index, const base::string16& role);
+  void SetCommandState(int command_id,
+                       bool checked,
+                       bool enabled,
+                       bool visible);
+  void SetCommandAccelerator(int command_id,
+                             v8::Local<v8::Value> accelerator,
+                             v8::Local<v8::Value> default_accelerator);
   void Clear();
   int GetIndexOfCommandId(int command_id);
   int GetItemCount() const;
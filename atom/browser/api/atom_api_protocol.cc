@@ -143,6 +143,92 @@ Protocol::ProtocolError Protocol::UninterceptProtocolInIO(
              : PROTOCOL_NOT_INTERCEPTED;
 }
 
+void Protocol::EnableResponseCache(const std::string& scheme,
+                                   mate::Arguments* args) {
+  double max_age = 0;
+  int max_size = -1;
+  mate::Dictionary options;
+  // Both the options and the callback are optional.
+  v8::Local<v8::Value> next = args->PeekNext();
+  if (!next.IsEmpty() && !next->IsFunction() && args->GetNext(&options)) {
+    options.Get("maxAge", &max_age);
+    options.Get("maxSize", &max_size);
+  }
+  if (max_age < 0) {
+    args->ThrowError("maxAge must not be negative");
+    return;
+  }
+  CompletionCallback callback;
+  args->GetNext(&callback);
+  auto* getter = browser_context_->GetRequestContext();
+  content::BrowserThread::PostTaskAndReplyWithResult(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&Protocol::EnableResponseCacheInIO,
+                     base::RetainedRef(getter), scheme,
+                     base::TimeDelta::FromSecondsD(max_age), max_size),
+      base::BindOnce(&Protocol::OnIOCompleted, GetWeakPtr(), callback));
+}
+
+// static
+Protocol::ProtocolError Protocol::EnableResponseCacheInIO(
+    scoped_refptr<brightray::URLRequestContextGetter> request_context_getter,
+    const std::string& scheme,
+    base::TimeDelta max_age,
+    int max_size) {
+  auto* response_cache = static_cast<AtomURLRequestJobFactory*>(
+                             request_context_getter->job_factory())
+                             ->response_cache();
+  response_cache->EnableScheme(scheme, max_age);
+  if (max_size >= 0)
+    response_cache->SetMaxSize(max_size);
+  return PROTOCOL_OK;
+}
+
+void Protocol::DisableResponseCache(const std::string& scheme,
+                                    mate::Arguments* args) {
+  CompletionCallback callback;
+  args->GetNext(&callback);
+  auto* getter = browser_context_->GetRequestContext();
+  content::BrowserThread::PostTaskAndReplyWithResult(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&Protocol::DisableResponseCacheInIO,
+                     base::RetainedRef(getter), scheme),
+      base::BindOnce(&Protocol::OnIOCompleted, GetWeakPtr(), callback));
+}
+
+// static
+Protocol::ProtocolError Protocol::DisableResponseCacheInIO(
+    scoped_refptr<brightray::URLRequestContextGetter> request_context_getter,
+    const std::string& scheme) {
+  static_cast<AtomURLRequestJobFactory*>(request_context_getter->job_factory())
+      ->response_cache()
+      ->DisableScheme(scheme);
+  return PROTOCOL_OK;
+}
+
+void Protocol::ClearResponseCache(mate::Arguments* args) {
+  std::string scheme;
+  args->GetNext(&scheme);
+  CompletionCallback callback;
+  args->GetNext(&callback);
+  auto* getter = browser_context_->GetRequestContext();
+  content::BrowserThread::PostTaskAndReplyWithResult(
+      content::BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&Protocol::ClearResponseCacheInIO,
+                     base::RetainedRef(getter), scheme),
+      base::BindOnce(&Protocol::OnIOCompleted, GetWeakPtr(), callback));
+}
+
+// static
+Protocol::ProtocolError Protocol::ClearResponseCacheInIO(
+    scoped_refptr<brightray::URLRequestContextGetter> request_context_getter,
+    const std::string& scheme) {
+  static_cast<AtomURLRequestJobFactory*>(request_context_getter->job_factory())
+      ->response_cache()
+      ->Clear(scheme);
+  return PROTOCOL_OK;
+}
+
 void Protocol::OnIOCompleted(const CompletionCallback& callback,
                              ProtocolError error) {
   // The completion callback is optional.
@@ -212,7 +298,10 @@ void Protocol::BuildPrototype(v8::Isolate* isolate,
                  &Protocol::InterceptProtocol<URLRequestFetchJob>)
       .SetMethod("interceptStreamProtocol",
                  &Protocol::InterceptProtocol<URLRequestStreamJob>)
-      .SetMethod("uninterceptProtocol", &Protocol::UninterceptProtocol);
+      .SetMethod("uninterceptProtocol", &Protocol::UninterceptProtocol)
+      .SetMethod("enableResponseCache", &Protocol::EnableResponseCache)
+      .SetMethod("disableResponseCache", &Protocol::DisableResponseCache)
+      .SetMethod("clearResponseCache", &Protocol::ClearResponseCache);
 }
 
 }  // namespace api
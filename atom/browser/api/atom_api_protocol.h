@@ -70,9 +70,11 @@ class Protocol : public mate::TrackableObject<Protocol> {
    public:
     CustomProtocolHandler(v8::Isolate* isolate,
                           net::URLRequestContextGetter* request_context,
+                          ProtocolResponseCache* response_cache,
                           const Handler& handler)
         : isolate_(isolate),
           request_context_(request_context),
+          response_cache_(response_cache),
           handler_(handler) {}
     ~CustomProtocolHandler() override {}
 
@@ -80,13 +82,15 @@ class Protocol : public mate::TrackableObject<Protocol> {
         net::URLRequest* request,
         net::NetworkDelegate* network_delegate) const override {
       RequestJob* request_job = new RequestJob(request, network_delegate);
-      request_job->SetHandlerInfo(isolate_, request_context_, handler_);
+      request_job->SetHandlerInfo(isolate_, request_context_, response_cache_,
+                                  handler_);
       return request_job;
     }
 
    private:
     v8::Isolate* isolate_;
     net::URLRequestContextGetter* request_context_;
+    ProtocolResponseCache* response_cache_;
     Protocol::Handler handler_;
 
     DISALLOW_COPY_AND_ASSIGN(CustomProtocolHandler);
@@ -120,7 +124,8 @@ class Protocol : public mate::TrackableObject<Protocol> {
     if (job_factory->IsHandledProtocol(scheme))
       return PROTOCOL_REGISTERED;
     auto protocol_handler = std::make_unique<CustomProtocolHandler<RequestJob>>(
-        isolate, request_context_getter.get(), handler);
+        isolate, request_context_getter.get(), job_factory->response_cache(),
+        handler);
     if (job_factory->SetProtocolHandler(scheme, std::move(protocol_handler)))
       return PROTOCOL_OK;
     else
@@ -168,7 +173,8 @@ class Protocol : public mate::TrackableObject<Protocol> {
     if (!job_factory->HasProtocolHandler(scheme))
       return PROTOCOL_FAIL;
     auto protocol_handler = std::make_unique<CustomProtocolHandler<RequestJob>>(
-        isolate, request_context_getter.get(), handler);
+        isolate, request_context_getter.get(), job_factory->response_cache(),
+        handler);
     if (!job_factory->InterceptProtocol(scheme, std::move(protocol_handler)))
       return PROTOCOL_INTERCEPTED;
     return PROTOCOL_OK;
@@ -180,6 +186,24 @@ class Protocol : public mate::TrackableObject<Protocol> {
       scoped_refptr<brightray::URLRequestContextGetter> request_context_getter,
       const std::string& scheme);
 
+  // Cache the responses of the handler of |scheme| in IO thread.
+  void EnableResponseCache(const std::string& scheme, mate::Arguments* args);
+  static ProtocolError EnableResponseCacheInIO(
+      scoped_refptr<brightray::URLRequestContextGetter> request_context_getter,
+      const std::string& scheme,
+      base::TimeDelta max_age,
+      int max_size);
+  void DisableResponseCache(const std::string& scheme, mate::Arguments* args);
+  static ProtocolError DisableResponseCacheInIO(
+      scoped_refptr<brightray::URLRequestContextGetter> request_context_getter,
+      const std::string& scheme);
+
+  // Remove the cached responses of |scheme|, or of all schemes.
+  void ClearResponseCache(mate::Arguments* args);
+  static ProtocolError ClearResponseCacheInIO(
+      scoped_refptr<brightray::URLRequestContextGetter> request_context_getter,
+      const std::string& scheme);
+
   // Convert error code to JS exception and call the callback.
   void OnIOCompleted(const CompletionCallback& callback, ProtocolError error);
 
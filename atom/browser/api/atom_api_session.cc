@@ -19,7 +19,9 @@
 #include "atom/browser/atom_permission_manager.h"
 #include "atom/browser/browser.h"
 #include "atom/browser/net/atom_cert_verifier.h"
+#include "atom/browser/net/atom_network_delegate.h"
 #include "atom/browser/session_preferences.h"
+#include "atom/common/api/pending_promise.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/content_converter.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
@@ -347,6 +349,86 @@ void DoCacheActionInIO(
     on_get_backend.Run(net::OK);
 }
 
+// Callback of Backend::CalculateSizeOfAllEntries.
+void OnCalculateCacheSize(
+    std::unique_ptr<base::DictionaryValue> statistics,
+    const base::Callback<void(const base::DictionaryValue&)>& callback,
+    int result) {
+  if (result >= 0)
+    statistics->SetInteger("bytes", result);
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+                          base::BindOnce(callback, std::move(*statistics)));
+}
+
+// Callback of HttpCache::GetBackend for getCacheStatistics.
+void OnGetBackendForStatistics(
+    disk_cache::Backend** backend_ptr,
+    std::unique_ptr<base::DictionaryValue> statistics,
+    const base::Callback<void(const base::DictionaryValue&)>& callback,
+    int result) {
+  if (result != net::OK || !backend_ptr || !*backend_ptr) {
+    OnCalculateCacheSize(std::move(statistics), callback, net::ERR_FAILED);
+    return;
+  }
+
+  disk_cache::Backend* backend = *backend_ptr;
+  statistics->SetInteger("entries", backend->GetEntryCount());
+  int size = -1;
+  base::StringPairs stats;
+  backend->GetStats(&stats);
+  for (const auto& stat : stats) {
+    if (stat.first == "Current size") {
+      base::StringToInt(stat.second, &size);
+    } else if (stat.first == "Trim entries") {
+      // The counters of the blockfile backend are printed in hex.
+      int64_t evictions;
+      if (base::HexStringToInt64(stat.second, &evictions))
+        statistics->SetDouble("evictions", evictions);
+    }
+  }
+  if (size >= 0) {
+    OnCalculateCacheSize(std::move(statistics), callback, size);
+    return;
+  }
+
+  // Only the blockfile backend reports its size in the stats.
+  net::CompletionCallback on_calculate_size =
+      base::Bind(&OnCalculateCacheSize, base::Passed(&statistics), callback);
+  int rv = backend->CalculateSizeOfAllEntries(on_calculate_size);
+  if (rv != net::ERR_IO_PENDING)
+    on_calculate_size.Run(rv);
+}
+
+void GetCacheStatisticsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  auto* request_context = context_getter->GetURLRequestContext();
+  int hits, validations, updates, misses;
+  static_cast<AtomNetworkDelegate*>(request_context->network_delegate())
+      ->GetHttpCacheCounters(&hits, &validations, &updates, &misses);
+
+  auto statistics = std::make_unique<base::DictionaryValue>();
+  statistics->SetInteger("hits", hits);
+  statistics->SetInteger("validations", validations);
+  statistics->SetInteger("updates", updates);
+  statistics->SetInteger("misses", misses);
+
+  auto* http_cache = request_context->http_transaction_factory()->GetCache();
+  if (!http_cache) {
+    OnCalculateCacheSize(std::move(statistics), callback, net::ERR_FAILED);
+    return;
+  }
+
+  using BackendPtr = disk_cache::Backend*;
+  auto** backend_ptr = new BackendPtr(nullptr);
+  net::CompletionCallback on_get_backend =
+      base::Bind(&OnGetBackendForStatistics, base::Owned(backend_ptr),
+                 base::Passed(&statistics), callback);
+  int rv = http_cache->GetBackend(backend_ptr, on_get_backend);
+  if (rv != net::ERR_IO_PENDING)
+    on_get_backend.Run(rv);
+}
+
 void SetProxyInIO(scoped_refptr<net::URLRequestContextGetter> getter,
                   const net::ProxyConfig& config,
                   const base::Closure& callback) {
@@ -362,10 +444,28 @@ void SetProxyInIO(scoped_refptr<net::URLRequestContextGetter> getter,
 
 void SetCertVerifyProcInIO(
     const scoped_refptr<net::URLRequestContextGetter>& context_getter,
-    const AtomCertVerifier::VerifyProc& proc) {
+    const AtomCertVerifier::VerifyProc& proc,
+    base::TimeDelta cache_ttl,
+    size_t max_cache_size) {
   auto* request_context = context_getter->GetURLRequestContext();
   static_cast<AtomCertVerifier*>(request_context->cert_verifier())
-      ->SetVerifyProc(proc);
+      ->SetVerifyProc(proc, cache_ttl, max_cache_size);
+}
+
+void GetCertVerifyCacheStatisticsInIO(
+    const scoped_refptr<net::URLRequestContextGetter>& context_getter,
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  auto* request_context = context_getter->GetURLRequestContext();
+  int hits, misses, size;
+  static_cast<AtomCertVerifier*>(request_context->cert_verifier())
+      ->GetCacheStatistics(&hits, &misses, &size);
+
+  base::DictionaryValue statistics;
+  statistics.SetInteger("hits", hits);
+  statistics.SetInteger("misses", misses);
+  statistics.SetInteger("size", size);
+  BrowserThread::PostTask(BrowserThread::UI, FROM_HERE,
+                          base::BindOnce(callback, std::move(statistics)));
 }
 
 void ClearHostResolverCacheInIO(
@@ -426,6 +526,17 @@ void OnClearStorageDataDone(const base::Closure& callback) {
     callback.Run();
 }
 
+void OnPreferencesLoaded(std::unique_ptr<PendingPromise> promise,
+                         PrefService* pref_service) {
+  PendingPromise::Scope scope(promise.get());
+  promise->Resolve(v8::Undefined(promise->isolate()));
+}
+
+void SetDownloadPathPref(const base::FilePath& path,
+                         PrefService* pref_service) {
+  pref_service->SetFilePath(prefs::kDownloadDefaultDirectory, path);
+}
+
 void DownloadIdCallback(content::DownloadManager* download_manager,
                         const base::FilePath& path,
                         const std::vector<GURL>& url_chain,
@@ -531,6 +642,15 @@ void Session::DoCacheAction(const net::CompletionCallback& callback) {
                      action, callback));
 }
 
+void Session::GetCacheStatistics(
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&GetCacheStatisticsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext()),
+                     callback));
+}
+
 void Session::ClearStorageData(mate::Arguments* args) {
   // clearStorageData([options, callback])
   ClearStorageDataOptions options;
@@ -543,7 +663,8 @@ void Session::ClearStorageData(mate::Arguments* args) {
   if (options.storage_types & StoragePartition::REMOVE_DATA_MASK_COOKIES) {
     // Reset media device id salt when cookies are cleared.
     // https://w3c.github.io/mediacapture-main/#dom-mediadeviceinfo-deviceid
-    brightray::MediaDeviceIDSalt::Reset(browser_context()->prefs());
+    browser_context()->RunWhenPrefsLoaded(
+        base::BindOnce(&brightray::MediaDeviceIDSalt::Reset));
   }
   storage_partition->ClearData(
       options.storage_types, options.quota_types, options.origin,
@@ -567,8 +688,16 @@ void Session::SetProxy(const net::ProxyConfig& config,
 }
 
 void Session::SetDownloadPath(const base::FilePath& path) {
-  browser_context_->prefs()->SetFilePath(prefs::kDownloadDefaultDirectory,
-                                         path);
+  browser_context_->RunWhenPrefsLoaded(
+      base::BindOnce(&SetDownloadPathPref, path));
+}
+
+v8::Local<v8::Promise> Session::WhenPreferencesLoaded(v8::Isolate* isolate) {
+  auto promise = std::make_unique<PendingPromise>(isolate);
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  browser_context_->RunWhenPrefsLoaded(
+      base::BindOnce(&OnPreferencesLoaded, std::move(promise)));
+  return handle;
 }
 
 void Session::EnableNetworkEmulation(const mate::Dictionary& options) {
@@ -613,11 +742,34 @@ void Session::SetCertVerifyProc(v8::Local<v8::Value> val,
     return;
   }
 
+  // Caching the results of the proc is opt-in.
+  int cache_ttl = 0;
+  int max_cache_size = 100;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("cacheTTL", &cache_ttl);
+    options.Get("cacheSize", &max_cache_size);
+  }
+  if (cache_ttl < 0 || max_cache_size < 0) {
+    args->ThrowError("cacheTTL and cacheSize must not be negative");
+    return;
+  }
+
   BrowserThread::PostTask(
       BrowserThread::IO, FROM_HERE,
       base::BindOnce(&SetCertVerifyProcInIO,
                      WrapRefCounted(browser_context_->GetRequestContext()),
-                     proc));
+                     proc, base::TimeDelta::FromMilliseconds(cache_ttl),
+                     static_cast<size_t>(max_cache_size)));
+}
+
+void Session::GetCertVerifyCacheStatistics(
+    const base::Callback<void(const base::DictionaryValue&)>& callback) {
+  BrowserThread::PostTask(
+      BrowserThread::IO, FROM_HERE,
+      base::BindOnce(&GetCertVerifyCacheStatisticsInIO,
+                     WrapRefCounted(browser_context_->GetRequestContext()),
+                     callback));
 }
 
 void Session::SetPermissionRequestHandler(v8::Local<v8::Value> val,
@@ -822,13 +974,17 @@ void Session::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("resolveProxy", &Session::ResolveProxy)
       .SetMethod("getCacheSize", &Session::DoCacheAction<CacheAction::STATS>)
       .SetMethod("clearCache", &Session::DoCacheAction<CacheAction::CLEAR>)
+      .SetMethod("getCacheStatistics", &Session::GetCacheStatistics)
       .SetMethod("clearStorageData", &Session::ClearStorageData)
       .SetMethod("flushStorageData", &Session::FlushStorageData)
       .SetMethod("setProxy", &Session::SetProxy)
       .SetMethod("setDownloadPath", &Session::SetDownloadPath)
+      .SetMethod("whenPreferencesLoaded", &Session::WhenPreferencesLoaded)
       .SetMethod("enableNetworkEmulation", &Session::EnableNetworkEmulation)
       .SetMethod("disableNetworkEmulation", &Session::DisableNetworkEmulation)
       .SetMethod("setCertificateVerifyProc", &Session::SetCertVerifyProc)
+      .SetMethod("getCertificateVerifyCacheStatistics",
+                 &Session::GetCertVerifyCacheStatistics)
       .SetMethod("setPermissionRequestHandler",
                  &Session::SetPermissionRequestHandler)
       .SetMethod("setPermissionCheckHandler",
@@ -865,6 +1021,15 @@ v8::Local<v8::Value> FromPartition(const std::string& partition,
   }
   base::DictionaryValue options;
   args->GetNext(&options);
+  std::string cache_backend;
+  if (options.HasKey("cacheBackend") &&
+      (!options.GetString("cacheBackend", &cache_backend) ||
+       (cache_backend != "default" && cache_backend != "simple" &&
+        cache_backend != "blockfile"))) {
+    args->ThrowTypeError(
+        "cacheBackend must be one of 'default', 'simple' or 'blockfile'");
+    return v8::Null(args->isolate());
+  }
   return Session::FromPartition(args->isolate(), partition, options).ToV8();
 }
 
@@ -66,13 +66,18 @@ class Session : public mate::TrackableObject<Session>,
   void ResolveProxy(const GURL& url, ResolveProxyCallback callback);
   template <CacheAction action>
   void DoCacheAction(const net::CompletionCallback& callback);
+  void GetCacheStatistics(
+      const base::Callback<void(const base::DictionaryValue&)>& callback);
   void ClearStorageData(mate::Arguments* args);
   void FlushStorageData();
   void SetProxy(const net::ProxyConfig& config, const base::Closure& callback);
   void SetDownloadPath(const base::FilePath& path);
+  v8::Local<v8::Promise> WhenPreferencesLoaded(v8::Isolate* isolate);
   void EnableNetworkEmulation(const mate::Dictionary& options);
   void DisableNetworkEmulation();
   void SetCertVerifyProc(v8::Local<v8::Value> proc, mate::Arguments* args);
+  void GetCertVerifyCacheStatistics(
+      const base::Callback<void(const base::DictionaryValue&)>& callback);
   void SetPermissionRequestHandler(v8::Local<v8::Value> val,
                                    mate::Arguments* args);
   void SetPermissionCheckHandler(v8::Local<v8::Value> val,
@@ -4,6 +4,7 @@
 
 #include "atom/browser/api/atom_api_web_contents.h"
 
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <string>
@@ -35,6 +36,7 @@
 #include "atom/common/api/atom_api_native_image.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/color_util.h"
+#include "atom/common/cpu_profile.h"
 #include "atom/common/mouse_util.h"
 #include "atom/common/native_mate_converters/blink_converter.h"
 #include "atom/common/native_mate_converters/callback.h"
@@ -48,8 +50,11 @@
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/options_switches.h"
+#include "base/format_macros.h"
 #include "base/message_loop/message_loop.h"
+#include "base/strings/stringprintf.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_scheduler/post_task.h"
 #include "base/threading/thread_restrictions.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
@@ -256,6 +261,11 @@ namespace api {
 
 namespace {
 
+base::File OpenProfileFile(const base::FilePath& file_path) {
+  return base::File(file_path,
+                    base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+}
+
 content::ServiceWorkerContext* GetServiceWorkerContext(
     const content::WebContents* web_contents) {
   auto* context = web_contents->GetBrowserContext();
@@ -280,6 +290,128 @@ void OnCapturePageDone(const base::Callback<void(const gfx::Image&)>& callback,
   callback.Run(gfx::Image::CreateFrom1xBitmap(bitmap));
 }
 
+// Called when CapturePixels is done, writes the pixels into |buffer| when it
+// is large enough to save allocating a new one.
+void OnCapturePixelsDone(
+    v8::Isolate* isolate,
+    const base::Callback<void(v8::Local<v8::Value>)>& callback,
+    const std::string& format,
+    v8::Global<v8::Value> buffer,
+    const SkBitmap& bitmap) {
+  v8::Locker locker(isolate);
+  v8::HandleScope handle_scope(isolate);
+
+  if (bitmap.drawsNothing()) {
+    callback.Run(v8::Null(isolate));
+    return;
+  }
+
+  SkColorType color_type =
+      format == "rgba" ? kRGBA_8888_SkColorType : kBGRA_8888_SkColorType;
+  SkImageInfo info = SkImageInfo::Make(bitmap.width(), bitmap.height(),
+                                       color_type, kPremul_SkAlphaType);
+  v8::Local<v8::Value> data = buffer.Get(isolate);
+  if (data.IsEmpty() || !node::Buffer::HasInstance(data) ||
+      node::Buffer::Length(data) < info.computeMinByteSize())
+    data = node::Buffer::New(isolate, info.computeMinByteSize())
+               .ToLocalChecked();
+
+  // Like OnCapturePageDone, treat the copy as premultiplied so readPixels only
+  // converts the channel order.
+  const_cast<SkBitmap&>(bitmap).setAlphaType(kPremul_SkAlphaType);
+  if (!bitmap.readPixels(info, node::Buffer::Data(data), info.minRowBytes(), 0,
+                         0)) {
+    callback.Run(v8::Null(isolate));
+    return;
+  }
+
+  mate::Dictionary result = mate::Dictionary::CreateEmpty(isolate);
+  result.Set("data", data);
+  result.Set("width", bitmap.width());
+  result.Set("height", bitmap.height());
+  result.Set("format", format);
+  callback.Run(result.GetHandle());
+}
+
+// An event of a sendInputEvents batch, which member holds the event depends on
+// its |type|.
+struct BatchedInputEvent {
+  blink::WebInputEvent::Type type = blink::WebInputEvent::kUndefined;
+  blink::WebMouseEvent mouse_event;
+  blink::WebMouseWheelEvent mouse_wheel_event;
+  std::unique_ptr<content::NativeWebKeyboardEvent> keyboard_event;
+
+  const blink::WebInputEvent& event() const {
+    if (keyboard_event)
+      return *keyboard_event;
+    if (type == blink::WebInputEvent::kMouseWheel)
+      return mouse_wheel_event;
+    return mouse_event;
+  }
+};
+
+bool ConvertBatchedInputEvent(v8::Isolate* isolate,
+                              v8::Local<v8::Value> input_event,
+                              BatchedInputEvent* out) {
+  out->type = mate::GetWebInputEventType(isolate, input_event);
+  if (blink::WebInputEvent::IsMouseEventType(out->type))
+    return mate::ConvertFromV8(isolate, input_event, &out->mouse_event);
+  if (blink::WebInputEvent::IsKeyboardEventType(out->type)) {
+    out->keyboard_event = std::make_unique<content::NativeWebKeyboardEvent>(
+        blink::WebKeyboardEvent::kRawKeyDown,
+        blink::WebInputEvent::kNoModifiers, ui::EventTimeForNow());
+    return mate::ConvertFromV8(isolate, input_event, out->keyboard_event.get());
+  }
+  if (out->type == blink::WebInputEvent::kMouseWheel)
+    return mate::ConvertFromV8(isolate, input_event, &out->mouse_wheel_event);
+  return false;
+}
+
+// Merges |event| into |last| when both are mouse moves or wheel scrolls that
+// only differ in position and distance, the page sees the same result as when
+// receiving them one by one.
+bool CoalesceInputEvent(const BatchedInputEvent& event,
+                        BatchedInputEvent* last) {
+  if (event.type != last->type)
+    return false;
+
+  if (event.type == blink::WebInputEvent::kMouseMove) {
+    const blink::WebMouseEvent& move = event.mouse_event;
+    blink::WebMouseEvent* last_move = &last->mouse_event;
+    if (move.GetModifiers() != last_move->GetModifiers() ||
+        move.button != last_move->button)
+      return false;
+    int movement_x = last_move->movement_x + move.movement_x;
+    int movement_y = last_move->movement_y + move.movement_y;
+    *last_move = move;
+    last_move->movement_x = movement_x;
+    last_move->movement_y = movement_y;
+    return true;
+  }
+
+  if (event.type == blink::WebInputEvent::kMouseWheel) {
+    const blink::WebMouseWheelEvent& wheel = event.mouse_wheel_event;
+    blink::WebMouseWheelEvent* last_wheel = &last->mouse_wheel_event;
+    if (wheel.GetModifiers() != last_wheel->GetModifiers() ||
+        wheel.has_precise_scrolling_deltas !=
+            last_wheel->has_precise_scrolling_deltas ||
+        wheel.scroll_by_page != last_wheel->scroll_by_page)
+      return false;
+    float delta_x = last_wheel->delta_x + wheel.delta_x;
+    float delta_y = last_wheel->delta_y + wheel.delta_y;
+    float wheel_ticks_x = last_wheel->wheel_ticks_x + wheel.wheel_ticks_x;
+    float wheel_ticks_y = last_wheel->wheel_ticks_y + wheel.wheel_ticks_y;
+    *last_wheel = wheel;
+    last_wheel->delta_x = delta_x;
+    last_wheel->delta_y = delta_y;
+    last_wheel->wheel_ticks_x = wheel_ticks_x;
+    last_wheel->wheel_ticks_y = wheel_ticks_y;
+    return true;
+  }
+
+  return false;
+}
+
 }  // namespace
 
 struct WebContents::FrameDispatchHelper {
@@ -306,7 +438,9 @@ struct WebContents::FrameDispatchHelper {
 WebContents::WebContents(v8::Isolate* isolate,
                          content::WebContents* web_contents,
                          Type type)
-    : content::WebContentsObserver(web_contents), type_(type) {
+    : content::WebContentsObserver(web_contents),
+      type_(type),
+      weak_factory_(this) {
   const mate::Dictionary options = mate::Dictionary::CreateEmpty(isolate);
   if (type == REMOTE) {
     web_contents->SetUserAgentOverride(GetBrowserContext()->GetUserAgent(),
@@ -322,7 +456,8 @@ WebContents::WebContents(v8::Isolate* isolate,
 }
 
 WebContents::WebContents(v8::Isolate* isolate,
-                         const mate::Dictionary& options) {
+                         const mate::Dictionary& options)
+    : weak_factory_(this) {
   // Read options.
   options.Get("backgroundThrottling", &background_throttling_);
 
@@ -472,6 +607,10 @@ void WebContents::InitWithSessionAndOptions(v8::Isolate* isolate,
 }
 
 WebContents::~WebContents() {
+  // The widgets must not keep calling destroyed observers, whatever the type
+  // of this WebContents is.
+  input_ack_observers_.clear();
+
   // The destroy() is called.
   if (managed_web_contents()) {
     managed_web_contents()->GetView()->SetDelegate(nullptr);
@@ -1040,6 +1179,7 @@ bool WebContents::OnMessageReceived(const IPC::Message& message,
     IPC_MESSAGE_FORWARD_DELAY_REPLY(AtomFrameHostMsg_Message_Sync, &helper,
                                     FrameDispatchHelper::OnRendererMessageSync)
     IPC_MESSAGE_HANDLER(AtomFrameHostMsg_Message_To, OnRendererMessageTo)
+    IPC_MESSAGE_HANDLER(AtomFrameHostMsg_CpuProfile, OnCpuProfile)
     IPC_MESSAGE_FORWARD_DELAY_REPLY(
         AtomFrameHostMsg_SetTemporaryZoomLevel, &helper,
         FrameDispatchHelper::OnSetTemporaryZoomLevel)
@@ -1072,6 +1212,7 @@ bool WebContents::OnMessageReceived(const IPC::Message& message,
 void WebContents::WebContentsDestroyed() {
   // Cleanup relationships with other parts.
   RemoveFromWeakMap();
+  input_ack_observers_.clear();
 
   // We can not call Destroy here because we need to call Emit first, but we
   // also do not want any method to be used, so just mark as destroyed here.
@@ -1604,13 +1745,7 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
   if (blink::WebInputEvent::IsMouseEventType(type)) {
     blink::WebMouseEvent mouse_event;
     if (mate::ConvertFromV8(isolate, input_event, &mouse_event)) {
-      if (IsOffScreen()) {
-#if defined(ENABLE_OSR)
-        GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
-#endif
-      } else {
-        rwh->ForwardMouseEvent(mouse_event);
-      }
+      ForwardMouseEvent(mouse_event);
       return;
     }
   } else if (blink::WebInputEvent::IsKeyboardEventType(type)) {
@@ -1624,14 +1759,7 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
   } else if (type == blink::WebInputEvent::kMouseWheel) {
     blink::WebMouseWheelEvent mouse_wheel_event;
     if (mate::ConvertFromV8(isolate, input_event, &mouse_wheel_event)) {
-      if (IsOffScreen()) {
-#if defined(ENABLE_OSR)
-        GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(
-            mouse_wheel_event);
-#endif
-      } else {
-        rwh->ForwardWheelEvent(mouse_wheel_event);
-      }
+      ForwardMouseWheelEvent(mouse_wheel_event);
       return;
     }
   }
@@ -1640,6 +1768,86 @@ void WebContents::SendInputEvent(v8::Isolate* isolate,
       v8::Exception::Error(mate::StringToV8(isolate, "Invalid event object")));
 }
 
+int WebContents::SendInputEvents(
+    const std::vector<v8::Local<v8::Value>>& input_events,
+    mate::Arguments* args) {
+  base::Callback<void(double)> callback;
+  if (args->Length() > 1 && !args->GetNext(&callback)) {
+    args->ThrowError();
+    return 0;
+  }
+
+  // Convert the whole batch first so an invalid event sends nothing.
+  std::vector<BatchedInputEvent> events;
+  events.reserve(input_events.size());
+  for (size_t i = 0; i < input_events.size(); ++i) {
+    BatchedInputEvent event;
+    if (!ConvertBatchedInputEvent(isolate(), input_events[i], &event)) {
+      args->ThrowError(
+          base::StringPrintf("Invalid event object at index %" PRIuS, i));
+      return 0;
+    }
+    if (events.empty() || !CoalesceInputEvent(event, &events.back()))
+      events.push_back(std::move(event));
+  }
+
+  content::RenderWidgetHostView* view =
+      web_contents()->GetRenderWidgetHostView();
+  if (!view || events.empty())
+    return 0;
+
+  content::RenderWidgetHost* rwh = view->GetRenderWidgetHost();
+  for (const BatchedInputEvent& event : events) {
+    if (event.keyboard_event)
+      rwh->ForwardKeyboardEvent(*event.keyboard_event);
+    else if (event.type == blink::WebInputEvent::kMouseWheel)
+      ForwardMouseWheelEvent(event.mouse_wheel_event);
+    else
+      ForwardMouseEvent(event.mouse_event);
+  }
+
+  if (!callback.is_null()) {
+    std::unique_ptr<InputAckObserver>& observer = input_ack_observers_[rwh];
+    if (!observer)
+      observer.reset(new InputAckObserver(
+          rwh, base::Bind(&WebContents::OnInputAcksDone,
+                          base::Unretained(this))));
+    // The batch has been handled once the page acks its last event.
+    observer->AddBatch(events.back().event(), callback);
+  }
+
+  return static_cast<int>(events.size());
+}
+
+void WebContents::ForwardMouseEvent(const blink::WebMouseEvent& mouse_event) {
+  if (IsOffScreen()) {
+#if defined(ENABLE_OSR)
+    GetOffScreenRenderWidgetHostView()->SendMouseEvent(mouse_event);
+#endif
+  } else {
+    content::RenderWidgetHost* rwh =
+        web_contents()->GetRenderWidgetHostView()->GetRenderWidgetHost();
+    rwh->ForwardMouseEvent(mouse_event);
+  }
+}
+
+void WebContents::ForwardMouseWheelEvent(
+    const blink::WebMouseWheelEvent& wheel_event) {
+  if (IsOffScreen()) {
+#if defined(ENABLE_OSR)
+    GetOffScreenRenderWidgetHostView()->SendMouseWheelEvent(wheel_event);
+#endif
+  } else {
+    content::RenderWidgetHost* rwh =
+        web_contents()->GetRenderWidgetHostView()->GetRenderWidgetHost();
+    rwh->ForwardWheelEvent(wheel_event);
+  }
+}
+
+void WebContents::OnInputAcksDone(content::RenderWidgetHost* widget) {
+  input_ack_observers_.erase(widget);
+}
+
 void WebContents::BeginFrameSubscription(mate::Arguments* args) {
   bool only_dirty = false;
   FrameSubscriber::FrameCaptureCallback callback;
@@ -1731,6 +1939,60 @@ void WebContents::CapturePage(mate::Arguments* args) {
                         base::BindOnce(&OnCapturePageDone, callback));
 }
 
+void WebContents::CapturePixels(mate::Arguments* args) {
+  mate::Dictionary options;
+  base::Callback<void(v8::Local<v8::Value>)> callback;
+
+  if (!(args->Length() == 1 && args->GetNext(&callback)) &&
+      !(args->Length() == 2 && args->GetNext(&options) &&
+        args->GetNext(&callback))) {
+    args->ThrowError();
+    return;
+  }
+
+  gfx::Rect rect;
+  gfx::Size size;
+  std::string format = "bgra";
+  v8::Local<v8::Value> buffer;
+  if (!options.IsEmpty()) {
+    options.Get("rect", &rect);
+    options.Get("size", &size);
+    options.Get("format", &format);
+    options.Get("buffer", &buffer);
+  }
+  if (format != "bgra" && format != "rgba") {
+    args->ThrowError("Invalid pixel format " + format);
+    return;
+  }
+
+  auto* const view = web_contents()->GetRenderWidgetHostView();
+  if (!view) {
+    callback.Run(v8::Null(isolate()));
+    return;
+  }
+
+  const gfx::Size view_size =
+      rect.IsEmpty() ? view->GetViewBounds().size() : rect.size();
+
+  // Let the compositor scale the copy to the requested size, otherwise capture
+  // all the pixel detail available like CapturePage.
+  gfx::Size bitmap_size = size;
+  if (bitmap_size.IsEmpty()) {
+    const float scale = display::Screen::GetScreen()
+                            ->GetDisplayNearestView(view->GetNativeView())
+                            .device_scale_factor();
+    bitmap_size = gfx::ScaleToCeiledSize(view_size, std::max(scale, 1.0f));
+  }
+
+  v8::Global<v8::Value> buffer_handle;
+  if (!buffer.IsEmpty())
+    buffer_handle.Reset(isolate(), buffer);
+  view->CopyFromSurface(
+      gfx::Rect(rect.origin(), view_size), bitmap_size,
+      base::BindOnce(&OnCapturePixelsDone, isolate(), callback, format,
+                     std::move(buffer_handle)));
+}
+
 void WebContents::OnCursorChange(const content::WebCursor& cursor) {
   content::CursorInfo info;
   cursor.GetCursorInfo(&info);
@@ -1986,22 +2248,96 @@ void WebContents::GrantOriginAccess(const GURL& url) {
       url::Origin::Create(url));
 }
 
-bool WebContents::TakeHeapSnapshot(const base::FilePath& file_path,
-                                   const std::string& channel) {
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
+void WebContents::TakeHeapSnapshot(const base::FilePath& file_path,
+                                   const std::string& channel,
+                                   mate::Arguments* args) {
+  bool compress = false;
+  bool report_progress = false;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("compress", &compress);
+    options.Get("reportProgress", &report_progress);
+  }
 
-  base::File file(file_path,
-                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
-  if (!file.IsValid())
-    return false;
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, {base::MayBlock(), base::TaskPriority::USER_VISIBLE},
+      base::BindOnce(&OpenProfileFile, file_path),
+      base::BindOnce(&WebContents::OnHeapSnapshotFileOpened,
+                     weak_factory_.GetWeakPtr(), channel, compress,
+                     report_progress));
+}
 
+void WebContents::OnHeapSnapshotFileOpened(const std::string& channel,
+                                           bool compress,
+                                           bool report_progress,
+                                           base::File file) {
   auto* frame_host = web_contents()->GetMainFrame();
-  if (!frame_host)
-    return false;
+  if (file.IsValid() && frame_host &&
+      frame_host->Send(new AtomFrameMsg_TakeHeapSnapshot(
+          frame_host->GetRoutingID(),
+          IPC::TakePlatformFileForTransit(std::move(file)), channel, compress,
+          report_progress)))
+    return;
+
+  EmitProfileResult(channel, false);
+}
+
+void WebContents::StartCpuProfile(const std::string& channel,
+                                  mate::Arguments* args) {
+  int sampling_interval = 1000;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval <= 0) {
+    args->ThrowError("Invalid sampling interval");
+    return;
+  }
+
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host ||
+      !frame_host->Send(new AtomFrameMsg_StartCpuProfile(
+          frame_host->GetRoutingID(), sampling_interval, channel)))
+    EmitProfileResult(channel, false);
+}
+
+void WebContents::StopCpuProfile(const base::FilePath& file_path,
+                                 const std::string& channel) {
+  // The renderer sends the profile back, the file is only written once it
+  // is known that a profile was being recorded.
+  auto* frame_host = web_contents()->GetMainFrame();
+  if (!frame_host || !frame_host->Send(new AtomFrameMsg_StopCpuProfile(
+                         frame_host->GetRoutingID(), channel))) {
+    EmitProfileResult(channel, false);
+    return;
+  }
+  cpu_profile_paths_[channel] = file_path;
+}
+
+void WebContents::OnCpuProfile(content::RenderFrameHost* frame_host,
+                               const std::string& channel,
+                               const std::string& profile) {
+  auto it = cpu_profile_paths_.find(channel);
+  if (it == cpu_profile_paths_.end())
+    return;
+  base::FilePath file_path = it->second;
+  cpu_profile_paths_.erase(it);
+
+  if (profile.empty()) {
+    EmitProfileResult(channel, false);
+    return;
+  }
+  WriteCpuProfile(file_path, profile,
+                  base::BindOnce(&WebContents::EmitProfileResult,
+                                 weak_factory_.GetWeakPtr(), channel));
+}
 
-  return frame_host->Send(new AtomFrameMsg_TakeHeapSnapshot(
-      frame_host->GetRoutingID(),
-      IPC::TakePlatformFileForTransit(std::move(file)), channel));
+void WebContents::EmitProfileResult(const std::string& channel,
+                                    bool success) {
+  // Report the result the same way the renderer reports its results.
+  base::ListValue args;
+  args.AppendString(channel);
+  args.AppendBoolean(success);
+  Emit("ipc-message", args);
 }
 
 // static
@@ -2058,6 +2394,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
       .SetMethod("tabTraverse", &WebContents::TabTraverse)
       .SetMethod("_send", &WebContents::SendIPCMessage)
       .SetMethod("sendInputEvent", &WebContents::SendInputEvent)
+      .SetMethod("sendInputEvents", &WebContents::SendInputEvents)
       .SetMethod("beginFrameSubscription", &WebContents::BeginFrameSubscription)
       .SetMethod("endFrameSubscription", &WebContents::EndFrameSubscription)
       .SetMethod("startDrag", &WebContents::StartDrag)
@@ -2092,6 +2429,7 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::ShowDefinitionForSelection)
       .SetMethod("copyImageAt", &WebContents::CopyImageAt)
       .SetMethod("capturePage", &WebContents::CapturePage)
+      .SetMethod("capturePixels", &WebContents::CapturePixels)
       .SetMethod("setEmbedder", &WebContents::SetEmbedder)
       .SetMethod("setDevToolsWebContents", &WebContents::SetDevToolsWebContents)
       .SetMethod("getNativeView", &WebContents::GetNativeView)
@@ -2101,6 +2439,8 @@ void WebContents::BuildPrototype(v8::Isolate* isolate,
                  &WebContents::GetWebRTCIPHandlingPolicy)
       .SetMethod("_grantOriginAccess", &WebContents::GrantOriginAccess)
       .SetMethod("_takeHeapSnapshot", &WebContents::TakeHeapSnapshot)
+      .SetMethod("_startCpuProfile", &WebContents::StartCpuProfile)
+      .SetMethod("_stopCpuProfile", &WebContents::StopCpuProfile)
       .SetProperty("id", &WebContents::ID)
       .SetProperty("session", &WebContents::Session)
       .SetProperty("hostWebContents", &WebContents::HostWebContents)
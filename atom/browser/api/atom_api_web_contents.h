@@ -5,15 +5,20 @@
 #ifndef ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 #define ATOM_BROWSER_API_ATOM_API_WEB_CONTENTS_H_
 
+#include <map>
 #include <memory>
 #include <string>
 #include <vector>
 
 #include "atom/browser/api/frame_subscriber.h"
+#include "atom/browser/api/input_ack_observer.h"
 #include "atom/browser/api/save_page_handler.h"
 #include "atom/browser/api/trackable_object.h"
 #include "atom/browser/common_web_contents_delegate.h"
 #include "atom/browser/ui/autofill_popup.h"
+#include "base/files/file.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
 #include "base/observer_list.h"
 #include "content/common/cursors/webcursor.h"
 #include "content/public/browser/keyboard_event_processing_result.h"
@@ -25,8 +30,10 @@
 #include "ui/gfx/image/image.h"
 
 namespace blink {
+class WebMouseEvent;
+class WebMouseWheelEvent;
 struct WebDeviceEmulationParams;
-}
+}  // namespace blink
 
 namespace brightray {
 class InspectableWebContents;
@@ -189,6 +196,8 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
   // Send WebInputEvent to the page.
   void SendInputEvent(v8::Isolate* isolate, v8::Local<v8::Value> input_event);
+  int SendInputEvents(const std::vector<v8::Local<v8::Value>>& input_events,
+                      mate::Arguments* args);
 
   // Subscribe to the frame updates.
   void BeginFrameSubscription(mate::Arguments* args);
@@ -201,6 +210,9 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // done.
   void CapturePage(mate::Arguments* args);
 
+  // Captures the raw pixels of the page, optionally scaled to a size.
+  void CapturePixels(mate::Arguments* args);
+
   // Methods for creating <webview>.
   bool IsGuest() const;
   void AttachToIframe(content::WebContents* embedder_web_contents,
@@ -250,8 +262,12 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // the specified URL.
   void GrantOriginAccess(const GURL& url);
 
-  bool TakeHeapSnapshot(const base::FilePath& file_path,
-                        const std::string& channel);
+  void TakeHeapSnapshot(const base::FilePath& file_path,
+                        const std::string& channel,
+                        mate::Arguments* args);
+  void StartCpuProfile(const std::string& channel, mate::Arguments* args);
+  void StopCpuProfile(const base::FilePath& file_path,
+                      const std::string& channel);
 
   // Properties.
   int32_t ID() const;
@@ -412,6 +428,7 @@ class WebContents : public mate::TrackableObject<WebContents>,
 
  private:
   struct FrameDispatchHelper;
+
   AtomBrowserContext* GetBrowserContext() const;
 
   uint32_t GetNextRequestId() { return ++request_id_; }
@@ -421,6 +438,15 @@ class WebContents : public mate::TrackableObject<WebContents>,
   OffScreenRenderWidgetHostView* GetOffScreenRenderWidgetHostView() const;
 #endif
 
+  // Forward the input event to the page, through the offscreen view when
+  // offscreen rendering is used.
+  void ForwardMouseEvent(const blink::WebMouseEvent& mouse_event);
+  void ForwardMouseWheelEvent(const blink::WebMouseWheelEvent& wheel_event);
+
+  // Called when the batches sent to |widget| have all been acked, or when
+  // |widget| is destroyed.
+  void OnInputAcksDone(content::RenderWidgetHost* widget);
+
   // Called when we receive a CursorChange message from chromium.
   void OnCursorChange(const content::WebCursor& cursor);
 
@@ -456,6 +482,20 @@ class WebContents : public mate::TrackableObject<WebContents>,
   void InitZoomController(content::WebContents* web_contents,
                           const mate::Dictionary& options);
 
+  // Called when the file for takeHeapSnapshot has been opened.
+  void OnHeapSnapshotFileOpened(const std::string& channel,
+                                bool compress,
+                                bool report_progress,
+                                base::File file);
+
+  // Called when the renderer sent the profile requested by stopCpuProfile.
+  void OnCpuProfile(content::RenderFrameHost* frame_host,
+                    const std::string& channel,
+                    const std::string& profile);
+
+  // Settles the pending profiling request waiting on |channel|.
+  void EmitProfileResult(const std::string& channel, bool success);
+
   v8::Global<v8::Value> session_;
   v8::Global<v8::Value> devtools_web_contents_;
   v8::Global<v8::Value> debugger_;
@@ -483,9 +523,19 @@ class WebContents : public mate::TrackableObject<WebContents>,
   // Whether to enable devtools.
   bool enable_devtools_ = true;
 
+  // The output files of stopCpuProfile requests, by request channel.
+  std::map<std::string, base::FilePath> cpu_profile_paths_;
+
   // Observers of this WebContents.
   base::ObserverList<ExtendedWebContentsObserver> observers_;
 
+  // The batches of sendInputEvents waiting for acks, by widget they were sent
+  // to.
+  std::map<content::RenderWidgetHost*, std::unique_ptr<InputAckObserver>>
+      input_ack_observers_;
+
+  base::WeakPtrFactory<WebContents> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(WebContents);
 };
 
@@ -0,0 +1,137 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/api/atom_api_worker.h"
+
+#include <utility>
+
+#include "atom/browser/atom_browser_main_parts.h"
+#include "atom/browser/javascript_environment.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/node_includes.h"
+#include "native_mate/constructor.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/object_template_builder.h"
+
+namespace atom {
+
+namespace api {
+
+Worker::Worker(v8::Isolate* isolate,
+               v8::Local<v8::Object> wrapper,
+               const base::FilePath& script_path)
+    : weak_factory_(this) {
+  InitWith(isolate, wrapper);
+
+  worker_ = std::make_unique<NodeWorker>(
+      script_path, AtomBrowserMainParts::Get()->js_env()->platform(),
+      weak_factory_.GetWeakPtr());
+  if (worker_->Start())
+    Pin();
+  else
+    worker_.reset();
+}
+
+Worker::~Worker() {
+  if (worker_)
+    worker_->Terminate();
+}
+
+// static
+mate::WrappableBase* Worker::New(const base::FilePath& script_path,
+                                 mate::Arguments* args) {
+  if (!script_path.IsAbsolute()) {
+    args->ThrowError("The path of the worker script must be absolute");
+    return nullptr;
+  }
+  return new Worker(args->isolate(), args->GetThis(), script_path);
+}
+
+void Worker::OnWorkerMessage(std::unique_ptr<WorkerMessage> message) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Value> value;
+  if (message->Deserialize(isolate()).ToLocal(&value))
+    Emit("message", value);
+}
+
+void Worker::OnWorkerError(const std::string& message,
+                           const std::string& stack) {
+  v8::Locker locker(isolate());
+  v8::HandleScope handle_scope(isolate());
+  v8::Local<v8::Value> error =
+      v8::Exception::Error(mate::StringToV8(isolate(), message));
+  mate::Dictionary(isolate(), error.As<v8::Object>()).Set("stack", stack);
+  Emit("error", error);
+}
+
+void Worker::OnWorkerExit() {
+  // The thread has finished, joining it does not block.
+  worker_.reset();
+  Unpin();
+  Emit("exit");
+}
+
+void Worker::PostWorkerMessage(mate::Arguments* args) {
+  if (!worker_) {
+    args->ThrowError("The worker has exited");
+    return;
+  }
+  std::unique_ptr<WorkerMessage> message = WorkerMessage::FromArguments(args);
+  if (!message)
+    return;
+  worker_->PostMessageToWorker(std::move(message));
+}
+
+void Worker::Terminate() {
+  if (worker_)
+    worker_->Terminate();
+}
+
+bool Worker::IsRunning() const {
+  return !!worker_;
+}
+
+void Worker::Pin() {
+  if (wrapper_.IsEmpty()) {
+    wrapper_.Reset(isolate(), GetWrapper());
+  }
+}
+
+void Worker::Unpin() {
+  wrapper_.Reset();
+}
+
+// static
+void Worker::BuildPrototype(v8::Isolate* isolate,
+                            v8::Local<v8::FunctionTemplate> prototype) {
+  prototype->SetClassName(mate::StringToV8(isolate, "Worker"));
+  mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
+      .SetMethod("postMessage", &Worker::PostWorkerMessage)
+      .SetMethod("terminate", &Worker::Terminate)
+      .SetMethod("isRunning", &Worker::IsRunning);
+}
+
+}  // namespace api
+
+}  // namespace atom
+
+namespace {
+
+using atom::api::Worker;
+
+void Initialize(v8::Local<v8::Object> exports,
+                v8::Local<v8::Value> unused,
+                v8::Local<v8::Context> context,
+                void* priv) {
+  v8::Isolate* isolate = context->GetIsolate();
+  Worker::SetConstructor(isolate, base::Bind(&Worker::New));
+
+  mate::Dictionary dict(isolate, exports);
+  dict.Set("Worker", Worker::GetConstructor(isolate)->GetFunction());
+}
+
+}  // namespace
+
+NODE_BUILTIN_MODULE_CONTEXT_AWARE(atom_browser_worker, Initialize)
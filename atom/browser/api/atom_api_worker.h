@@ -0,0 +1,68 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_API_ATOM_API_WORKER_H_
+#define ATOM_BROWSER_API_ATOM_API_WORKER_H_
+
+#include <memory>
+#include <string>
+
+#include "atom/browser/api/trackable_object.h"
+#include "atom/browser/node_worker.h"
+#include "base/files/file_path.h"
+#include "base/memory/weak_ptr.h"
+
+namespace mate {
+class Arguments;
+}
+
+namespace atom {
+
+namespace api {
+
+class Worker : public mate::TrackableObject<Worker>,
+               public NodeWorker::Delegate {
+ public:
+  static mate::WrappableBase* New(const base::FilePath& script_path,
+                                  mate::Arguments* args);
+
+  static void BuildPrototype(v8::Isolate* isolate,
+                             v8::Local<v8::FunctionTemplate> prototype);
+
+ protected:
+  Worker(v8::Isolate* isolate,
+         v8::Local<v8::Object> wrapper,
+         const base::FilePath& script_path);
+  ~Worker() override;
+
+  // NodeWorker::Delegate:
+  void OnWorkerMessage(std::unique_ptr<WorkerMessage> message) override;
+  void OnWorkerError(const std::string& message,
+                     const std::string& stack) override;
+  void OnWorkerExit() override;
+
+  void PostWorkerMessage(mate::Arguments* args);
+  void Terminate();
+  bool IsRunning() const;
+
+ private:
+  // The JavaScript object is kept alive while the worker is running.
+  void Pin();
+  void Unpin();
+
+  std::unique_ptr<NodeWorker> worker_;
+
+  // Used to implement pin/unpin.
+  v8::Global<v8::Object> wrapper_;
+
+  base::WeakPtrFactory<Worker> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_API_ATOM_API_WORKER_H_
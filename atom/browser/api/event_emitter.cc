@@ -77,6 +77,11 @@ v8::Local<v8::Object> CreateEventFromFlags(v8::Isolate* isolate, int flags) {
   return obj.GetHandle();
 }
 
+bool IsUnskippableEvent(const base::StringPiece& name) {
+  // Emitting "error" without listeners throws in JavaScript.
+  return name == "error";
+}
+
 }  // namespace internal
 
 }  // namespace mate
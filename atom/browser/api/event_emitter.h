@@ -5,9 +5,16 @@
 #ifndef ATOM_BROWSER_API_EVENT_EMITTER_H_
 #define ATOM_BROWSER_API_EVENT_EMITTER_H_
 
+#include <functional>
+#include <string>
 #include <vector>
 
 #include "atom/common/api/event_emitter_caller.h"
+#include "base/containers/flat_map.h"
+#include "gin/per_isolate_data.h"
+#include "native_mate/arguments.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/function_template.h"
 #include "native_mate/wrappable.h"
 
 namespace content {
@@ -31,6 +38,9 @@ v8::Local<v8::Object> CreateCustomEvent(v8::Isolate* isolate,
                                         v8::Local<v8::Object> event);
 v8::Local<v8::Object> CreateEventFromFlags(v8::Isolate* isolate, int flags);
 
+// Returns whether the event must reach JavaScript even without listeners.
+bool IsUnskippableEvent(const base::StringPiece& name);
+
 }  // namespace internal
 
 // Provide helperers to emit event in JavaScript.
@@ -46,11 +56,20 @@ class EventEmitter : public Wrappable<T> {
     return Wrappable<T>::GetWrapper();
   }
 
+  // Returns whether JavaScript may be listening to the event |name|, always
+  // true when the listeners of this object can not be tracked.
+  bool HasListeners(const base::StringPiece& name) const {
+    return !track_listeners_ || internal::IsUnskippableEvent(name) ||
+           listener_counts_.find(name) != listener_counts_.end();
+  }
+
   // this.emit(name, event, args...);
   template <typename... Args>
   bool EmitCustomEvent(const base::StringPiece& name,
                        v8::Local<v8::Object> event,
                        const Args&... args) {
+    if (!HasListeners(name))
+      return false;
     return EmitWithEvent(
         name, internal::CreateCustomEvent(isolate(), GetWrapper(), event),
         args...);
@@ -61,6 +80,8 @@ class EventEmitter : public Wrappable<T> {
   bool EmitWithFlags(const base::StringPiece& name,
                      int flags,
                      const Args&... args) {
+    if (!HasListeners(name))
+      return false;
     return EmitCustomEvent(
         name, internal::CreateEventFromFlags(isolate(), flags), args...);
   }
@@ -77,6 +98,9 @@ class EventEmitter : public Wrappable<T> {
                       content::RenderFrameHost* sender,
                       IPC::Message* message,
                       const Args&... args) {
+    // Synchronous messages always need the event to send the reply.
+    if (!message && !HasListeners(name))
+      return false;
     v8::Locker locker(isolate());
     v8::HandleScope handle_scope(isolate());
     v8::Local<v8::Object> wrapper = GetWrapper();
@@ -91,7 +115,90 @@ class EventEmitter : public Wrappable<T> {
  protected:
   EventEmitter() {}
 
+  void InitWith(v8::Isolate* isolate, v8::Local<v8::Object> wrapper) override {
+    TrackListeners(isolate, wrapper);
+    Wrappable<T>::InitWith(isolate, wrapper);
+  }
+
  private:
+  // Subscribes to the "newListener" and "removeListener" events of the JS
+  // EventEmitter, so events nobody listens to can be dropped before creating
+  // the event object and converting arguments. The hooks are ordinary
+  // listeners, so they show up in eventNames() and listenerCount().
+  void TrackListeners(v8::Isolate* isolate, v8::Local<v8::Object> wrapper) {
+    // When the prototype has not been made an EventEmitter, e.g. because the
+    // module replaces emit() instead, every event is emitted.
+    v8::Local<v8::Function> on;
+    if (!Dictionary(isolate, wrapper).Get("on", &on))
+      return;
+
+    if (!AddListenerHook(isolate, wrapper, on, "newListener",
+                         &kNewListenerHookInfo,
+                         &EventEmitter<T>::OnNewListener) ||
+        !AddListenerHook(isolate, wrapper, on, "removeListener",
+                         &kRemoveListenerHookInfo,
+                         &EventEmitter<T>::OnRemoveListener))
+      return;
+    track_listeners_ = true;
+  }
+
+  static bool AddListenerHook(v8::Isolate* isolate,
+                              v8::Local<v8::Object> wrapper,
+                              v8::Local<v8::Function> on,
+                              const char* name,
+                              gin::WrapperInfo* info,
+                              void (*hook)(Arguments* args)) {
+    v8::Local<v8::Value> args[] = {StringToV8(isolate, name),
+                                   GetListenerHook(isolate, info, hook)};
+    return !on->Call(wrapper, arraysize(args), args).IsEmpty();
+  }
+
+  // The hooks are shared by all instances, V8 never frees FunctionTemplates
+  // so creating them per instance would leak. The hook finds its emitter
+  // from |this|.
+  static v8::Local<v8::Function> GetListenerHook(v8::Isolate* isolate,
+                                                 gin::WrapperInfo* info,
+                                                 void (*hook)(Arguments*)) {
+    auto* data = gin::PerIsolateData::From(isolate);
+    auto templ = data->GetFunctionTemplate(info);
+    if (templ.IsEmpty()) {
+      templ = CreateFunctionTemplate(isolate, base::Bind(hook));
+      data->SetFunctionTemplate(info, templ);
+    }
+    return templ->GetFunction();
+  }
+
+  static EventEmitter<T>* FromListenerHook(Arguments* args,
+                                           std::string* name) {
+    T* self = nullptr;
+    if (!ConvertFromV8(args->isolate(), args->GetThis(), &self) ||
+        !args->GetNext(name))
+      return nullptr;
+    return self;
+  }
+
+  static void OnNewListener(Arguments* args) {
+    std::string name;
+    EventEmitter<T>* self = FromListenerHook(args, &name);
+    if (self)
+      ++self->listener_counts_[name];
+  }
+
+  static void OnRemoveListener(Arguments* args) {
+    std::string name;
+    EventEmitter<T>* self = FromListenerHook(args, &name);
+    if (!self)
+      return;
+    // Our hooks might have been removed, stop relying on the counts.
+    if (name == "newListener" || name == "removeListener") {
+      self->track_listeners_ = false;
+      return;
+    }
+    auto it = self->listener_counts_.find(name);
+    if (it != self->listener_counts_.end() && --it->second <= 0)
+      self->listener_counts_.erase(it);
+  }
+
   // this.emit(name, event, args...);
   template <typename... Args>
   bool EmitWithEvent(const base::StringPiece& name,
@@ -104,9 +211,26 @@ class EventEmitter : public Wrappable<T> {
         ->BooleanValue();
   }
 
+  // Number of JS listeners of each event, valid when |track_listeners_|.
+  base::flat_map<std::string, int, std::less<>> listener_counts_;
+  bool track_listeners_ = false;
+
+  static gin::WrapperInfo kNewListenerHookInfo;
+  static gin::WrapperInfo kRemoveListenerHookInfo;
+
   DISALLOW_COPY_AND_ASSIGN(EventEmitter);
 };
 
+// static
+template <typename T>
+gin::WrapperInfo EventEmitter<T>::kNewListenerHookInfo = {
+    gin::kEmbedderNativeGin};
+
+// static
+template <typename T>
+gin::WrapperInfo EventEmitter<T>::kRemoveListenerHookInfo = {
+    gin::kEmbedderNativeGin};
+
 }  // namespace mate
 
 #endif  // ATOM_BROWSER_API_EVENT_EMITTER_H_
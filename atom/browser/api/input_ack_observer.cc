@@ -0,0 +1,76 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/api/input_ack_observer.h"
+
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace atom {
+
+namespace api {
+
+InputAckObserver::InputAckObserver(content::RenderWidgetHost* widget,
+                                   const DoneCallback& done_callback)
+    : widget_(widget), done_callback_(done_callback), weak_factory_(this) {
+  widget_->AddInputEventObserver(this);
+  widget_->AddObserver(this);
+}
+
+InputAckObserver::~InputAckObserver() {
+  if (widget_) {
+    widget_->RemoveInputEventObserver(this);
+    widget_->RemoveObserver(this);
+  }
+}
+
+void InputAckObserver::AddBatch(const blink::WebInputEvent& last_event,
+                                const AckCallback& callback) {
+  pending_batches_.push_back({last_event.GetType(),
+                              last_event.TimeStampSeconds(),
+                              base::TimeTicks::Now(), callback});
+}
+
+void InputAckObserver::OnInputEventAck(content::InputEventAckSource source,
+                                       content::InputEventAckState state,
+                                       const blink::WebInputEvent& event) {
+  auto acked = std::find_if(
+      pending_batches_.begin(), pending_batches_.end(),
+      [&event](const PendingBatch& batch) {
+        return batch.type == event.GetType() &&
+               batch.time_stamp_seconds == event.TimeStampSeconds();
+      });
+  if (acked == pending_batches_.end())
+    return;
+
+  // Events are acked in order, so the batches sent before have been handled
+  // too even when their last event was coalesced with a later one.
+  std::vector<PendingBatch> batches(
+      std::make_move_iterator(pending_batches_.begin()),
+      std::make_move_iterator(acked + 1));
+  pending_batches_.erase(pending_batches_.begin(), acked + 1);
+
+  // The callbacks may destroy the WebContents owning this observer.
+  auto weak_this = weak_factory_.GetWeakPtr();
+  base::TimeTicks now = base::TimeTicks::Now();
+  for (const PendingBatch& batch : batches)
+    batch.callback.Run((now - batch.sent_time).InMillisecondsF());
+
+  if (weak_this && pending_batches_.empty())
+    done_callback_.Run(widget_);
+}
+
+void InputAckObserver::RenderWidgetHostDestroyed(
+    content::RenderWidgetHost* widget) {
+  widget_->RemoveInputEventObserver(this);
+  widget_->RemoveObserver(this);
+  widget_ = nullptr;
+  pending_batches_.clear();
+  done_callback_.Run(widget);
+}
+
+}  // namespace api
+
+}  // namespace atom
@@ -0,0 +1,71 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_API_INPUT_ACK_OBSERVER_H_
+#define ATOM_BROWSER_API_INPUT_ACK_OBSERVER_H_
+
+#include <vector>
+
+#include "base/callback.h"
+#include "base/memory/weak_ptr.h"
+#include "base/time/time.h"
+#include "content/public/browser/render_widget_host.h"
+#include "content/public/browser/render_widget_host_observer.h"
+#include "third_party/blink/public/platform/web_input_event.h"
+
+namespace atom {
+
+namespace api {
+
+// Waits for a widget to ack the batches of sendInputEvents sent to it, the
+// batches are dropped without running their callbacks when the widget is
+// destroyed.
+class InputAckObserver : public content::RenderWidgetHost::InputEventObserver,
+                         public content::RenderWidgetHostObserver {
+ public:
+  using AckCallback = base::Callback<void(double)>;
+  // Called when no batch is pending anymore, it may delete the observer.
+  using DoneCallback = base::Callback<void(content::RenderWidgetHost*)>;
+
+  InputAckObserver(content::RenderWidgetHost* widget,
+                   const DoneCallback& done_callback);
+  ~InputAckObserver() override;
+
+  // Runs |callback| with the time it took once |last_event| has been acked.
+  void AddBatch(const blink::WebInputEvent& last_event,
+                const AckCallback& callback);
+
+ private:
+  // A batch waiting for the ack of its last event.
+  struct PendingBatch {
+    blink::WebInputEvent::Type type;
+    double time_stamp_seconds;
+    base::TimeTicks sent_time;
+    AckCallback callback;
+  };
+
+  // content::RenderWidgetHost::InputEventObserver:
+  void OnInputEventAck(content::InputEventAckSource source,
+                       content::InputEventAckState state,
+                       const blink::WebInputEvent& event) override;
+
+  // content::RenderWidgetHostObserver:
+  void RenderWidgetHostDestroyed(content::RenderWidgetHost* widget) override;
+
+  content::RenderWidgetHost* widget_;
+  DoneCallback done_callback_;
+
+  // The batches in the order they were sent.
+  std::vector<PendingBatch> pending_batches_;
+
+  base::WeakPtrFactory<InputAckObserver> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(InputAckObserver);
+};
+
+}  // namespace api
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_API_INPUT_ACK_OBSERVER_H_
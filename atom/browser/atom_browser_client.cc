@@ -29,10 +29,12 @@
 #include "atom/common/google_api_key.h"
 #include "atom/common/options_switches.h"
 #include "atom/common/platform_util.h"
+#include "brightray/browser/brightray_paths.h"
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/files/file_util.h"
 #include "base/no_destructor.h"
+#include "base/path_service.h"
 #include "base/stl_util.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/string_util.h"
@@ -323,9 +325,9 @@ void AtomBrowserClient::AppendExtraCommandLineSwitches(
     return;
 
   // Copy following switches to child process.
-  static const char* const kCommonSwitchNames[] = {switches::kStandardSchemes,
-                                                   switches::kEnableSandbox,
-                                                   switches::kSecureSchemes};
+  static const char* const kCommonSwitchNames[] = {
+      switches::kStandardSchemes, switches::kEnableSandbox,
+      switches::kSecureSchemes, switches::kUvMessagePump};
   command_line->CopySwitchesFrom(*base::CommandLine::ForCurrentProcess(),
                                  kCommonSwitchNames,
                                  arraysize(kCommonSwitchNames));
@@ -357,6 +359,15 @@ void AtomBrowserClient::AppendExtraCommandLineSwitches(
     SessionPreferences::AppendExtraCommandLineSwitches(
         web_contents->GetBrowserContext(), command_line);
   }
+
+  // Sandboxed renderers can not access the code cache on disk.
+  base::FilePath user_data;
+  if (!command_line->HasSwitch(switches::kEnableSandbox) &&
+      PathService::Get(brightray::DIR_USER_DATA, &user_data))
+    command_line->AppendSwitchPath(
+        switches::kCodeCachePath,
+        user_data.Append(FILE_PATH_LITERAL("Electron Code Cache"))
+            .Append(FILE_PATH_LITERAL("Renderer")));
 }
 
 void AtomBrowserClient::DidCreatePpapiPlugin(content::BrowserPpapiHost* host) {
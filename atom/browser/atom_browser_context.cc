@@ -4,6 +4,8 @@
 
 #include "atom/browser/atom_browser_context.h"
 
+#include <algorithm>
+
 #include "atom/browser/atom_blob_reader.h"
 #include "atom/browser/atom_browser_main_parts.h"
 #include "atom/browser/atom_download_manager_delegate.h"
@@ -63,11 +65,29 @@ AtomBrowserContext::AtomBrowserContext(const std::string& partition,
   base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
   bool use_cache = !command_line->HasSwitch(switches::kDisableHttpCache);
   options.GetBoolean("cache", &use_cache);
-
-  request_context_delegate_.reset(new RequestContextDelegate(use_cache));
-
-  // Initialize Pref Registry in brightray.
-  InitPrefs();
+  std::string cache_backend_name;
+  net::BackendType cache_backend = net::CACHE_BACKEND_DEFAULT;
+  if (options.GetString("cacheBackend", &cache_backend_name)) {
+    if (cache_backend_name == "simple")
+      cache_backend = net::CACHE_BACKEND_SIMPLE;
+    else if (cache_backend_name == "blockfile")
+      cache_backend = net::CACHE_BACKEND_BLOCKFILE;
+  }
+  int cache_max_size = 0;
+  options.GetInteger("cacheMaxSize", &cache_max_size);
+  int memory_cache_max_size = 0;
+  options.GetInteger("memoryCacheMaxSize", &memory_cache_max_size);
+
+  request_context_delegate_.reset(
+      new RequestContextDelegate(use_cache, cache_backend,
+                                 std::max(cache_max_size, 0),
+                                 std::max(memory_cache_max_size, 0)));
+
+  // The preferences are otherwise read on first use.
+  bool async_preferences = false;
+  options.GetBoolean("asyncPreferences", &async_preferences);
+  if (async_preferences)
+    InitPrefsAsync();
 }
 
 AtomBrowserContext::~AtomBrowserContext() {
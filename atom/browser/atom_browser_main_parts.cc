@@ -12,17 +12,21 @@
 #include "atom/browser/atom_browser_context.h"
 #include "atom/browser/bridge_task_runner.h"
 #include "atom/browser/browser.h"
+#include "atom/browser/idle_gc_scheduler.h"
 #include "atom/browser/javascript_environment.h"
 #include "atom/browser/node_debugger.h"
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/asar/asar_util.h"
 #include "atom/common/node_bindings.h"
+#include "atom/common/startup_timeline.h"
+#include "base/bind.h"
 #include "base/command_line.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "chrome/browser/browser_process.h"
 #include "content/public/browser/child_process_security_policy.h"
 #include "content/public/common/result_codes.h"
 #include "content/public/common/service_manager_connection.h"
+#include "native_mate/dictionary.h"
 #include "services/device/public/mojom/constants.mojom.h"
 #include "services/service_manager/public/cpp/connector.h"
 #include "ui/base/idle/idle.h"
@@ -55,6 +59,14 @@ void Erase(T* container, typename T::iterator iter) {
   container->erase(iter);
 }
 
+// The scheduler is destroyed before the JavaScript environment.
+v8::Local<v8::Value> GetGCStatistics(base::WeakPtr<IdleGCScheduler> scheduler,
+                                     v8::Isolate* isolate) {
+  if (!scheduler)
+    return v8::Null(isolate);
+  return scheduler->GetStatistics(isolate);
+}
+
 }  // namespace
 
 // static
@@ -64,8 +76,7 @@ AtomBrowserMainParts::AtomBrowserMainParts()
     : fake_browser_process_(new BrowserProcess),
       browser_(new Browser),
       node_bindings_(NodeBindings::Create(NodeBindings::BROWSER)),
-      atom_bindings_(new AtomBindings(uv_default_loop())),
-      gc_timer_(true, true) {
+      atom_bindings_(new AtomBindings(uv_default_loop())) {
   DCHECK(!self_) << "Cannot have two AtomBrowserMainParts";
   self_ = this;
   // Register extension scheme as web safe scheme.
@@ -135,7 +146,10 @@ void AtomBrowserMainParts::PostEarlyInitialization() {
 
   // The ProxyResolverV8 has setup a complete V8 environment, in order to
   // avoid conflicts we only initialize our V8 environment after that.
-  js_env_.reset(new JavascriptEnvironment);
+  {
+    ScopedStartupPhase phase("JavascriptEnvironment");
+    js_env_.reset(new JavascriptEnvironment);
+  }
 
   node_bindings_->Initialize();
 
@@ -151,6 +165,13 @@ void AtomBrowserMainParts::PostEarlyInitialization() {
   // Add Electron extended APIs.
   atom_bindings_->BindTo(js_env_->isolate(), env->process_object());
 
+  // Collects garbage when the main process is idle.
+  gc_scheduler_.reset(
+      new IdleGCScheduler(js_env_->isolate(), js_env_->platform()));
+  mate::Dictionary process(js_env_->isolate(), env->process_object());
+  process.SetMethod("getGCStatistics", base::Bind(&GetGCStatistics,
+                                                  gc_scheduler_->GetWeakPtr()));
+
   // Load everything.
   node_bindings_->LoadEnvironment(env);
 
@@ -190,6 +211,7 @@ void AtomBrowserMainParts::ToolkitInitialized() {
 }
 
 void AtomBrowserMainParts::PreMainMessageLoopRun() {
+  ScopedStartupPhase phase("PreMainMessageLoopRun");
   js_env_->OnMessageLoopCreated();
 
   // Run user's main script before most things get initialized, so we can have
@@ -202,9 +224,7 @@ void AtomBrowserMainParts::PreMainMessageLoopRun() {
 #endif
 
   // Start idle gc.
-  gc_timer_.Start(FROM_HERE, base::TimeDelta::FromMinutes(1),
-                  base::Bind(&v8::Isolate::LowMemoryNotification,
-                             base::Unretained(js_env_->isolate())));
+  gc_scheduler_->Start();
 
 #if defined(ENABLE_PDF_VIEWER)
   content::WebUIControllerFactory::RegisterFactory(
@@ -244,6 +264,7 @@ void AtomBrowserMainParts::PostMainMessageLoopStart() {
 void AtomBrowserMainParts::PostMainMessageLoopRun() {
   brightray::BrowserMainParts::PostMainMessageLoopRun();
 
+  gc_scheduler_.reset();
   js_env_->OnMessageLoopDestroying();
 
 #if defined(OS_MACOSX)
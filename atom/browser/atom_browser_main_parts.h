@@ -10,7 +10,6 @@
 #include <string>
 
 #include "base/callback.h"
-#include "base/timer/timer.h"
 #include "brightray/browser/browser_main_parts.h"
 #include "content/public/browser/browser_context.h"
 #include "services/device/public/mojom/geolocation_control.mojom.h"
@@ -27,6 +26,7 @@ namespace atom {
 
 class AtomBindings;
 class Browser;
+class IdleGCScheduler;
 class JavascriptEnvironment;
 class NodeBindings;
 class NodeDebugger;
@@ -60,6 +60,7 @@ class AtomBrowserMainParts : public brightray::BrowserMainParts {
   device::mojom::GeolocationControl* GetGeolocationControl();
 
   Browser* browser() { return browser_.get(); }
+  JavascriptEnvironment* js_env() { return js_env_.get(); }
 
  protected:
   // content::BrowserMainParts:
@@ -109,7 +110,7 @@ class AtomBrowserMainParts : public brightray::BrowserMainParts {
   std::unique_ptr<NodeEnvironment> node_env_;
   std::unique_ptr<NodeDebugger> node_debugger_;
 
-  base::Timer gc_timer_;
+  std::unique_ptr<IdleGCScheduler> gc_scheduler_;
 
   // List of callbacks should be executed before destroying JS env.
   std::list<base::OnceClosure> destructors_;
@@ -44,6 +44,11 @@ base::FilePath CreateDownloadPath(const GURL& url,
   return default_download_path.Append(generated_name);
 }
 
+void SetLastDownloadDirectory(const base::FilePath& directory,
+                              PrefService* pref_service) {
+  pref_service->SetFilePath(prefs::kDownloadDefaultDirectory, directory);
+}
+
 }  // namespace
 
 AtomDownloadManagerDelegate::AtomDownloadManagerDelegate(
@@ -104,8 +109,8 @@ void AtomDownloadManagerDelegate::OnDownloadPathGenerated(
     // Remember the last selected download directory.
     AtomBrowserContext* browser_context = static_cast<AtomBrowserContext*>(
         download_manager_->GetBrowserContext());
-    browser_context->prefs()->SetFilePath(prefs::kDownloadDefaultDirectory,
-                                          path.DirName());
+    browser_context->RunWhenPrefsLoaded(
+        base::BindOnce(&SetLastDownloadDirectory, path.DirName()));
 
     v8::Isolate* isolate = v8::Isolate::GetCurrent();
     v8::Locker locker(isolate);
@@ -12,6 +12,8 @@
 #include "atom/browser/login_handler.h"
 #include "atom/browser/native_window.h"
 #include "atom/browser/window_list.h"
+#include "atom/common/code_cache.h"
+#include "atom/common/startup_timeline.h"
 #include "base/files/file_util.h"
 #include "base/message_loop/message_loop.h"
 #include "base/path_service.h"
@@ -152,10 +154,19 @@ void Browser::DidFinishLaunching(const base::DictionaryValue& launch_info) {
   // Make sure the userData directory is created.
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   base::FilePath user_data;
-  if (PathService::Get(brightray::DIR_USER_DATA, &user_data))
+  if (PathService::Get(brightray::DIR_USER_DATA, &user_data)) {
     base::CreateDirectoryAndGetError(user_data, nullptr);
+#if defined(ENABLE_INIT_CODE_CACHE)
+    // Apps set their userData path before they are ready, so from now on the
+    // code cache of the modules loaded in this process is kept per app.
+    SetCodeCacheDirectory(
+        user_data.Append(FILE_PATH_LITERAL("Electron Code Cache"))
+            .Append(FILE_PATH_LITERAL("Browser")));
+#endif
+  }
 
   is_ready_ = true;
+  RecordStartupMark("AppReady");
   if (ready_promise_) {
     ready_promise_->Resolve();
   }
@@ -0,0 +1,175 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/idle_gc_scheduler.h"
+
+#include <algorithm>
+
+#include "base/bind.h"
+#include "base/message_loop/message_loop_current.h"
+#include "native_mate/dictionary.h"
+
+namespace atom {
+
+namespace {
+
+// How often the scheduler looks for a chance to collect garbage.
+constexpr base::TimeDelta kCheckInterval = base::TimeDelta::FromSeconds(10);
+
+// The UI thread is considered idle when it was busy for less than 1/20 of
+// the check interval.
+constexpr int kIdleBusyDivisor = 20;
+
+// Time given to V8 for an incremental idle-time GC.
+constexpr base::TimeDelta kIdleGCDeadline =
+    base::TimeDelta::FromMilliseconds(50);
+
+// Heap growth since the last mark-sweep that is worth an idle-time GC.
+constexpr size_t kIdleGCGrowth = 4 * 1024 * 1024;
+
+// Heap growth since the last mark-sweep that is worth a full GC.
+constexpr size_t kFullGCGrowth = 32 * 1024 * 1024;
+
+// Minimum time between two full GCs that are not caused by memory pressure.
+constexpr base::TimeDelta kMinFullGCInterval = base::TimeDelta::FromMinutes(1);
+
+}  // namespace
+
+IdleGCScheduler::IdleGCScheduler(v8::Isolate* isolate, v8::Platform* platform)
+    : isolate_(isolate), platform_(platform), weak_factory_(this) {
+  isolate_->AddGCPrologueCallback(&IdleGCScheduler::OnGCPrologue, this);
+  isolate_->AddGCEpilogueCallback(&IdleGCScheduler::OnGCEpilogue, this);
+}
+
+IdleGCScheduler::~IdleGCScheduler() {
+  if (check_timer_.IsRunning())
+    base::MessageLoopCurrent::Get()->RemoveTaskObserver(this);
+  isolate_->RemoveGCPrologueCallback(&IdleGCScheduler::OnGCPrologue, this);
+  isolate_->RemoveGCEpilogueCallback(&IdleGCScheduler::OnGCEpilogue, this);
+}
+
+void IdleGCScheduler::Start() {
+  heap_size_after_full_gc_ = GetUsedHeapSize();
+  last_full_gc_time_ = base::TimeTicks::Now();
+
+  base::MessageLoopCurrent::Get()->AddTaskObserver(this);
+  memory_pressure_listener_ = std::make_unique<base::MemoryPressureListener>(
+      base::Bind(&IdleGCScheduler::OnMemoryPressure, base::Unretained(this)));
+  check_timer_.Start(FROM_HERE, kCheckInterval,
+                     base::Bind(&IdleGCScheduler::OnCheckTimer,
+                                base::Unretained(this)));
+}
+
+v8::Local<v8::Value> IdleGCScheduler::GetStatistics(v8::Isolate* isolate) {
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("scavengeCount", scavenge_count_);
+  dict.Set("markSweepCount", mark_sweep_count_);
+  dict.Set("incrementalMarkingCount", incremental_marking_count_);
+  dict.Set("idleGCCount", idle_gc_count_);
+  dict.Set("fullGCCount", full_gc_count_);
+  dict.Set("totalPauseTime", total_pause_.InMillisecondsF());
+  dict.Set("maxPauseTime", max_pause_.InMillisecondsF());
+  dict.Set("lastPauseTime", last_pause_.InMillisecondsF());
+  return dict.GetHandle();
+}
+
+void IdleGCScheduler::WillProcessTask(const base::PendingTask& pending_task) {
+  task_start_time_ = base::TimeTicks::Now();
+}
+
+void IdleGCScheduler::DidProcessTask(const base::PendingTask& pending_task) {
+  if (!task_start_time_.is_null())
+    busy_time_ += base::TimeTicks::Now() - task_start_time_;
+  task_start_time_ = base::TimeTicks();
+}
+
+// static
+void IdleGCScheduler::OnGCPrologue(v8::Isolate* isolate,
+                                   v8::GCType type,
+                                   v8::GCCallbackFlags flags,
+                                   void* data) {
+  auto* self = static_cast<IdleGCScheduler*>(data);
+  self->gc_start_time_ = base::TimeTicks::Now();
+}
+
+// static
+void IdleGCScheduler::OnGCEpilogue(v8::Isolate* isolate,
+                                   v8::GCType type,
+                                   v8::GCCallbackFlags flags,
+                                   void* data) {
+  auto* self = static_cast<IdleGCScheduler*>(data);
+  if (self->gc_start_time_.is_null())
+    return;
+
+  base::TimeDelta pause = base::TimeTicks::Now() - self->gc_start_time_;
+  self->gc_start_time_ = base::TimeTicks();
+  self->total_pause_ += pause;
+  self->max_pause_ = std::max(self->max_pause_, pause);
+  self->last_pause_ = pause;
+
+  switch (type) {
+    case v8::kGCTypeScavenge:
+      self->scavenge_count_++;
+      break;
+    case v8::kGCTypeMarkSweepCompact:
+      self->mark_sweep_count_++;
+      self->heap_size_after_full_gc_ = self->GetUsedHeapSize();
+      self->last_full_gc_time_ = base::TimeTicks::Now();
+      break;
+    case v8::kGCTypeIncrementalMarking:
+      self->incremental_marking_count_++;
+      break;
+    default:
+      break;
+  }
+}
+
+void IdleGCScheduler::OnMemoryPressure(
+    base::MemoryPressureListener::MemoryPressureLevel level) {
+  switch (level) {
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_CRITICAL:
+      // V8 collects all available garbage right away.
+      isolate_->MemoryPressureNotification(v8::MemoryPressureLevel::kCritical);
+      break;
+    case base::MemoryPressureListener::MEMORY_PRESSURE_LEVEL_MODERATE:
+      // Wait for the next idle period.
+      full_gc_requested_ = true;
+      break;
+    default:
+      break;
+  }
+}
+
+void IdleGCScheduler::OnCheckTimer() {
+  base::TimeDelta busy_time = busy_time_;
+  busy_time_ = base::TimeDelta();
+  if (busy_time > kCheckInterval / kIdleBusyDivisor)
+    return;
+
+  size_t used = GetUsedHeapSize();
+  size_t growth =
+      used > heap_size_after_full_gc_ ? used - heap_size_after_full_gc_ : 0;
+  bool full_gc_due =
+      base::TimeTicks::Now() - last_full_gc_time_ >= kMinFullGCInterval;
+  if (full_gc_requested_ ||
+      (full_gc_due &&
+       (growth > kFullGCGrowth || used > 2 * heap_size_after_full_gc_))) {
+    full_gc_requested_ = false;
+    full_gc_count_++;
+    isolate_->LowMemoryNotification();
+  } else if (growth > kIdleGCGrowth) {
+    idle_gc_count_++;
+    double deadline = platform_->MonotonicallyIncreasingTime() +
+                      kIdleGCDeadline.InSecondsF();
+    isolate_->IdleNotificationDeadline(deadline);
+  }
+}
+
+size_t IdleGCScheduler::GetUsedHeapSize() {
+  v8::HeapStatistics heap_statistics;
+  isolate_->GetHeapStatistics(&heap_statistics);
+  return heap_statistics.used_heap_size();
+}
+
+}  // namespace atom
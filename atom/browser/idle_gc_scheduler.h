@@ -0,0 +1,96 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
+#define ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
+
+#include <memory>
+
+#include "base/macros.h"
+#include "base/memory/memory_pressure_listener.h"
+#include "base/memory/weak_ptr.h"
+#include "base/message_loop/message_loop.h"
+#include "base/time/time.h"
+#include "base/timer/timer.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Runs garbage collections of the main process when the UI message loop is
+// idle, picking between an incremental idle-time GC, a full GC, or nothing
+// depending on how much the heap has grown and on memory pressure.
+class IdleGCScheduler : public base::MessageLoop::TaskObserver {
+ public:
+  IdleGCScheduler(v8::Isolate* isolate, v8::Platform* platform);
+  ~IdleGCScheduler() override;
+
+  // Starts observing the current message loop.
+  void Start();
+
+  // Returns the GC pause statistics of the isolate.
+  v8::Local<v8::Value> GetStatistics(v8::Isolate* isolate);
+
+  base::WeakPtr<IdleGCScheduler> GetWeakPtr() {
+    return weak_factory_.GetWeakPtr();
+  }
+
+ protected:
+  // base::MessageLoop::TaskObserver:
+  void WillProcessTask(const base::PendingTask& pending_task) override;
+  void DidProcessTask(const base::PendingTask& pending_task) override;
+
+ private:
+  static void OnGCPrologue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags,
+                           void* data);
+  static void OnGCEpilogue(v8::Isolate* isolate,
+                           v8::GCType type,
+                           v8::GCCallbackFlags flags,
+                           void* data);
+
+  void OnMemoryPressure(
+      base::MemoryPressureListener::MemoryPressureLevel level);
+
+  // Called periodically to decide which GC to run.
+  void OnCheckTimer();
+
+  size_t GetUsedHeapSize();
+
+  v8::Isolate* isolate_;
+  v8::Platform* platform_;
+
+  base::RepeatingTimer check_timer_;
+  std::unique_ptr<base::MemoryPressureListener> memory_pressure_listener_;
+
+  // Time spent running tasks on the UI thread since the last check.
+  base::TimeTicks task_start_time_;
+  base::TimeDelta busy_time_;
+
+  // Used heap size right after the last mark-sweep GC.
+  size_t heap_size_after_full_gc_ = 0;
+  base::TimeTicks last_full_gc_time_;
+
+  // Whether a moderate memory pressure asked for a full GC.
+  bool full_gc_requested_ = false;
+
+  // GC pause statistics.
+  base::TimeTicks gc_start_time_;
+  int scavenge_count_ = 0;
+  int mark_sweep_count_ = 0;
+  int incremental_marking_count_ = 0;
+  int idle_gc_count_ = 0;
+  int full_gc_count_ = 0;
+  base::TimeDelta total_pause_;
+  base::TimeDelta max_pause_;
+  base::TimeDelta last_pause_;
+
+  base::WeakPtrFactory<IdleGCScheduler> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(IdleGCScheduler);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_IDLE_GC_SCHEDULER_H_
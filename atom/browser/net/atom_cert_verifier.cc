@@ -66,21 +66,16 @@ class CertVerifierRequest : public AtomCertVerifier::Request {
   }
 
   void RunResponse(Response* response) {
-    if (custom_response_ == net::ERR_ABORTED) {
-      *(response->verify_result()) = result_;
-      response->callback().Run(error_);
-    } else {
-      response->verify_result()->Reset();
-      response->verify_result()->verified_cert = params_.certificate();
-      cert_verifier_->ct_delegate()->AddCTExcludedHost(params_.hostname());
-      response->callback().Run(custom_response_);
-    }
+    int error = cert_verifier_->RunVerifyOutcome(params_, outcome_,
+                                                 response->verify_result());
+    response->callback().Run(error);
     delete response;
   }
 
   void Start(net::CRLSet* crl_set, const net::NetLogWithSource& net_log) {
+    verify_proc_id_ = cert_verifier_->verify_proc_id_;
     int error = cert_verifier_->default_verifier()->Verify(
-        params_, crl_set, &result_,
+        params_, crl_set, &outcome_.result,
         base::Bind(&CertVerifierRequest::OnDefaultVerificationDone,
                    weak_ptr_factory_.GetWeakPtr()),
         &default_verifier_request_, net_log);
@@ -89,7 +84,7 @@ class CertVerifierRequest : public AtomCertVerifier::Request {
   }
 
   void OnDefaultVerificationDone(int error) {
-    error_ = error;
+    outcome_.error = error;
     auto request = std::make_unique<VerifyRequestParams>();
     request->hostname = params_.hostname();
     request->default_result = net::ErrorToString(error);
@@ -119,8 +114,9 @@ class CertVerifierRequest : public AtomCertVerifier::Request {
   }
 
   void NotifyResponseInIO(int result) {
-    custom_response_ = result;
+    outcome_.custom_response = result;
     first_response_ = false;
+    cert_verifier_->CacheOutcome(params_, verify_proc_id_, outcome_);
     // Responding to first request in the list will initiate destruction of
     // the class, respond to others in the list inside destructor.
     base::LinkNode<Response>* response_node = response_list_.head();
@@ -141,23 +137,44 @@ class CertVerifierRequest : public AtomCertVerifier::Request {
 
   const AtomCertVerifier::RequestParams params_;
   AtomCertVerifier* cert_verifier_;
-  int error_ = net::ERR_IO_PENDING;
-  int custom_response_ = net::ERR_IO_PENDING;
+  int verify_proc_id_ = 0;
+  AtomCertVerifier::VerifyOutcome outcome_;
   bool first_response_ = true;
   ResponseList response_list_;
-  net::CertVerifyResult result_;
   std::unique_ptr<AtomCertVerifier::Request> default_verifier_request_;
   base::WeakPtrFactory<CertVerifierRequest> weak_ptr_factory_;
 };
 
+AtomCertVerifier::VerifyOutcome::VerifyOutcome()
+    : error(net::ERR_IO_PENDING), custom_response(net::ERR_IO_PENDING) {}
+
+AtomCertVerifier::VerifyOutcome::~VerifyOutcome() = default;
+
 AtomCertVerifier::AtomCertVerifier(brightray::RequireCTDelegate* ct_delegate)
     : default_cert_verifier_(net::CertVerifier::CreateDefault()),
-      ct_delegate_(ct_delegate) {}
+      ct_delegate_(ct_delegate),
+      cache_(base::MRUCache<CacheKey, VerifyOutcome>::NO_AUTO_EVICT) {}
 
 AtomCertVerifier::~AtomCertVerifier() {}
 
-void AtomCertVerifier::SetVerifyProc(const VerifyProc& proc) {
+void AtomCertVerifier::SetVerifyProc(const VerifyProc& proc,
+                                     base::TimeDelta cache_ttl,
+                                     size_t max_cache_size) {
   verify_proc_ = proc;
+  verify_proc_id_++;
+  cache_ttl_ = cache_ttl;
+  max_cache_size_ = max_cache_size;
+  cache_.Clear();
+  cache_hits_ = 0;
+  cache_misses_ = 0;
+}
+
+void AtomCertVerifier::GetCacheStatistics(int* hits,
+                                          int* misses,
+                                          int* size) const {
+  *hits = cache_hits_;
+  *misses = cache_misses_;
+  *size = static_cast<int>(cache_.size());
 }
 
 int AtomCertVerifier::Verify(const RequestParams& params,
@@ -173,6 +190,10 @@ int AtomCertVerifier::Verify(const RequestParams& params,
     return default_cert_verifier_->Verify(params, crl_set, verify_result,
                                           callback, out_req, net_log);
   } else {
+    int error;
+    if (GetCachedOutcome(params, verify_result, &error))
+      return error;
+
     CertVerifierRequest* request = FindRequest(params);
     if (!request) {
       out_req->reset();
@@ -208,4 +229,61 @@ CertVerifierRequest* AtomCertVerifier::FindRequest(
   return nullptr;
 }
 
+// static
+AtomCertVerifier::CacheKey AtomCertVerifier::GetCacheKey(
+    const RequestParams& params) {
+  const net::X509Certificate* cert = params.certificate().get();
+  return CacheKey(params.hostname(),
+                  net::X509Certificate::CalculateChainFingerprint256(
+                      cert->cert_buffer(), cert->intermediate_buffers()),
+                  params.flags());
+}
+
+int AtomCertVerifier::RunVerifyOutcome(const RequestParams& params,
+                                       const VerifyOutcome& outcome,
+                                       net::CertVerifyResult* verify_result) {
+  if (outcome.custom_response == net::ERR_ABORTED) {
+    *verify_result = outcome.result;
+    return outcome.error;
+  }
+  verify_result->Reset();
+  verify_result->verified_cert = params.certificate();
+  ct_delegate_->AddCTExcludedHost(params.hostname());
+  return outcome.custom_response;
+}
+
+bool AtomCertVerifier::GetCachedOutcome(const RequestParams& params,
+                                        net::CertVerifyResult* verify_result,
+                                        int* error) {
+  if (cache_ttl_.is_zero())
+    return false;
+
+  auto it = cache_.Get(GetCacheKey(params));
+  if (it == cache_.end()) {
+    cache_misses_++;
+    return false;
+  }
+  if (it->second.expiration <= base::TimeTicks::Now()) {
+    cache_.Erase(it);
+    cache_misses_++;
+    return false;
+  }
+
+  cache_hits_++;
+  *error = RunVerifyOutcome(params, it->second, verify_result);
+  return true;
+}
+
+void AtomCertVerifier::CacheOutcome(const RequestParams& params,
+                                    int verify_proc_id,
+                                    const VerifyOutcome& outcome) {
+  if (cache_ttl_.is_zero() || verify_proc_id != verify_proc_id_)
+    return;
+
+  VerifyOutcome cached = outcome;
+  cached.expiration = base::TimeTicks::Now() + cache_ttl_;
+  cache_.Put(GetCacheKey(params), cached);
+  cache_.ShrinkToSize(max_cache_size_);
+}
+
 }  // namespace atom
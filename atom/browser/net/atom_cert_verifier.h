@@ -8,8 +8,13 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <tuple>
 
+#include "base/containers/mru_cache.h"
+#include "base/time/time.h"
+#include "net/base/hash_value.h"
 #include "net/cert/cert_verifier.h"
+#include "net/cert/cert_verify_result.h"
 
 namespace brightray {
 
@@ -40,7 +45,15 @@ class AtomCertVerifier : public net::CertVerifier {
   using VerifyProc = base::Callback<void(const VerifyRequestParams& request,
                                          const net::CompletionCallback&)>;
 
-  void SetVerifyProc(const VerifyProc& proc);
+  // The results of |proc| are cached for |cache_ttl|, a zero |cache_ttl|
+  // disables the cache. Setting a new proc clears the cache.
+  void SetVerifyProc(const VerifyProc& proc,
+                     base::TimeDelta cache_ttl = base::TimeDelta(),
+                     size_t max_cache_size = 0);
+
+  // Fills the statistics of the verify proc's cache into |hits|, |misses| and
+  // |size|.
+  void GetCacheStatistics(int* hits, int* misses, int* size) const;
 
   const VerifyProc verify_proc() const { return verify_proc_; }
   brightray::RequireCTDelegate* ct_delegate() const { return ct_delegate_; }
@@ -61,11 +74,51 @@ class AtomCertVerifier : public net::CertVerifier {
  private:
   friend class CertVerifierRequest;
 
+  // Result of a verification with the verify proc.
+  struct VerifyOutcome {
+    VerifyOutcome();
+    ~VerifyOutcome();
+
+    // The result of the default verifier.
+    int error;
+    net::CertVerifyResult result;
+    // The result passed to the callback of the verify proc.
+    int custom_response;
+    base::TimeTicks expiration;
+  };
+
+  // The results are cached by (hostname, chain fingerprint, flags).
+  using CacheKey = std::tuple<std::string, net::SHA256HashValue, int>;
+
+  static CacheKey GetCacheKey(const RequestParams& params);
+
   void RemoveRequest(const RequestParams& params);
   CertVerifierRequest* FindRequest(const RequestParams& params);
 
+  // Applies |outcome| to |verify_result| and returns the error code.
+  int RunVerifyOutcome(const RequestParams& params,
+                       const VerifyOutcome& outcome,
+                       net::CertVerifyResult* verify_result);
+
+  // Looks up the cached outcome of |params|, returns false on cache miss.
+  bool GetCachedOutcome(const RequestParams& params,
+                        net::CertVerifyResult* verify_result,
+                        int* error);
+  void CacheOutcome(const RequestParams& params,
+                    int verify_proc_id,
+                    const VerifyOutcome& outcome);
+
   std::map<RequestParams, CertVerifierRequest*> inflight_requests_;
   VerifyProc verify_proc_;
+  // Incremented for each verify proc, so outcomes of requests started with an
+  // older proc are not cached.
+  int verify_proc_id_ = 0;
+
+  base::TimeDelta cache_ttl_;
+  size_t max_cache_size_ = 0;
+  base::MRUCache<CacheKey, VerifyOutcome> cache_;
+  int cache_hits_ = 0;
+  int cache_misses_ = 0;
   std::unique_ptr<net::CertVerifier> default_cert_verifier_;
   brightray::RequireCTDelegate* ct_delegate_;
 
@@ -274,6 +274,16 @@ void AtomNetworkDelegate::SetDevToolsNetworkEmulationClientId(
   client_id_ = client_id;
 }
 
+void AtomNetworkDelegate::GetHttpCacheCounters(int* hits,
+                                               int* validations,
+                                               int* updates,
+                                               int* misses) const {
+  *hits = cache_hits_;
+  *validations = cache_validations_;
+  *updates = cache_updates_;
+  *misses = cache_misses_;
+}
+
 int AtomNetworkDelegate::OnBeforeURLRequest(
     net::URLRequest* request,
     const net::CompletionCallback& callback,
@@ -357,6 +367,25 @@ void AtomNetworkDelegate::OnCompleted(net::URLRequest* request, bool started) {
   // OnCompleted may happen before other events.
   callbacks_.erase(request->identifier());
 
+  switch (request->response_info().cache_entry_status) {
+    case net::HttpResponseInfo::ENTRY_USED:
+      ++cache_hits_;
+      break;
+    case net::HttpResponseInfo::ENTRY_VALIDATED:
+      ++cache_validations_;
+      break;
+    case net::HttpResponseInfo::ENTRY_UPDATED:
+      ++cache_updates_;
+      break;
+    case net::HttpResponseInfo::ENTRY_NOT_IN_CACHE:
+    case net::HttpResponseInfo::ENTRY_CANT_CONDITIONALIZE:
+      ++cache_misses_;
+      break;
+    default:
+      // Requests that did not use the cache.
+      break;
+  }
+
   if (request->status().status() == net::URLRequestStatus::FAILED ||
       request->status().status() == net::URLRequestStatus::CANCELED) {
     // Error event.
@@ -81,6 +81,14 @@ class AtomNetworkDelegate : public net::NetworkDelegate {
 
   void SetDevToolsNetworkEmulationClientId(const std::string& client_id);
 
+  // Counts of the requests served by the HTTP cache, without revalidation,
+  // after revalidation, the requests whose cached response was replaced by
+  // the server, and the requests that were not in the cache.
+  void GetHttpCacheCounters(int* hits,
+                            int* validations,
+                            int* updates,
+                            int* misses) const;
+
  protected:
   // net::NetworkDelegate:
   int OnBeforeURLRequest(net::URLRequest* request,
@@ -175,6 +183,11 @@ class AtomNetworkDelegate : public net::NetworkDelegate {
   // Client id for devtools network emulation.
   std::string client_id_;
 
+  int cache_hits_ = 0;
+  int cache_validations_ = 0;
+  int cache_updates_ = 0;
+  int cache_misses_ = 0;
+
   DISALLOW_COPY_AND_ASSIGN(AtomNetworkDelegate);
 };
 
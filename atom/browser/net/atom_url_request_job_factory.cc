@@ -43,6 +43,7 @@ bool AtomURLRequestJobFactory::SetProtocolHandler(
 
     delete it->second;
     protocol_handler_map_.erase(it);
+    response_cache_.Clear(scheme);
     return true;
   }
 
@@ -61,6 +62,7 @@ bool AtomURLRequestJobFactory::InterceptProtocol(
   ProtocolHandler* original_protocol_handler = protocol_handler_map_[scheme];
   protocol_handler_map_[scheme] = protocol_handler.release();
   original_protocols_[scheme].reset(original_protocol_handler);
+  response_cache_.Clear(scheme);
   return true;
 }
 
@@ -70,6 +72,7 @@ bool AtomURLRequestJobFactory::UninterceptProtocol(const std::string& scheme) {
     return false;
   protocol_handler_map_[scheme] = it->second.release();
   original_protocols_.erase(it);
+  response_cache_.Clear(scheme);
   return true;
 }
 
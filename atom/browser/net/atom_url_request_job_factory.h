@@ -12,6 +12,7 @@
 #include <unordered_map>
 #include <vector>
 
+#include "atom/browser/net/protocol_response_cache.h"
 #include "net/url_request/url_request_job_factory.h"
 
 namespace atom {
@@ -43,6 +44,9 @@ class AtomURLRequestJobFactory : public net::URLRequestJobFactory {
   // Clear all protocol handlers.
   void Clear();
 
+  // The cache of the responses of custom protocol handlers.
+  ProtocolResponseCache* response_cache() { return &response_cache_; }
+
   // URLRequestJobFactory implementation
   net::URLRequestJob* MaybeCreateJobWithProtocolHandler(
       const std::string& scheme,
@@ -69,6 +73,9 @@ class AtomURLRequestJobFactory : public net::URLRequestJobFactory {
   // Can only be accessed in IO thread.
   OriginalProtocolsMap original_protocols_;
 
+  // Can only be accessed in IO thread.
+  ProtocolResponseCache response_cache_;
+
   DISALLOW_COPY_AND_ASSIGN(AtomURLRequestJobFactory);
 };
 
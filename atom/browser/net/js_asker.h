@@ -8,10 +8,12 @@
 #include <memory>
 #include <utility>
 
+#include "atom/browser/net/protocol_response_cache.h"
 #include "atom/common/native_mate_converters/net_converter.h"
 #include "base/callback.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/values.h"
 #include "content/public/browser/browser_thread.h"
 #include "net/base/net_errors.h"
@@ -54,9 +56,11 @@ class JsAsker : public RequestJob {
   // Called by |CustomProtocolHandler| to store handler related information.
   void SetHandlerInfo(v8::Isolate* isolate,
                       net::URLRequestContextGetter* request_context_getter,
+                      ProtocolResponseCache* response_cache,
                       const JavaScriptHandler& handler) {
     isolate_ = isolate;
     request_context_getter_ = request_context_getter;
+    response_cache_ = response_cache;
     handler_ = handler;
   }
 
@@ -64,6 +68,11 @@ class JsAsker : public RequestJob {
   virtual void BeforeStartInUI(v8::Isolate*, v8::Local<v8::Value>) {}
   virtual void StartAsync(std::unique_ptr<base::Value> options) = 0;
 
+  // Whether the options returned by the handler can be reused for another
+  // request, subclass should return true if the options hold the whole
+  // response.
+  virtual bool CanCacheResponse() const { return false; }
+
   net::URLRequestContextGetter* request_context_getter() const {
     return request_context_getter_;
   }
@@ -71,8 +80,21 @@ class JsAsker : public RequestJob {
  private:
   // RequestJob:
   void Start() override {
-    auto request_details = std::make_unique<base::DictionaryValue>();
     request_start_time_ = base::TimeTicks::Now();
+    if (response_cache_ && CanCacheResponse()) {
+      std::unique_ptr<base::Value> cached =
+          response_cache_->Get(RequestJob::request());
+      if (cached) {
+        // Answer from the cache without asking the handler in UI thread.
+        base::ThreadTaskRunnerHandle::Get()->PostTask(
+            FROM_HERE, base::BindOnce(&JsAsker::OnCachedResponse,
+                                      weak_factory_.GetWeakPtr(),
+                                      std::move(cached)));
+        return;
+      }
+    }
+
+    auto request_details = std::make_unique<base::DictionaryValue>();
     FillRequestDetails(request_details.get(), RequestJob::request());
     content::BrowserThread::PostTask(
         content::BrowserThread::UI, FROM_HERE,
@@ -104,6 +126,8 @@ class JsAsker : public RequestJob {
     response_start_time_ = base::TimeTicks::Now();
     int error = net::ERR_NOT_IMPLEMENTED;
     if (success && value && !internal::IsErrorOptions(value.get(), &error)) {
+      if (response_cache_ && CanCacheResponse())
+        response_cache_->Put(RequestJob::request(), *value);
       StartAsync(std::move(value));
     } else {
       RequestJob::NotifyStartError(
@@ -111,8 +135,14 @@ class JsAsker : public RequestJob {
     }
   }
 
+  void OnCachedResponse(std::unique_ptr<base::Value> value) {
+    response_start_time_ = base::TimeTicks::Now();
+    StartAsync(std::move(value));
+  }
+
   v8::Isolate* isolate_;
   net::URLRequestContextGetter* request_context_getter_;
+  ProtocolResponseCache* response_cache_ = nullptr;
   JavaScriptHandler handler_;
   base::TimeTicks request_start_time_;
   base::TimeTicks response_start_time_;
@@ -0,0 +1,202 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/net/protocol_response_cache.h"
+
+#include <utility>
+
+#include "base/strings/string_util.h"
+#include "base/values.h"
+#include "content/public/browser/browser_thread.h"
+#include "net/base/load_flags.h"
+#include "net/http/http_response_headers.h"
+#include "net/url_request/url_request.h"
+#include "url/gurl.h"
+
+using content::BrowserThread;
+
+namespace atom {
+
+namespace {
+
+// Default limit of the memory used by the cached responses.
+const size_t kDefaultMaxSize = 32 * 1024 * 1024;
+
+// Returns the approximate memory used by |value|.
+size_t EstimateSize(const base::Value& value) {
+  switch (value.type()) {
+    case base::Value::Type::STRING:
+      return sizeof(value) + value.GetString().size();
+    case base::Value::Type::BINARY:
+      return sizeof(value) + value.GetBlob().size();
+    case base::Value::Type::DICTIONARY: {
+      size_t size = sizeof(value);
+      for (const auto& it : value.DictItems())
+        size += it.first.size() + EstimateSize(it.second);
+      return size;
+    }
+    case base::Value::Type::LIST: {
+      size_t size = sizeof(value);
+      for (const auto& item : value.GetList())
+        size += EstimateSize(item);
+      return size;
+    }
+    default:
+      return sizeof(value);
+  }
+}
+
+// Reads how long the |response| can be cached, returns false if the response
+// should not be cached at all.
+bool GetMaxAge(const base::Value& response,
+               base::TimeDelta default_max_age,
+               base::TimeDelta* max_age) {
+  *max_age = default_max_age;
+  const base::DictionaryValue* dict = nullptr;
+  if (!response.GetAsDictionary(&dict))
+    return true;
+
+  // An explicit cache option overrides the headers.
+  const base::DictionaryValue* cache = nullptr;
+  double seconds;
+  if (dict->GetDictionary("cache", &cache) &&
+      cache->GetDouble("maxAge", &seconds)) {
+    *max_age = base::TimeDelta::FromSecondsD(seconds);
+    return true;
+  }
+
+  const base::DictionaryValue* headers = nullptr;
+  if (!dict->GetDictionary("headers", &headers))
+    return true;
+  for (const auto& it : headers->DictItems()) {
+    if (!base::EqualsCaseInsensitiveASCII(it.first, "cache-control") ||
+        !it.second.is_string())
+      continue;
+    scoped_refptr<net::HttpResponseHeaders> parsed(
+        new net::HttpResponseHeaders("HTTP/1.1 200 OK"));
+    parsed->AddHeader("Cache-Control: " + it.second.GetString());
+    if (parsed->HasHeaderValue("cache-control", "no-store") ||
+        parsed->HasHeaderValue("cache-control", "no-cache"))
+      return false;
+    parsed->GetMaxAgeValue(max_age);
+  }
+  return true;
+}
+
+// Only requests that always get the same response can be cached, which are
+// keyed by their URL.
+bool IsCacheableRequest(const net::URLRequest* request) {
+  return request->method() == "GET" && !request->has_upload();
+}
+
+}  // namespace
+
+ProtocolResponseCache::Entry::Entry() {}
+
+ProtocolResponseCache::Entry::Entry(Entry&&) = default;
+
+ProtocolResponseCache::Entry::~Entry() {}
+
+ProtocolResponseCache::ProtocolResponseCache()
+    : entries_(base::MRUCache<std::string, Entry>::NO_AUTO_EVICT),
+      max_size_(kDefaultMaxSize) {}
+
+ProtocolResponseCache::~ProtocolResponseCache() {}
+
+void ProtocolResponseCache::EnableScheme(const std::string& scheme,
+                                         base::TimeDelta default_max_age) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  schemes_[scheme] = default_max_age;
+}
+
+void ProtocolResponseCache::DisableScheme(const std::string& scheme) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  schemes_.erase(scheme);
+  Clear(scheme);
+}
+
+void ProtocolResponseCache::SetMaxSize(size_t max_size) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  max_size_ = max_size;
+  Evict();
+}
+
+std::unique_ptr<base::Value> ProtocolResponseCache::Get(
+    const net::URLRequest* request) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (entries_.empty() || !IsCacheableRequest(request) ||
+      request->load_flags() &
+          (net::LOAD_BYPASS_CACHE | net::LOAD_DISABLE_CACHE))
+    return nullptr;
+
+  auto it = entries_.Get(request->url().spec());
+  if (it == entries_.end())
+    return nullptr;
+  if (it->second.expiration <= base::TimeTicks::Now()) {
+    size_ -= it->second.size;
+    entries_.Erase(it);
+    return nullptr;
+  }
+  return it->second.response->CreateDeepCopy();
+}
+
+void ProtocolResponseCache::Put(const net::URLRequest* request,
+                                const base::Value& response) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  auto scheme = schemes_.find(request->url().scheme());
+  if (scheme == schemes_.end() || !IsCacheableRequest(request) ||
+      request->load_flags() & net::LOAD_DISABLE_CACHE)
+    return;
+
+  base::TimeDelta max_age;
+  if (!GetMaxAge(response, scheme->second, &max_age) || max_age.is_zero() ||
+      max_age < base::TimeDelta())
+    return;
+
+  const std::string& url = request->url().spec();
+  Entry entry;
+  entry.response = response.CreateDeepCopy();
+  entry.expiration = base::TimeTicks::Now() + max_age;
+  entry.size = url.size() + EstimateSize(response);
+  // Do not flush the whole cache for a response that can never fit.
+  if (entry.size > max_size_)
+    return;
+
+  auto it = entries_.Peek(url);
+  if (it != entries_.end()) {
+    size_ -= it->second.size;
+    entries_.Erase(it);
+  }
+  size_ += entry.size;
+  entries_.Put(url, std::move(entry));
+  Evict();
+}
+
+void ProtocolResponseCache::Clear(const std::string& scheme) {
+  DCHECK_CURRENTLY_ON(BrowserThread::IO);
+  if (scheme.empty()) {
+    entries_.Clear();
+    size_ = 0;
+    return;
+  }
+
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (GURL(it->first).SchemeIs(scheme)) {
+      size_ -= it->second.size;
+      it = entries_.Erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void ProtocolResponseCache::Evict() {
+  while (size_ > max_size_ && !entries_.empty()) {
+    auto it = entries_.rbegin();
+    size_ -= it->second.size;
+    entries_.Erase(it);
+  }
+}
+
+}  // namespace atom
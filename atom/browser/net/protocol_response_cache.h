@@ -0,0 +1,78 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+#define ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
+
+#include <map>
+#include <memory>
+#include <string>
+
+#include "base/containers/mru_cache.h"
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace base {
+class Value;
+}
+
+namespace net {
+class URLRequest;
+}
+
+namespace atom {
+
+// Caches the responses of the JavaScript handlers of custom protocols in
+// memory, so repeated requests are answered on the IO thread without asking
+// the handler again. Only used on the IO thread.
+class ProtocolResponseCache {
+ public:
+  ProtocolResponseCache();
+  ~ProtocolResponseCache();
+
+  // Starts caching the responses of |scheme|. Responses without cache
+  // directives are kept for |default_max_age|.
+  void EnableScheme(const std::string& scheme,
+                    base::TimeDelta default_max_age);
+  void DisableScheme(const std::string& scheme);
+
+  // Sets the limit of the total size of the cached responses.
+  void SetMaxSize(size_t max_size);
+
+  // Returns a copy of the cached response of |request|, or nullptr.
+  std::unique_ptr<base::Value> Get(const net::URLRequest* request);
+
+  // Caches the |response| of the handler for |request| when it is cacheable.
+  void Put(const net::URLRequest* request, const base::Value& response);
+
+  // Removes the responses of |scheme|, or all responses if |scheme| is empty.
+  void Clear(const std::string& scheme);
+
+ private:
+  struct Entry {
+    Entry();
+    Entry(Entry&&);
+    ~Entry();
+
+    std::unique_ptr<base::Value> response;
+    base::TimeTicks expiration;
+    size_t size = 0;
+
+    DISALLOW_COPY_AND_ASSIGN(Entry);
+  };
+
+  // Removes the least recently used responses until the cache fits.
+  void Evict();
+
+  std::map<std::string, base::TimeDelta> schemes_;
+  base::MRUCache<std::string, Entry> entries_;
+  size_t size_ = 0;
+  size_t max_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ProtocolResponseCache);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NET_PROTOCOL_RESPONSE_CACHE_H_
@@ -46,6 +46,10 @@ void URLRequestAsyncAsarJob::StartAsync(std::unique_ptr<base::Value> options) {
   }
 }
 
+bool URLRequestAsyncAsarJob::CanCacheResponse() const {
+  return true;
+}
+
 void URLRequestAsyncAsarJob::GetResponseInfo(net::HttpResponseInfo* info) {
   std::string status("HTTP/1.1 200 OK");
   auto* headers = new net::HttpResponseHeaders(status);
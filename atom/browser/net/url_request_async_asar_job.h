@@ -19,6 +19,7 @@ class URLRequestAsyncAsarJob : public JsAsker<asar::URLRequestAsarJob> {
 
   // JsAsker:
   void StartAsync(std::unique_ptr<base::Value> options) override;
+  bool CanCacheResponse() const override;
 
   // URLRequestJob:
   void GetResponseInfo(net::HttpResponseInfo* info) override;
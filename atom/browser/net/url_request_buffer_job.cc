@@ -68,6 +68,10 @@ void URLRequestBufferJob::StartAsync(std::unique_ptr<base::Value> options) {
   net::URLRequestSimpleJob::Start();
 }
 
+bool URLRequestBufferJob::CanCacheResponse() const {
+  return true;
+}
+
 void URLRequestBufferJob::GetResponseInfo(net::HttpResponseInfo* info) {
   std::string status("HTTP/1.1 200 OK");
   status.append(base::IntToString(status_code_));
@@ -31,6 +31,10 @@ void URLRequestStringJob::StartAsync(std::unique_ptr<base::Value> options) {
   net::URLRequestSimpleJob::Start();
 }
 
+bool URLRequestStringJob::CanCacheResponse() const {
+  return true;
+}
+
 void URLRequestStringJob::GetResponseInfo(net::HttpResponseInfo* info) {
   std::string status("HTTP/1.1 200 OK");
   auto* headers = new net::HttpResponseHeaders(status);
@@ -20,6 +20,7 @@ class URLRequestStringJob : public JsAsker<net::URLRequestSimpleJob> {
 
   // JsAsker:
   void StartAsync(std::unique_ptr<base::Value> options) override;
+  bool CanCacheResponse() const override;
 
   // URLRequestJob:
   void GetResponseInfo(net::HttpResponseInfo* info) override;
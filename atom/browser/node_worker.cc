@@ -0,0 +1,294 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/browser/node_worker.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "atom/common/api/atom_bindings.h"
+#include "atom/common/api/event_emitter_caller.h"
+#include "atom/common/asar/asar_util.h"
+#include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/node_bindings.h"
+#include "base/bind.h"
+#include "base/threading/thread_task_runner_handle.h"
+#include "gin/array_buffer.h"
+#include "gin/public/isolate_holder.h"
+#include "native_mate/arguments.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/key_cache.h"
+
+#include "atom/common/node_includes.h"
+
+namespace atom {
+
+namespace {
+
+class SerializerDelegate : public v8::ValueSerializer::Delegate {
+ public:
+  explicit SerializerDelegate(v8::Isolate* isolate) : isolate_(isolate) {}
+
+  // v8::ValueSerializer::Delegate:
+  void ThrowDataCloneError(v8::Local<v8::String> message) override {
+    isolate_->ThrowException(v8::Exception::Error(message));
+  }
+
+ private:
+  v8::Isolate* isolate_;
+
+  DISALLOW_COPY_AND_ASSIGN(SerializerDelegate);
+};
+
+}  // namespace
+
+WorkerMessage::WorkerMessage() {}
+
+WorkerMessage::~WorkerMessage() {
+  // Free the buffers of a message that was never delivered.
+  for (const auto& contents : array_buffers_)
+    gin::ArrayBufferAllocator::SharedInstance()->Free(contents.Data(),
+                                                      contents.ByteLength());
+}
+
+// static
+std::unique_ptr<WorkerMessage> WorkerMessage::FromArguments(
+    mate::Arguments* args) {
+  v8::Local<v8::Value> value;
+  if (!args->GetNext(&value)) {
+    args->ThrowError("Missing message");
+    return nullptr;
+  }
+
+  std::vector<v8::Local<v8::ArrayBuffer>> transfer_list;
+  v8::Local<v8::Array> array;
+  if (args->GetNext(&array)) {
+    v8::Local<v8::Context> context = args->isolate()->GetCurrentContext();
+    for (uint32_t i = 0; i < array->Length(); ++i) {
+      v8::Local<v8::Value> item;
+      if (!array->Get(context, i).ToLocal(&item) || !item->IsArrayBuffer()) {
+        args->ThrowError("The transfer list can only contain ArrayBuffers");
+        return nullptr;
+      }
+      auto buffer = item.As<v8::ArrayBuffer>();
+      if (std::find(transfer_list.begin(), transfer_list.end(), buffer) !=
+          transfer_list.end()) {
+        args->ThrowError("An ArrayBuffer is duplicated in the transfer list");
+        return nullptr;
+      }
+      // External buffers are owned by someone else, e.g. Node's Buffer pool.
+      if (!buffer->IsNeuterable() || buffer->IsExternal()) {
+        args->ThrowError(
+            "An ArrayBuffer in the transfer list can not be transferred");
+        return nullptr;
+      }
+      transfer_list.push_back(buffer);
+    }
+  }
+
+  auto message = std::make_unique<WorkerMessage>();
+  if (!message->Serialize(args->isolate(), value, transfer_list))
+    return nullptr;
+  return message;
+}
+
+bool WorkerMessage::Serialize(
+    v8::Isolate* isolate,
+    v8::Local<v8::Value> value,
+    const std::vector<v8::Local<v8::ArrayBuffer>>& transfer_list) {
+  SerializerDelegate delegate(isolate);
+  v8::ValueSerializer serializer(isolate, &delegate);
+  for (size_t i = 0; i < transfer_list.size(); ++i)
+    serializer.TransferArrayBuffer(static_cast<uint32_t>(i), transfer_list[i]);
+
+  serializer.WriteHeader();
+  if (!serializer.WriteValue(isolate->GetCurrentContext(), value)
+           .FromMaybe(false))
+    return false;
+
+  // Only detach the buffers once the message can be sent.
+  for (auto buffer : transfer_list) {
+    array_buffers_.push_back(buffer->Externalize());
+    buffer->Neuter();
+  }
+
+  std::pair<uint8_t*, size_t> result = serializer.Release();
+  data_.assign(result.first, result.first + result.second);
+  free(result.first);
+  return true;
+}
+
+v8::MaybeLocal<v8::Value> WorkerMessage::Deserialize(v8::Isolate* isolate) {
+  v8::EscapableHandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = isolate->GetCurrentContext();
+  v8::ValueDeserializer deserializer(isolate, data_.data(), data_.size());
+  for (size_t i = 0; i < array_buffers_.size(); ++i) {
+    const auto& contents = array_buffers_[i];
+    deserializer.TransferArrayBuffer(
+        static_cast<uint32_t>(i),
+        v8::ArrayBuffer::New(isolate, contents.Data(), contents.ByteLength(),
+                             v8::ArrayBufferCreationMode::kInternalized));
+  }
+  array_buffers_.clear();
+
+  if (!deserializer.ReadHeader(context).FromMaybe(false))
+    return v8::MaybeLocal<v8::Value>();
+  v8::Local<v8::Value> value;
+  if (!deserializer.ReadValue(context).ToLocal(&value))
+    return v8::MaybeLocal<v8::Value>();
+  return handle_scope.Escape(value);
+}
+
+NodeWorker::NodeWorker(const base::FilePath& script_path,
+                       node::MultiIsolatePlatform* platform,
+                       base::WeakPtr<Delegate> delegate)
+    : base::Thread("NodeWorker"),
+      script_path_(script_path),
+      platform_(platform),
+      parent_task_runner_(base::ThreadTaskRunnerHandle::Get()),
+      delegate_(delegate),
+      weak_factory_(this) {
+  weak_this_ = weak_factory_.GetWeakPtr();
+}
+
+NodeWorker::~NodeWorker() {
+  Stop();
+}
+
+void NodeWorker::PostMessageToWorker(std::unique_ptr<WorkerMessage> message) {
+  task_runner()->PostTask(
+      FROM_HERE, base::BindOnce(&NodeWorker::DeliverMessage,
+                                base::Unretained(this), std::move(message)));
+}
+
+void NodeWorker::Terminate() {
+  {
+    base::AutoLock auto_lock(isolate_lock_);
+    if (isolate_)
+      isolate_->TerminateExecution();
+  }
+  StopSoon();
+}
+
+void NodeWorker::Init() {
+  isolate_holder_ = std::make_unique<gin::IsolateHolder>(
+      base::ThreadTaskRunnerHandle::Get(), gin::IsolateHolder::kUseLocker);
+  v8::Isolate* isolate = isolate_holder_->isolate();
+  {
+    base::AutoLock auto_lock(isolate_lock_);
+    isolate_ = isolate;
+  }
+
+  // The isolate is only used by this thread, keep it locked and entered.
+  locker_ = std::make_unique<v8::Locker>(isolate);
+  isolate->Enter();
+
+  v8::HandleScope handle_scope(isolate);
+  v8::Local<v8::Context> context = v8::Context::New(isolate);
+  context_.Reset(isolate, context);
+  v8::Context::Scope context_scope(context);
+
+  node_bindings_.reset(NodeBindings::Create(NodeBindings::WORKER));
+  atom_bindings_ = std::make_unique<AtomBindings>(node_bindings_->uv_loop());
+  node_bindings_->PrepareMessageLoop();
+
+  // Node keeps running tasks of the isolate on the uv loop of this thread.
+  env_ = node_bindings_->CreateEnvironment(context, platform_);
+
+  // Add Electron extended APIs.
+  atom_bindings_->BindTo(isolate, env_->process_object());
+  mate::Dictionary process(isolate, env_->process_object());
+  process.Set("_workerScriptPath", script_path_);
+  process.SetMethod("_postMessageToParent",
+                    base::Bind(&NodeWorker::PostMessageToParent,
+                               base::Unretained(this)));
+  process.SetMethod("_reportWorkerError", base::Bind(&NodeWorker::ReportError,
+                                                     base::Unretained(this)));
+  process.SetMethod("_closeWorker",
+                    base::Bind(&NodeWorker::Close, base::Unretained(this)));
+
+  // Load everything, which runs the script of the worker.
+  node_bindings_->LoadEnvironment(env_);
+
+  // Make uv loop being wrapped by the worker's context.
+  node_bindings_->set_uv_env(env_);
+
+  // Give the node loop a run to make sure everything is ready.
+  node_bindings_->RunMessageLoop();
+}
+
+void NodeWorker::CleanUp() {
+  {
+    base::AutoLock auto_lock(isolate_lock_);
+    isolate_ = nullptr;
+  }
+  v8::Isolate* isolate = isolate_holder_->isolate();
+  isolate->CancelTerminateExecution();
+
+  {
+    v8::HandleScope handle_scope(isolate);
+    v8::Context::Scope context_scope(env_->context());
+    mate::EmitEvent(isolate, env_->process_object(), "exit");
+
+    node_bindings_->set_uv_env(nullptr);
+    atom_bindings_->EnvironmentDestroyed(env_);
+    // Unregisters the isolate from Node's platform.
+    node::IsolateData* isolate_data = env_->isolate_data();
+    node::FreeEnvironment(env_);
+    node::FreeIsolateData(isolate_data);
+    env_ = nullptr;
+  }
+
+  atom_bindings_.reset();
+  node_bindings_.reset();
+  context_.Reset();
+  locker_.reset();
+  isolate->Exit();
+  isolate_holder_.reset();
+
+  // These caches are kept per thread.
+  asar::ClearArchives();
+  mate::ClearKeyCache();
+
+  parent_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Delegate::OnWorkerExit, delegate_));
+}
+
+void NodeWorker::DeliverMessage(std::unique_ptr<WorkerMessage> message) {
+  if (!env_)
+    return;
+
+  v8::Isolate* isolate = env_->isolate();
+  v8::HandleScope handle_scope(isolate);
+  v8::Context::Scope context_scope(env_->context());
+  v8::Local<v8::Value> value;
+  if (message->Deserialize(isolate).ToLocal(&value))
+    mate::EmitEvent(isolate, env_->process_object(), "-worker-message", value);
+}
+
+void NodeWorker::PostMessageToParent(mate::Arguments* args) {
+  std::unique_ptr<WorkerMessage> message = WorkerMessage::FromArguments(args);
+  if (!message)
+    return;
+
+  parent_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&Delegate::OnWorkerMessage, delegate_,
+                                std::move(message)));
+}
+
+void NodeWorker::ReportError(const std::string& message,
+                             const std::string& stack) {
+  parent_task_runner_->PostTask(
+      FROM_HERE,
+      base::BindOnce(&Delegate::OnWorkerError, delegate_, message, stack));
+}
+
+void NodeWorker::Close() {
+  // Like process.exit(), nothing runs in the worker after closing it.
+  isolate_holder_->isolate()->TerminateExecution();
+  parent_task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&NodeWorker::Terminate, weak_this_));
+}
+
+}  // namespace atom
@@ -0,0 +1,132 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_BROWSER_NODE_WORKER_H_
+#define ATOM_BROWSER_NODE_WORKER_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+#include "base/memory/weak_ptr.h"
+#include "base/single_thread_task_runner.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread.h"
+#include "v8/include/v8.h"
+
+namespace gin {
+class IsolateHolder;
+}
+
+namespace mate {
+class Arguments;
+}
+
+namespace node {
+class Environment;
+class MultiIsolatePlatform;
+}  // namespace node
+
+namespace atom {
+
+class AtomBindings;
+class NodeBindings;
+
+// A message sent between the main thread and a NodeWorker. The value is
+// serialized with V8's ValueSerializer so another isolate can read it, the
+// transferred ArrayBuffers are moved into the message without being copied.
+class WorkerMessage {
+ public:
+  WorkerMessage();
+  ~WorkerMessage();
+
+  // Creates a message from the (message[, transferList]) arguments of
+  // postMessage, throws and returns nullptr when they can not be serialized.
+  static std::unique_ptr<WorkerMessage> FromArguments(mate::Arguments* args);
+
+  // Creates the value in the current context of |isolate|, the transferred
+  // ArrayBuffers are owned by |isolate| afterwards.
+  v8::MaybeLocal<v8::Value> Deserialize(v8::Isolate* isolate);
+
+ private:
+  bool Serialize(v8::Isolate* isolate,
+                 v8::Local<v8::Value> value,
+                 const std::vector<v8::Local<v8::ArrayBuffer>>& transfer_list);
+
+  std::vector<uint8_t> data_;
+  std::vector<v8::ArrayBuffer::Contents> array_buffers_;
+
+  DISALLOW_COPY_AND_ASSIGN(WorkerMessage);
+};
+
+// Runs a script with Node.js on its own thread, with its own isolate and uv
+// loop.
+class NodeWorker : public base::Thread {
+ public:
+  // Notified on the thread that created the worker.
+  class Delegate {
+   public:
+    virtual ~Delegate() {}
+
+    virtual void OnWorkerMessage(std::unique_ptr<WorkerMessage> message) = 0;
+    virtual void OnWorkerError(const std::string& message,
+                               const std::string& stack) = 0;
+    virtual void OnWorkerExit() = 0;
+  };
+
+  NodeWorker(const base::FilePath& script_path,
+             node::MultiIsolatePlatform* platform,
+             base::WeakPtr<Delegate> delegate);
+  ~NodeWorker() override;
+
+  // Emits |message| on the parentPort of the worker.
+  void PostMessageToWorker(std::unique_ptr<WorkerMessage> message);
+
+  // Stops the JavaScript running in the worker and quits the thread, the
+  // delegate is notified once the Node.js environment has been destroyed.
+  void Terminate();
+
+ protected:
+  // base::Thread:
+  void Init() override;
+  void CleanUp() override;
+
+ private:
+  void DeliverMessage(std::unique_ptr<WorkerMessage> message);
+
+  // Called by the JavaScript of the worker.
+  void PostMessageToParent(mate::Arguments* args);
+  void ReportError(const std::string& message, const std::string& stack);
+  void Close();
+
+  base::FilePath script_path_;
+  node::MultiIsolatePlatform* platform_;
+  scoped_refptr<base::SingleThreadTaskRunner> parent_task_runner_;
+  base::WeakPtr<Delegate> delegate_;
+
+  // Guards |isolate_|, which is read from the parent thread to terminate the
+  // worker.
+  base::Lock isolate_lock_;
+  v8::Isolate* isolate_ = nullptr;
+
+  // Only used on the worker thread.
+  std::unique_ptr<gin::IsolateHolder> isolate_holder_;
+  std::unique_ptr<v8::Locker> locker_;
+  v8::Global<v8::Context> context_;
+  std::unique_ptr<NodeBindings> node_bindings_;
+  std::unique_ptr<AtomBindings> atom_bindings_;
+  node::Environment* env_ = nullptr;
+
+  // Bound to the parent thread.
+  base::WeakPtr<NodeWorker> weak_this_;
+  base::WeakPtrFactory<NodeWorker> weak_factory_;
+
+  DISALLOW_COPY_AND_ASSIGN(NodeWorker);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_BROWSER_NODE_WORKER_H_
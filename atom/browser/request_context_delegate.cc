@@ -43,27 +43,42 @@ class NoCacheBackend : public net::HttpCache::BackendFactory {
 
 }  // namespace
 
-RequestContextDelegate::RequestContextDelegate(bool use_cache)
-    : use_cache_(use_cache), weak_factory_(this) {}
+RequestContextDelegate::RequestContextDelegate(bool use_cache,
+                                               net::BackendType cache_backend,
+                                               int cache_max_size,
+                                               int memory_cache_max_size)
+    : use_cache_(use_cache),
+      cache_backend_(cache_backend),
+      cache_max_size_(cache_max_size),
+      memory_cache_max_size_(memory_cache_max_size),
+      weak_factory_(this) {}
 
 RequestContextDelegate::~RequestContextDelegate() {}
 
-std::unique_ptr<base::CallbackList<void(const CookieDetails*)>::Subscription>
+std::unique_ptr<RequestContextDelegate::CookieChangeCallbackList::Subscription>
 RequestContextDelegate::RegisterCookieChangeCallback(
-    const base::Callback<void(const CookieDetails*)>& cb) {
+    const CookieChangeCallbackList::CallbackType& cb) {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
   return cookie_change_sub_list_.Add(cb);
 }
 
-void RequestContextDelegate::NotifyCookieChange(
-    const net::CanonicalCookie& cookie,
-    net::CookieChangeCause cause) {
+void RequestContextDelegate::NotifyCookieChanges() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
 
-  CookieDetails cookie_details(
-      &cookie, !(cause == net::CookieChangeCause::INSERTED), cause);
-  cookie_change_sub_list_.Notify(&cookie_details);
+  std::vector<CookieChange> changes;
+  {
+    base::AutoLock auto_lock(pending_cookie_changes_lock_);
+    changes.swap(pending_cookie_changes_);
+  }
+
+  std::vector<CookieDetails> details;
+  details.reserve(changes.size());
+  for (const auto& change : changes)
+    details.emplace_back(&change.first,
+                         !(change.second == net::CookieChangeCause::INSERTED),
+                         change.second);
+  cookie_change_sub_list_.Notify(details);
 }
 
 std::unique_ptr<net::NetworkDelegate>
@@ -120,20 +135,26 @@ RequestContextDelegate::CreateURLRequestJobFactory(
 
 net::HttpCache::BackendFactory*
 RequestContextDelegate::CreateHttpCacheBackendFactory(
-    const base::FilePath& base_path) {
+    const base::FilePath& base_path,
+    bool in_memory) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
-  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
   if (!use_cache_) {
     return new NoCacheBackend;
+  } else if (in_memory) {
+    return net::HttpCache::DefaultBackend::InMemory(memory_cache_max_size_)
+        .release();
   } else {
-    int max_size = 0;
-    base::StringToInt(
-        command_line->GetSwitchValueASCII(switches::kDiskCacheSize), &max_size);
+    int max_size = cache_max_size_;
+    base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+    if (max_size == 0)
+      base::StringToInt(
+          command_line->GetSwitchValueASCII(switches::kDiskCacheSize),
+          &max_size);
 
     base::FilePath cache_path = base_path.Append(FILE_PATH_LITERAL("Cache"));
-    return new net::HttpCache::DefaultBackend(
-        net::DISK_CACHE, net::CACHE_BACKEND_DEFAULT, cache_path, max_size);
+    return new net::HttpCache::DefaultBackend(net::DISK_CACHE, cache_backend_,
+                                              cache_path, max_size);
   }
 }
 
@@ -157,10 +178,19 @@ void RequestContextDelegate::OnCookieChanged(const net::CanonicalCookie& cookie,
                                              net::CookieChangeCause cause) {
   DCHECK_CURRENTLY_ON(BrowserThread::IO);
 
+  // Only the first change since the last notification posts a task, the
+  // changes made before it runs are delivered together.
+  {
+    base::AutoLock auto_lock(pending_cookie_changes_lock_);
+    pending_cookie_changes_.emplace_back(cookie, cause);
+    if (pending_cookie_changes_.size() > 1)
+      return;
+  }
+
   BrowserThread::PostTask(
       BrowserThread::UI, FROM_HERE,
-      base::BindRepeating(&RequestContextDelegate::NotifyCookieChange,
-                          weak_factory_.GetWeakPtr(), cookie, cause));
+      base::BindOnce(&RequestContextDelegate::NotifyCookieChanges,
+                     weak_factory_.GetWeakPtr()));
 }
 
 }  // namespace atom
@@ -7,12 +7,17 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "base/callback_list.h"
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
+#include "base/synchronization/lock.h"
 #include "brightray/browser/url_request_context_getter.h"
+#include "net/base/cache_type.h"
+#include "net/cookies/canonical_cookie.h"
+#include "net/cookies/cookie_change_dispatcher.h"
 
 namespace atom {
 
@@ -21,13 +26,22 @@ struct CookieDetails;
 class RequestContextDelegate
     : public brightray::URLRequestContextGetter::Delegate {
  public:
-  explicit RequestContextDelegate(bool use_cache);
+  // A |cache_max_size| or |memory_cache_max_size| of 0 lets the cache
+  // backend pick the size.
+  RequestContextDelegate(bool use_cache,
+                         net::BackendType cache_backend,
+                         int cache_max_size,
+                         int memory_cache_max_size);
   ~RequestContextDelegate() override;
 
+  using CookieChangeCallbackList =
+      base::CallbackList<void(const std::vector<CookieDetails>&)>;
+
   // Register callbacks that needs to notified on any cookie store changes.
-  std::unique_ptr<base::CallbackList<void(const CookieDetails*)>::Subscription>
+  // The changes are delivered in batches, one per task of the UI thread.
+  std::unique_ptr<CookieChangeCallbackList::Subscription>
   RegisterCookieChangeCallback(
-      const base::Callback<void(const CookieDetails*)>& cb);
+      const CookieChangeCallbackList::CallbackType& cb);
 
  protected:
   std::unique_ptr<net::NetworkDelegate> CreateNetworkDelegate() override;
@@ -35,7 +49,8 @@ class RequestContextDelegate
       net::URLRequestContext* url_request_context,
       content::ProtocolHandlerMap* protocol_handlers) override;
   net::HttpCache::BackendFactory* CreateHttpCacheBackendFactory(
-      const base::FilePath& base_path) override;
+      const base::FilePath& base_path,
+      bool in_memory) override;
   std::unique_ptr<net::CertVerifier> CreateCertVerifier(
       brightray::RequireCTDelegate* ct_delegate) override;
   void GetCookieableSchemes(std::vector<std::string>* cookie_schemes) override;
@@ -43,11 +58,19 @@ class RequestContextDelegate
                        net::CookieChangeCause cause) override;
 
  private:
-  void NotifyCookieChange(const net::CanonicalCookie& cookie,
-                          net::CookieChangeCause cause);
+  using CookieChange = std::pair<net::CanonicalCookie, net::CookieChangeCause>;
+
+  void NotifyCookieChanges();
+
+  CookieChangeCallbackList cookie_change_sub_list_;
 
-  base::CallbackList<void(const CookieDetails*)> cookie_change_sub_list_;
+  // The changes made on the IO thread that have not been notified yet.
+  base::Lock pending_cookie_changes_lock_;
+  std::vector<CookieChange> pending_cookie_changes_;
   bool use_cache_ = true;
+  net::BackendType cache_backend_;
+  int cache_max_size_;
+  int memory_cache_max_size_;
 
   base::WeakPtrFactory<RequestContextDelegate> weak_factory_;
 
@@ -43,6 +43,21 @@ bool AtomMenuModel::GetAcceleratorAtWithParams(
   return false;
 }
 
+AtomMenuModel::CommandState* AtomMenuModel::GetOrCreateCommandState(
+    int command_id) {
+  return &command_states_[command_id];
+}
+
+const AtomMenuModel::CommandState* AtomMenuModel::GetCommandState(
+    int command_id) const {
+  auto it = command_states_.find(command_id);
+  return it == command_states_.end() ? nullptr : &it->second;
+}
+
+void AtomMenuModel::ClearCommandStates() {
+  command_states_.clear();
+}
+
 void AtomMenuModel::MenuWillClose() {
   ui::SimpleMenuModel::MenuWillClose();
   for (Observer& observer : observers_) {
@@ -6,8 +6,10 @@
 #define ATOM_BROWSER_UI_ATOM_MENU_MODEL_H_
 
 #include <map>
+#include <unordered_map>
 
 #include "base/observer_list.h"
+#include "ui/base/accelerators/accelerator.h"
 #include "ui/base/models/simple_menu_model.h"
 
 namespace atom {
@@ -41,6 +43,18 @@ class AtomMenuModel : public ui::SimpleMenuModel {
     virtual void OnMenuWillClose() {}
   };
 
+  // The state of a command, pushed by the owner of the model so queries can be
+  // answered without asking the delegate.
+  struct CommandState {
+    bool checked = false;
+    bool enabled = true;
+    bool visible = true;
+    bool has_accelerator = false;
+    bool has_default_accelerator = false;
+    ui::Accelerator accelerator;
+    ui::Accelerator default_accelerator;
+  };
+
   explicit AtomMenuModel(Delegate* delegate);
   ~AtomMenuModel() override;
 
@@ -53,6 +67,12 @@ class AtomMenuModel : public ui::SimpleMenuModel {
                                   bool use_default_accelerator,
                                   ui::Accelerator* accelerator) const;
 
+  // Creates the state of |command_id| when it does not exist yet.
+  CommandState* GetOrCreateCommandState(int command_id);
+  // Returns nullptr when no state has been pushed for |command_id|.
+  const CommandState* GetCommandState(int command_id) const;
+  void ClearCommandStates();
+
   // ui::SimpleMenuModel:
   void MenuWillClose() override;
   void MenuWillShow() override;
@@ -64,6 +84,7 @@ class AtomMenuModel : public ui::SimpleMenuModel {
   Delegate* delegate_;  // weak ref.
 
   std::map<int, base::string16> roles_;  // command id -> role
+  std::unordered_map<int, CommandState> command_states_;
   base::ObserverList<Observer> observers_;
 
   DISALLOW_COPY_AND_ASSIGN(AtomMenuModel);
@@ -230,9 +230,18 @@ void WebContentsPreferences::AppendCommandLineSwitches(
                                   enable_node_integration ? "true" : "false");
 
   // Whether to enable node integration in Worker.
-  if (IsEnabled(options::kNodeIntegrationInWorker))
+  if (IsEnabled(options::kNodeIntegrationInWorker)) {
     command_line->AppendSwitch(switches::kNodeIntegrationInWorker);
 
+    // Number of node environments kept for reuse by new workers.
+    int worker_pool_size;
+    if (GetAsInteger(&preference_, options::kNodeWorkerPoolSize,
+                     &worker_pool_size) &&
+        worker_pool_size > 0)
+      command_line->AppendSwitchASCII(switches::kNodeWorkerPoolSize,
+                                      base::IntToString(worker_pool_size));
+  }
+
   // Check if webview tag creation is enabled, default to nodeIntegration value.
   // TODO(kevinsawicki): Default to false in 2.0
   bool webview_tag = IsEnabled(options::kWebviewTag, enable_node_integration);
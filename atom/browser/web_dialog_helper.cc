@@ -27,6 +27,11 @@
 
 namespace {
 
+void SetLastSelectedDirectory(const base::FilePath& directory,
+                              PrefService* pref_service) {
+  pref_service->SetFilePath(prefs::kSelectFileLastDirectory, directory);
+}
+
 class FileSelectHelper : public base::RefCounted<FileSelectHelper>,
                          public content::WebContentsObserver {
  public:
@@ -73,8 +78,8 @@ class FileSelectHelper : public base::RefCounted<FileSelectHelper>,
       if (render_frame_host_ && !paths.empty()) {
         auto* browser_context = static_cast<atom::AtomBrowserContext*>(
             render_frame_host_->GetProcess()->GetBrowserContext());
-        browser_context->prefs()->SetFilePath(prefs::kSelectFileLastDirectory,
-                                              paths[0].DirName());
+        browser_context->RunWhenPrefsLoaded(
+            base::BindOnce(&SetLastSelectedDirectory, paths[0].DirName()));
       }
     }
     OnFilesSelected(file_info);
@@ -25,6 +25,11 @@ IPC_STRUCT_TRAITS_BEGIN(atom::DraggableRegion)
   IPC_STRUCT_TRAITS_MEMBER(bounds)
 IPC_STRUCT_TRAITS_END()
 
+IPC_STRUCT_TRAITS_BEGIN(atom::DraggableRegionChange)
+  IPC_STRUCT_TRAITS_MEMBER(index)
+  IPC_STRUCT_TRAITS_MEMBER(region)
+IPC_STRUCT_TRAITS_END()
+
 IPC_MESSAGE_ROUTED2(AtomFrameHostMsg_Message,
                     std::string /* channel */,
                     base::ListValue /* arguments */)
@@ -58,9 +63,17 @@ IPC_MESSAGE_ROUTED0(AtomAutofillFrameHostMsg_HidePopup)
 IPC_MESSAGE_ROUTED1(AtomAutofillFrameMsg_AcceptSuggestion,
                     base::string16 /* suggestion */)
 
-// Sent by the renderer when the draggable regions are updated.
-IPC_MESSAGE_ROUTED1(AtomFrameHostMsg_UpdateDraggableRegions,
-                    std::vector<atom::DraggableRegion> /* regions */)
+// Sent by the renderer when the draggable regions are updated. The list is
+// resized to |size| and the |changes| are applied to the list of the previous
+// version, or to an empty list when |version| is 1.
+IPC_MESSAGE_ROUTED3(AtomFrameHostMsg_UpdateDraggableRegions,
+                    uint32_t /* version */,
+                    uint32_t /* size */,
+                    std::vector<atom::DraggableRegionChange> /* changes */)
+
+// Sent by the browser when it could not apply an update of the draggable
+// regions, asks the renderer to send the whole list again.
+IPC_MESSAGE_ROUTED0(AtomFrameMsg_ResendDraggableRegions)
 
 // Update renderer process preferences.
 IPC_MESSAGE_CONTROL1(AtomMsg_UpdatePreferences, base::ListValue)
@@ -78,6 +91,19 @@ IPC_MESSAGE_ROUTED2(AtomFrameHostMsg_PDFSaveURLAs,
                     GURL /* url */,
                     content::Referrer /* referrer */)
 
-IPC_MESSAGE_ROUTED2(AtomFrameMsg_TakeHeapSnapshot,
+IPC_MESSAGE_ROUTED4(AtomFrameMsg_TakeHeapSnapshot,
                     IPC::PlatformFileForTransit /* file_handle */,
+                    std::string /* channel */,
+                    bool /* compress */,
+                    bool /* report_progress */)
+
+IPC_MESSAGE_ROUTED2(AtomFrameMsg_StartCpuProfile,
+                    int /* sampling_interval_us */,
                     std::string /* channel */)
+
+IPC_MESSAGE_ROUTED1(AtomFrameMsg_StopCpuProfile, std::string /* channel */)
+
+// Empty when no profile was being recorded.
+IPC_MESSAGE_ROUTED2(AtomFrameHostMsg_CpuProfile,
+                    std::string /* channel */,
+                    std::string /* profile */)
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "atom/common/asar/archive.h"
+#include "atom/common/code_cache.h"
 #include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "native_mate/arguments.h"
@@ -126,9 +127,13 @@ void InitAsarSupport(v8::Isolate* isolate,
                      v8::Local<v8::Value> process,
                      v8::Local<v8::Value> require) {
   // Evaluate asar_init.js.
-  v8::Local<v8::Script> asar_init =
-      v8::Script::Compile(node::asar_init_value.ToStringChecked(isolate));
-  v8::Local<v8::Value> result = asar_init->Run();
+  v8::Local<v8::Value> result;
+  if (!atom::RunScriptWithCodeCache(
+           isolate->GetCurrentContext(),
+           node::asar_init_value.ToStringChecked(isolate),
+           mate::StringToV8(isolate, "electron/js2c/asar_init"))
+           .ToLocal(&result))
+    return;
 
   // Initialize asar support.
   if (result->IsFunction()) {
@@ -4,9 +4,17 @@
 
 #include "atom/common/api/atom_api_clipboard.h"
 
+#include <memory>
+#include <utility>
+
+#include "atom/common/api/atom_api_native_image.h"
+#include "atom/common/api/pending_promise.h"
 #include "atom/common/native_mate_converters/image_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
+#include "base/bind.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixmap.h"
@@ -18,6 +26,143 @@ namespace atom {
 
 namespace api {
 
+namespace {
+
+std::vector<base::string16> ReadAvailableFormats(ui::ClipboardType type) {
+  std::vector<base::string16> format_types;
+  bool ignore;
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadAvailableTypes(type, &format_types, &ignore);
+  return format_types;
+}
+
+base::string16 ReadPlainText(ui::ClipboardType type) {
+  base::string16 data;
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  if (clipboard->IsFormatAvailable(ui::Clipboard::GetPlainTextWFormatType(),
+                                   type)) {
+    clipboard->ReadText(type, &data);
+  } else if (clipboard->IsFormatAvailable(
+                 ui::Clipboard::GetPlainTextFormatType(), type)) {
+    std::string result;
+    clipboard->ReadAsciiText(type, &result);
+    data = base::ASCIIToUTF16(result);
+  }
+  return data;
+}
+
+base::string16 ReadRichText(ui::ClipboardType type) {
+  std::string data;
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadRTF(type, &data);
+  return base::UTF8ToUTF16(data);
+}
+
+base::string16 ReadMarkup(ui::ClipboardType type) {
+  base::string16 html;
+  std::string url;
+  uint32_t start;
+  uint32_t end;
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadHTML(type, &html, &url, &start, &end);
+  return html.substr(start, end - start);
+}
+
+// The ui::Clipboard belongs to the thread that created it, and on Windows and
+// X11 it must be the UI thread because it owns a window to talk to the system
+// clipboard, so there is no dedicated clipboard thread to read on. The
+// platform reads and writes of the promise-based methods are posted back to
+// the calling thread instead: they run after the current JavaScript task, but
+// they still block that thread while the clipboard owner answers. Only the
+// work that does not need the clipboard, like copying and converting bitmaps,
+// runs in the task scheduler.
+void PostClipboardTask(base::OnceClosure task) {
+  base::ThreadTaskRunnerHandle::Get()->PostTask(FROM_HERE, std::move(task));
+}
+
+template <typename T>
+void ResolveWithRead(std::unique_ptr<PendingPromise> promise,
+                     T (*read)(ui::ClipboardType),
+                     ui::ClipboardType type) {
+  T result = read(type);
+  PendingPromise::Scope scope(promise.get());
+  promise->Resolve(mate::ConvertToV8(promise->isolate(), result));
+}
+
+template <typename T>
+v8::Local<v8::Value> ReadAsync(mate::Arguments* args,
+                               T (*read)(ui::ClipboardType)) {
+  auto promise = std::make_unique<PendingPromise>(args->isolate());
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  PostClipboardTask(base::BindOnce(&ResolveWithRead<T>, std::move(promise),
+                                   read, Clipboard::GetClipboardType(args)));
+  return handle;
+}
+
+void FreeBufferData(char* data, void* hint) {
+  delete static_cast<std::string*>(hint);
+}
+
+void ResolveWithBuffer(std::unique_ptr<PendingPromise> promise,
+                       const std::string& format_string) {
+  // The data is handed over to the Buffer, so large formats are not copied
+  // again.
+  auto data = std::make_unique<std::string>();
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  clipboard->ReadData(ui::Clipboard::GetFormatType(format_string), data.get());
+
+  PendingPromise::Scope scope(promise.get());
+  v8::Isolate* isolate = promise->isolate();
+  if (data->empty()) {
+    promise->Resolve(node::Buffer::New(isolate, 0).ToLocalChecked());
+    return;
+  }
+  char* bytes = &(*data)[0];
+  size_t size = data->size();
+  promise->Resolve(node::Buffer::New(isolate, bytes, size, &FreeBufferData,
+                                     data.release())
+                       .ToLocalChecked());
+}
+
+void ResolveWithImage(std::unique_ptr<PendingPromise> promise,
+                      ui::ClipboardType type) {
+  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
+  SkBitmap bitmap = clipboard->ReadImage(type);
+
+  PendingPromise::Scope scope(promise.get());
+  promise->Resolve(
+      NativeImage::Create(promise->isolate(),
+                          gfx::Image::CreateFrom1xBitmap(bitmap))
+          .ToV8());
+}
+
+// Makes the N32 copy of |bitmap| the platform clipboards expect.
+SkBitmap CopyBitmap(const SkBitmap& bitmap) {
+  SkBitmap copy;
+  if (!copy.tryAllocPixels(bitmap.info()) ||
+      !bitmap.readPixels(copy.info(), copy.getPixels(), copy.rowBytes(), 0,
+                         0))
+    return SkBitmap();
+  return copy;
+}
+
+void WriteImageAndResolve(std::unique_ptr<PendingPromise> promise,
+                          ui::ClipboardType type,
+                          const SkBitmap& bitmap) {
+  if (!bitmap.drawsNothing()) {
+    ui::ScopedClipboardWriter writer(type);
+    writer.WriteImage(bitmap);
+  }
+
+  PendingPromise::Scope scope(promise.get());
+  if (bitmap.drawsNothing())
+    promise->RejectWithErrorMessage("Failed to copy the image");
+  else
+    promise->Resolve(v8::Undefined(promise->isolate()));
+}
+
+}  // namespace
+
 ui::ClipboardType Clipboard::GetClipboardType(mate::Arguments* args) {
   std::string type;
   if (args->GetNext(&type) && type == "selection")
@@ -27,11 +172,7 @@ ui::ClipboardType Clipboard::GetClipboardType(mate::Arguments* args) {
 }
 
 std::vector<base::string16> Clipboard::AvailableFormats(mate::Arguments* args) {
-  std::vector<base::string16> format_types;
-  bool ignore;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  clipboard->ReadAvailableTypes(GetClipboardType(args), &format_types, &ignore);
-  return format_types;
+  return ReadAvailableFormats(GetClipboardType(args));
 }
 
 bool Clipboard::Has(const std::string& format_string, mate::Arguments* args) {
@@ -94,19 +235,7 @@ void Clipboard::Write(const mate::Dictionary& data, mate::Arguments* args) {
 }
 
 base::string16 Clipboard::ReadText(mate::Arguments* args) {
-  base::string16 data;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  auto type = GetClipboardType(args);
-  if (clipboard->IsFormatAvailable(ui::Clipboard::GetPlainTextWFormatType(),
-                                   type)) {
-    clipboard->ReadText(type, &data);
-  } else if (clipboard->IsFormatAvailable(
-                 ui::Clipboard::GetPlainTextFormatType(), type)) {
-    std::string result;
-    clipboard->ReadAsciiText(type, &result);
-    data = base::ASCIIToUTF16(result);
-  }
-  return data;
+  return ReadPlainText(GetClipboardType(args));
 }
 
 void Clipboard::WriteText(const base::string16& text, mate::Arguments* args) {
@@ -115,10 +244,7 @@ void Clipboard::WriteText(const base::string16& text, mate::Arguments* args) {
 }
 
 base::string16 Clipboard::ReadRTF(mate::Arguments* args) {
-  std::string data;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  clipboard->ReadRTF(GetClipboardType(args), &data);
-  return base::UTF8ToUTF16(data);
+  return ReadRichText(GetClipboardType(args));
 }
 
 void Clipboard::WriteRTF(const std::string& text, mate::Arguments* args) {
@@ -127,15 +253,7 @@ void Clipboard::WriteRTF(const std::string& text, mate::Arguments* args) {
 }
 
 base::string16 Clipboard::ReadHTML(mate::Arguments* args) {
-  base::string16 data;
-  base::string16 html;
-  std::string url;
-  uint32_t start;
-  uint32_t end;
-  ui::Clipboard* clipboard = ui::Clipboard::GetForCurrentThread();
-  clipboard->ReadHTML(GetClipboardType(args), &html, &url, &start, &end);
-  data = html.substr(start, end - start);
-  return data;
+  return ReadMarkup(GetClipboardType(args));
 }
 
 void Clipboard::WriteHTML(const base::string16& html, mate::Arguments* args) {
@@ -169,13 +287,57 @@ gfx::Image Clipboard::ReadImage(mate::Arguments* args) {
 
 void Clipboard::WriteImage(const gfx::Image& image, mate::Arguments* args) {
   ui::ScopedClipboardWriter writer(GetClipboardType(args));
-  SkBitmap orig = image.AsBitmap();
-  SkBitmap bmp;
-
-  if (bmp.tryAllocPixels(orig.info()) &&
-      orig.readPixels(bmp.info(), bmp.getPixels(), bmp.rowBytes(), 0, 0)) {
+  SkBitmap bmp = CopyBitmap(image.AsBitmap());
+  if (!bmp.drawsNothing())
     writer.WriteImage(bmp);
-  }
+}
+
+v8::Local<v8::Value> Clipboard::AvailableFormatsAsync(mate::Arguments* args) {
+  return ReadAsync(args, &ReadAvailableFormats);
+}
+
+v8::Local<v8::Value> Clipboard::ReadTextAsync(mate::Arguments* args) {
+  return ReadAsync(args, &ReadPlainText);
+}
+
+v8::Local<v8::Value> Clipboard::ReadRTFAsync(mate::Arguments* args) {
+  return ReadAsync(args, &ReadRichText);
+}
+
+v8::Local<v8::Value> Clipboard::ReadHTMLAsync(mate::Arguments* args) {
+  return ReadAsync(args, &ReadMarkup);
+}
+
+v8::Local<v8::Value> Clipboard::ReadBufferAsync(
+    const std::string& format_string,
+    mate::Arguments* args) {
+  auto promise = std::make_unique<PendingPromise>(args->isolate());
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  PostClipboardTask(
+      base::BindOnce(&ResolveWithBuffer, std::move(promise), format_string));
+  return handle;
+}
+
+v8::Local<v8::Value> Clipboard::ReadImageAsync(mate::Arguments* args) {
+  auto promise = std::make_unique<PendingPromise>(args->isolate());
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  PostClipboardTask(base::BindOnce(&ResolveWithImage, std::move(promise),
+                                   GetClipboardType(args)));
+  return handle;
+}
+
+v8::Local<v8::Value> Clipboard::WriteImageAsync(const gfx::Image& image,
+                                                mate::Arguments* args) {
+  auto promise = std::make_unique<PendingPromise>(args->isolate());
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE,
+      {base::TaskPriority::USER_BLOCKING,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN},
+      base::BindOnce(&CopyBitmap, image.AsBitmap()),
+      base::BindOnce(&WriteImageAndResolve, std::move(promise),
+                     GetClipboardType(args)));
+  return handle;
 }
 
 #if !defined(OS_MACOSX)
@@ -219,6 +381,14 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("readBuffer", &atom::api::Clipboard::ReadBuffer);
   dict.SetMethod("writeBuffer", &atom::api::Clipboard::WriteBuffer);
   dict.SetMethod("clear", &atom::api::Clipboard::Clear);
+  dict.SetMethod("availableFormatsAsync",
+                 &atom::api::Clipboard::AvailableFormatsAsync);
+  dict.SetMethod("readTextAsync", &atom::api::Clipboard::ReadTextAsync);
+  dict.SetMethod("readRTFAsync", &atom::api::Clipboard::ReadRTFAsync);
+  dict.SetMethod("readHTMLAsync", &atom::api::Clipboard::ReadHTMLAsync);
+  dict.SetMethod("readBufferAsync", &atom::api::Clipboard::ReadBufferAsync);
+  dict.SetMethod("readImageAsync", &atom::api::Clipboard::ReadImageAsync);
+  dict.SetMethod("_writeImageAsync", &atom::api::Clipboard::WriteImageAsync);
 }
 
 }  // namespace
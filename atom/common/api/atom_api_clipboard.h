@@ -53,6 +53,17 @@ class Clipboard {
                           const v8::Local<v8::Value> buffer,
                           mate::Arguments* args);
 
+  // Promise-based versions of the methods above.
+  static v8::Local<v8::Value> AvailableFormatsAsync(mate::Arguments* args);
+  static v8::Local<v8::Value> ReadTextAsync(mate::Arguments* args);
+  static v8::Local<v8::Value> ReadRTFAsync(mate::Arguments* args);
+  static v8::Local<v8::Value> ReadHTMLAsync(mate::Arguments* args);
+  static v8::Local<v8::Value> ReadBufferAsync(const std::string& format_string,
+                                              mate::Arguments* args);
+  static v8::Local<v8::Value> ReadImageAsync(mate::Arguments* args);
+  static v8::Local<v8::Value> WriteImageAsync(const gfx::Image& image,
+                                              mate::Arguments* args);
+
  private:
   DISALLOW_COPY_AND_ASSIGN(Clipboard);
 };
@@ -9,20 +9,26 @@
 #include <utility>
 #include <vector>
 
+#include "atom/common/api/pending_promise.h"
 #include "atom/common/asar/asar_util.h"
+#include "atom/common/image_file_cache.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/gfx_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
+#include "base/base64.h"
 #include "base/files/file_util.h"
+#include "base/memory/ref_counted.h"
 #include "base/strings/pattern.h"
 #include "base/strings/string_util.h"
-#include "base/threading/thread_restrictions.h"
+#include "base/task_scheduler/post_task.h"
 #include "native_mate/object_template_builder.h"
 #include "net/base/data_url.h"
 #include "third_party/skia/include/core/SkBitmap.h"
 #include "third_party/skia/include/core/SkImageInfo.h"
 #include "third_party/skia/include/core/SkPixelRef.h"
+#include "third_party/skia/include/core/SkStream.h"
+#include "third_party/skia/include/encode/SkPngEncoder.h"
 #include "ui/base/layout.h"
 #include "ui/base/webui/web_ui_util.h"
 #include "ui/gfx/codec/jpeg_codec.h"
@@ -81,12 +87,8 @@ float GetScaleFactorFromOptions(mate::Arguments* args) {
   return scale_factor;
 }
 
-bool AddImageSkiaRep(gfx::ImageSkia* image,
-                     const unsigned char* data,
-                     size_t size,
-                     int width,
-                     int height,
-                     double scale_factor) {
+// Decodes PNG or JPEG encoded |data|, returns nullptr on failure.
+std::unique_ptr<SkBitmap> DecodeImage(const unsigned char* data, size_t size) {
   auto decoded = std::make_unique<SkBitmap>();
 
   // Try PNG first.
@@ -104,7 +106,16 @@ bool AddImageSkiaRep(gfx::ImageSkia* image,
       decoded->setAlphaType(SkAlphaType::kOpaque_SkAlphaType);
     }
   }
+  return decoded;
+}
 
+bool AddImageSkiaRep(gfx::ImageSkia* image,
+                     const unsigned char* data,
+                     size_t size,
+                     int width,
+                     int height,
+                     double scale_factor) {
+  std::unique_ptr<SkBitmap> decoded = DecodeImage(data, size);
   if (!decoded) {
     // Try Bitmap
     if (width > 0 && height > 0) {
@@ -124,17 +135,12 @@ bool AddImageSkiaRep(gfx::ImageSkia* image,
 bool AddImageSkiaRep(gfx::ImageSkia* image,
                      const base::FilePath& path,
                      double scale_factor) {
-  std::string file_contents;
-  {
-    base::ThreadRestrictions::ScopedAllowIO allow_io;
-    if (!asar::ReadFileToString(path, &file_contents))
-      return false;
-  }
+  SkBitmap bitmap;
+  if (!ReadImageFile(path, &DecodeImage, &bitmap))
+    return false;
 
-  const unsigned char* data =
-      reinterpret_cast<const unsigned char*>(file_contents.data());
-  size_t size = file_contents.size();
-  return AddImageSkiaRep(image, data, size, 0, 0, scale_factor);
+  image->AddRepresentation(gfx::ImageSkiaRep(bitmap, scale_factor));
+  return true;
 }
 
 bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
@@ -144,12 +150,20 @@ bool PopulateImageSkiaRepsFromPath(gfx::ImageSkia* image,
   if (base::MatchPattern(filename, "*@*x"))
     // Don't search for other representations if the DPI has been specified.
     return AddImageSkiaRep(image, path, GetScaleFactorFromPath(path));
-  else
-    succeed |= AddImageSkiaRep(image, path, 1.0f);
 
-  for (const ScaleFactorPair& pair : kScaleFactorPairs)
-    succeed |= AddImageSkiaRep(
-        image, path.InsertBeforeExtensionASCII(pair.name), pair.scale);
+  // The requested file is always read, a listing that is out of date must
+  // not make it fail to load.
+  succeed |= AddImageSkiaRep(image, path, 1.0f);
+
+  // Look for the variants in the listing of the directory instead of trying
+  // to read each of them.
+  ImageDirectoryListing listing(path.DirName());
+
+  for (const ScaleFactorPair& pair : kScaleFactorPairs) {
+    base::FilePath variant = path.InsertBeforeExtensionASCII(pair.name);
+    if (listing.MayContain(variant))
+      succeed |= AddImageSkiaRep(image, variant, pair.scale);
+  }
   return succeed;
 }
 
@@ -206,6 +220,185 @@ bool ReadImageSkiaFromICO(gfx::ImageSkia* image, HICON icon) {
 
 void Noop(char*, void*) {}
 
+// The default zlib compression level used by gfx::PNGCodec.
+const int kDefaultPNGCompressionLevel = 6;
+
+using EncodedData = std::vector<unsigned char>;
+
+// Reads the target size and the resize method from the options of resize().
+void ReadResizeOptions(const gfx::Size& image_size,
+                       const base::DictionaryValue& options,
+                       gfx::Size* size,
+                       skia::ImageOperations::ResizeMethod* method) {
+  int width = image_size.width();
+  int height = image_size.height();
+  bool width_set = options.GetInteger("width", &width);
+  bool height_set = options.GetInteger("height", &height);
+  size->SetSize(width, height);
+
+  float aspect_ratio = 1.f;
+  if (!image_size.IsEmpty())
+    aspect_ratio = static_cast<float>(image_size.width()) /
+                   static_cast<float>(image_size.height());
+  if (width_set && !height_set) {
+    // Scale height to preserve original aspect ratio
+    size->set_height(width);
+    *size = gfx::ScaleToRoundedSize(*size, 1.f, 1.f / aspect_ratio);
+  } else if (height_set && !width_set) {
+    // Scale width to preserve original aspect ratio
+    size->set_width(height);
+    *size = gfx::ScaleToRoundedSize(*size, aspect_ratio, 1.f);
+  }
+
+  *method = skia::ImageOperations::ResizeMethod::RESIZE_BEST;
+  std::string quality;
+  options.GetString("quality", &quality);
+  if (quality == "good")
+    *method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
+  else if (quality == "better")
+    *method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+}
+
+// The functions below run in the task scheduler, they only use copies of the
+// representations of the image, so the image can still be used meanwhile.
+
+EncodedData EncodePNG(const SkBitmap& bitmap, int compression_level) {
+  SkPixmap pixmap;
+  if (!bitmap.peekPixels(&pixmap))
+    return EncodedData();
+  SkPngEncoder::Options options;
+  options.fZLibLevel = compression_level;
+  SkDynamicMemoryWStream stream;
+  if (!SkPngEncoder::Encode(&stream, pixmap, options))
+    return EncodedData();
+  EncodedData encoded(stream.bytesWritten());
+  stream.copyTo(encoded.data());
+  return encoded;
+}
+
+EncodedData EncodeJPEG(const SkBitmap& bitmap, int quality) {
+  EncodedData encoded;
+  if (!gfx::JPEGCodec::Encode(bitmap, quality, &encoded))
+    encoded.clear();
+  return encoded;
+}
+
+std::string EncodeDataURL(const SkBitmap& bitmap) {
+  EncodedData png = EncodePNG(bitmap, kDefaultPNGCompressionLevel);
+  std::string base64;
+  base::Base64Encode(
+      base::StringPiece(reinterpret_cast<const char*>(png.data()), png.size()),
+      &base64);
+  return "data:image/png;base64," + base64;
+}
+
+gfx::ImageSkiaRep DecodeImageSkiaRep(const std::string& data,
+                                     int width,
+                                     int height,
+                                     double scale_factor) {
+  const auto* bytes = reinterpret_cast<const unsigned char*>(data.data());
+  std::unique_ptr<SkBitmap> decoded = DecodeImage(bytes, data.size());
+  if (!decoded && width > 0 && height > 0) {
+    // Copy the raw pixels, unlike createFromBuffer the data does not outlive
+    // this task.
+    decoded = std::make_unique<SkBitmap>();
+    if (decoded->tryAllocN32Pixels(width, height, false) &&
+        data.size() >= decoded->computeByteSize())
+      memcpy(decoded->getPixels(), bytes, decoded->computeByteSize());
+    else
+      decoded.reset();
+  }
+  if (!decoded)
+    return gfx::ImageSkiaRep();
+  return gfx::ImageSkiaRep(*decoded, scale_factor);
+}
+
+std::vector<gfx::ImageSkiaRep> ResizeImageSkiaReps(
+    const std::vector<gfx::ImageSkiaRep>& reps,
+    skia::ImageOperations::ResizeMethod method,
+    const gfx::Size& size) {
+  gfx::ImageSkia image;
+  for (const auto& rep : reps)
+    image.AddRepresentation(rep);
+  gfx::ImageSkia resized =
+      gfx::ImageSkiaOperations::CreateResizedImage(image, method, size);
+  // Generate the resized representations here instead of lazily when used.
+  std::vector<gfx::ImageSkiaRep> resized_reps;
+  for (const auto& rep : reps)
+    resized_reps.push_back(resized.GetRepresentation(rep.scale()));
+  return resized_reps;
+}
+
+gfx::Image CreateImageFromReps(const std::vector<gfx::ImageSkiaRep>& reps) {
+  gfx::ImageSkia image_skia;
+  for (const auto& rep : reps) {
+    if (!rep.is_null())
+      image_skia.AddRepresentation(rep);
+  }
+  return gfx::Image(image_skia);
+}
+
+base::TaskTraits GetImageTaskTraits() {
+  return {base::TaskPriority::USER_VISIBLE,
+          base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+}
+
+void ResolveWithBuffer(std::unique_ptr<PendingPromise> promise,
+                       const EncodedData& data) {
+  PendingPromise::Scope scope(promise.get());
+  promise->Resolve(
+      node::Buffer::Copy(promise->isolate(),
+                         reinterpret_cast<const char*>(data.data()),
+                         data.size())
+          .ToLocalChecked());
+}
+
+void ResolveWithString(std::unique_ptr<PendingPromise> promise,
+                       const std::string& data) {
+  PendingPromise::Scope scope(promise.get());
+  promise->Resolve(mate::StringToV8(promise->isolate(), data));
+}
+
+void ResolveWithImage(std::unique_ptr<PendingPromise> promise,
+                      const std::vector<gfx::ImageSkiaRep>& reps) {
+  PendingPromise::Scope scope(promise.get());
+  promise->Resolve(
+      NativeImage::Create(promise->isolate(), CreateImageFromReps(reps))
+          .ToV8());
+}
+
+// Collects the results of resizeImages().
+class BatchResize : public base::RefCounted<BatchResize> {
+ public:
+  BatchResize(std::unique_ptr<PendingPromise> promise, size_t count)
+      : promise_(std::move(promise)), results_(count), pending_(count) {}
+
+  void OnImageResized(size_t index,
+                      const std::vector<gfx::ImageSkiaRep>& reps) {
+    results_[index] = reps;
+    if (--pending_ > 0)
+      return;
+
+    PendingPromise::Scope scope(promise_.get());
+    v8::Isolate* isolate = promise_->isolate();
+    std::vector<v8::Local<v8::Value>> images;
+    for (const auto& result : results_)
+      images.push_back(
+          NativeImage::Create(isolate, CreateImageFromReps(result)).ToV8());
+    promise_->Resolve(mate::ConvertToV8(isolate, images));
+  }
+
+ private:
+  friend class base::RefCounted<BatchResize>;
+  ~BatchResize() {}
+
+  std::unique_ptr<PendingPromise> promise_;
+  std::vector<std::vector<gfx::ImageSkiaRep>> results_;
+  size_t pending_;
+
+  DISALLOW_COPY_AND_ASSIGN(BatchResize);
+};
+
 }  // namespace
 
 NativeImage::NativeImage(v8::Isolate* isolate, const gfx::Image& image)
@@ -328,6 +521,13 @@ v8::Local<v8::Value> NativeImage::GetBitmap(mate::Arguments* args) {
   SkPixelRef* ref = bitmap.pixelRef();
   if (!ref)
     return node::Buffer::New(args->isolate(), 0).ToLocalChecked();
+  // Images loaded from the same file share their immutable pixels, which
+  // must not be handed out for writing.
+  if (bitmap.isImmutable())
+    return node::Buffer::Copy(args->isolate(),
+                              reinterpret_cast<const char*>(ref->pixels()),
+                              bitmap.computeByteSize())
+        .ToLocalChecked();
   return node::Buffer::New(args->isolate(),
                            reinterpret_cast<char*>(ref->pixels()),
                            bitmap.computeByteSize(), &Noop, nullptr)
@@ -369,31 +569,9 @@ float NativeImage::GetAspectRatio() {
 mate::Handle<NativeImage> NativeImage::Resize(
     v8::Isolate* isolate,
     const base::DictionaryValue& options) {
-  gfx::Size size = GetSize();
-  int width = size.width();
-  int height = size.height();
-  bool width_set = options.GetInteger("width", &width);
-  bool height_set = options.GetInteger("height", &height);
-  size.SetSize(width, height);
-
-  if (width_set && !height_set) {
-    // Scale height to preserve original aspect ratio
-    size.set_height(width);
-    size = gfx::ScaleToRoundedSize(size, 1.f, 1.f / GetAspectRatio());
-  } else if (height_set && !width_set) {
-    // Scale width to preserve original aspect ratio
-    size.set_width(height);
-    size = gfx::ScaleToRoundedSize(size, GetAspectRatio(), 1.f);
-  }
-
-  skia::ImageOperations::ResizeMethod method =
-      skia::ImageOperations::ResizeMethod::RESIZE_BEST;
-  std::string quality;
-  options.GetString("quality", &quality);
-  if (quality == "good")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_GOOD;
-  else if (quality == "better")
-    method = skia::ImageOperations::ResizeMethod::RESIZE_BETTER;
+  gfx::Size size;
+  skia::ImageOperations::ResizeMethod method;
+  ReadResizeOptions(GetSize(), options, &size, &method);
 
   gfx::ImageSkia resized = gfx::ImageSkiaOperations::CreateResizedImage(
       image_.AsImageSkia(), method, size);
@@ -401,6 +579,96 @@ mate::Handle<NativeImage> NativeImage::Resize(
                             new NativeImage(isolate, gfx::Image(resized)));
 }
 
+v8::Local<v8::Value> NativeImage::ToPNGAsync(mate::Arguments* args) {
+  float scale_factor = 1.0f;
+  int compression_level = -1;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("scaleFactor", &scale_factor);
+    options.Get("compressionLevel", &compression_level);
+  }
+  if (compression_level > 9) {
+    args->ThrowError("compressionLevel must be between 0 and 9");
+    return v8::Undefined(args->isolate());
+  }
+
+  auto promise = std::make_unique<PendingPromise>(args->isolate());
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  if (scale_factor == 1.0f && compression_level < 0 &&
+      image_.HasRepresentation(gfx::Image::kImageRepPNG)) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    promise->Resolve(
+        node::Buffer::Copy(args->isolate(),
+                           reinterpret_cast<const char*>(png->front()),
+                           png->size())
+            .ToLocalChecked());
+    return handle;
+  }
+
+  if (compression_level < 0)
+    compression_level = kDefaultPNGCompressionLevel;
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(&EncodePNG, bitmap, compression_level),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Value> NativeImage::ToJPEGAsync(v8::Isolate* isolate,
+                                              int quality) {
+  auto promise = std::make_unique<PendingPromise>(isolate);
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(1.0f).sk_bitmap();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(&EncodeJPEG, bitmap, quality),
+      base::BindOnce(&ResolveWithBuffer, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Value> NativeImage::ToDataURLAsync(mate::Arguments* args) {
+  float scale_factor = GetScaleFactorFromOptions(args);
+
+  auto promise = std::make_unique<PendingPromise>(args->isolate());
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  if (scale_factor == 1.0f &&
+      image_.HasRepresentation(gfx::Image::kImageRepPNG)) {
+    // Use raw 1x PNG bytes when available
+    scoped_refptr<base::RefCountedMemory> png = image_.As1xPNGBytes();
+    promise->Resolve(mate::StringToV8(
+        args->isolate(), webui::GetPngDataUrl(png->front(), png->size())));
+    return handle;
+  }
+
+  const SkBitmap bitmap =
+      image_.AsImageSkia().GetRepresentation(scale_factor).sk_bitmap();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(), base::BindOnce(&EncodeDataURL, bitmap),
+      base::BindOnce(&ResolveWithString, std::move(promise)));
+  return handle;
+}
+
+v8::Local<v8::Value> NativeImage::ResizeAsync(
+    v8::Isolate* isolate,
+    const base::DictionaryValue& options) {
+  gfx::Size size;
+  skia::ImageOperations::ResizeMethod method;
+  ReadResizeOptions(GetSize(), options, &size, &method);
+
+  auto promise = std::make_unique<PendingPromise>(isolate);
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(&ResizeImageSkiaReps, image_.AsImageSkia().image_reps(),
+                     method, size),
+      base::BindOnce(&ResolveWithImage, std::move(promise)));
+  return handle;
+}
+
 mate::Handle<NativeImage> NativeImage::Crop(v8::Isolate* isolate,
                                             const gfx::Rect& rect) {
   gfx::ImageSkia cropped =
@@ -527,6 +795,66 @@ mate::Handle<NativeImage> NativeImage::CreateFromBuffer(
   return Create(args->isolate(), gfx::Image(image_skia));
 }
 
+// static
+v8::Local<v8::Value> NativeImage::CreateFromBufferAsync(
+    mate::Arguments* args,
+    v8::Local<v8::Value> buffer) {
+  int width = 0;
+  int height = 0;
+  double scale_factor = 1.;
+
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("width", &width);
+    options.Get("height", &height);
+    options.Get("scaleFactor", &scale_factor);
+  }
+
+  auto promise = std::make_unique<PendingPromise>(args->isolate());
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  // Copy the data, the buffer may be changed while decoding.
+  std::string data(node::Buffer::Data(buffer), node::Buffer::Length(buffer));
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, GetImageTaskTraits(),
+      base::BindOnce(
+          [](const std::string& data, int width, int height, double scale) {
+            return std::vector<gfx::ImageSkiaRep>{
+                DecodeImageSkiaRep(data, width, height, scale)};
+          },
+          std::move(data), width, height, scale_factor),
+      base::BindOnce(&ResolveWithImage, std::move(promise)));
+  return handle;
+}
+
+// static
+v8::Local<v8::Value> NativeImage::ResizeImages(
+    v8::Isolate* isolate,
+    const std::vector<mate::Handle<NativeImage>>& images,
+    const base::DictionaryValue& options) {
+  auto promise = std::make_unique<PendingPromise>(isolate);
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  if (images.empty()) {
+    promise->Resolve(v8::Array::New(isolate));
+    return handle;
+  }
+
+  // Every image is resized in its own task so they run in parallel.
+  scoped_refptr<BatchResize> batch =
+      new BatchResize(std::move(promise), images.size());
+  for (size_t i = 0; i < images.size(); ++i) {
+    gfx::Size size;
+    skia::ImageOperations::ResizeMethod method;
+    ReadResizeOptions(images[i]->GetSize(), options, &size, &method);
+    base::PostTaskWithTraitsAndReplyWithResult(
+        FROM_HERE, GetImageTaskTraits(),
+        base::BindOnce(&ResizeImageSkiaReps,
+                       images[i]->image().AsImageSkia().image_reps(), method,
+                       size),
+        base::BindOnce(&BatchResize::OnImageResized, batch, i));
+  }
+  return handle;
+}
+
 // static
 mate::Handle<NativeImage> NativeImage::CreateFromDataURL(v8::Isolate* isolate,
                                                          const GURL& url) {
@@ -555,16 +883,20 @@ void NativeImage::BuildPrototype(v8::Isolate* isolate,
   prototype->SetClassName(mate::StringToV8(isolate, "NativeImage"));
   mate::ObjectTemplateBuilder(isolate, prototype->PrototypeTemplate())
       .SetMethod("toPNG", &NativeImage::ToPNG)
+      .SetMethod("toPNGAsync", &NativeImage::ToPNGAsync)
       .SetMethod("toJPEG", &NativeImage::ToJPEG)
+      .SetMethod("toJPEGAsync", &NativeImage::ToJPEGAsync)
       .SetMethod("toBitmap", &NativeImage::ToBitmap)
       .SetMethod("getBitmap", &NativeImage::GetBitmap)
       .SetMethod("getNativeHandle", &NativeImage::GetNativeHandle)
       .SetMethod("toDataURL", &NativeImage::ToDataURL)
+      .SetMethod("toDataURLAsync", &NativeImage::ToDataURLAsync)
       .SetMethod("isEmpty", &NativeImage::IsEmpty)
       .SetMethod("getSize", &NativeImage::GetSize)
       .SetMethod("setTemplateImage", &NativeImage::SetTemplateImage)
       .SetMethod("isTemplateImage", &NativeImage::IsTemplateImage)
       .SetMethod("resize", &NativeImage::Resize)
+      .SetMethod("resizeAsync", &NativeImage::ResizeAsync)
       .SetMethod("crop", &NativeImage::Crop)
       .SetMethod("getAspectRatio", &NativeImage::GetAspectRatio)
       .SetMethod("addRepresentation", &NativeImage::AddRepresentation);
@@ -615,10 +947,13 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("createEmpty", &atom::api::NativeImage::CreateEmpty);
   dict.SetMethod("createFromPath", &atom::api::NativeImage::CreateFromPath);
   dict.SetMethod("createFromBuffer", &atom::api::NativeImage::CreateFromBuffer);
+  dict.SetMethod("createFromBufferAsync",
+                 &atom::api::NativeImage::CreateFromBufferAsync);
   dict.SetMethod("createFromDataURL",
                  &atom::api::NativeImage::CreateFromDataURL);
   dict.SetMethod("createFromNamedImage",
                  &atom::api::NativeImage::CreateFromNamedImage);
+  dict.SetMethod("resizeImages", &atom::api::NativeImage::ResizeImages);
 }
 
 }  // namespace
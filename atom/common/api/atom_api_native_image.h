@@ -7,6 +7,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 #include "base/values.h"
 #include "native_mate/dictionary.h"
@@ -54,12 +55,21 @@ class NativeImage : public mate::Wrappable<NativeImage> {
   static mate::Handle<NativeImage> CreateFromBuffer(
       mate::Arguments* args,
       v8::Local<v8::Value> buffer);
+  static v8::Local<v8::Value> CreateFromBufferAsync(
+      mate::Arguments* args,
+      v8::Local<v8::Value> buffer);
   static mate::Handle<NativeImage> CreateFromDataURL(v8::Isolate* isolate,
                                                      const GURL& url);
   static mate::Handle<NativeImage> CreateFromNamedImage(
       mate::Arguments* args,
       const std::string& name);
 
+  // Resizes the |images| in the task scheduler, returns a promise.
+  static v8::Local<v8::Value> ResizeImages(
+      v8::Isolate* isolate,
+      const std::vector<mate::Handle<NativeImage>>& images,
+      const base::DictionaryValue& options);
+
   static void BuildPrototype(v8::Isolate* isolate,
                              v8::Local<v8::FunctionTemplate> prototype);
 
@@ -87,6 +97,14 @@ class NativeImage : public mate::Wrappable<NativeImage> {
                                    const base::DictionaryValue& options);
   mate::Handle<NativeImage> Crop(v8::Isolate* isolate, const gfx::Rect& rect);
   std::string ToDataURL(mate::Arguments* args);
+
+  // Like the methods above, but do the work in the task scheduler and return
+  // a promise.
+  v8::Local<v8::Value> ToPNGAsync(mate::Arguments* args);
+  v8::Local<v8::Value> ToJPEGAsync(v8::Isolate* isolate, int quality);
+  v8::Local<v8::Value> ToDataURLAsync(mate::Arguments* args);
+  v8::Local<v8::Value> ResizeAsync(v8::Isolate* isolate,
+                                   const base::DictionaryValue& options);
   bool IsEmpty();
   gfx::Size GetSize();
   float GetAspectRatio();
@@ -8,6 +8,7 @@
 #include "atom/common/api/atom_api_key_weak_map.h"
 #include "atom/common/api/remote_callback_freer.h"
 #include "atom/common/api/remote_object_freer.h"
+#include "atom/common/code_cache.h"
 #include "atom/common/native_mate_converters/content_converter.h"
 #include "atom/common/native_mate_converters/gurl_converter.h"
 #include "atom/common/node_includes.h"
@@ -103,6 +104,19 @@ bool IsSameOrigin(const GURL& l, const GURL& r) {
   return url::Origin::Create(l).IsSameOriginWith(url::Origin::Create(r));
 }
 
+v8::Local<v8::Value> RunScriptWithCodeCache(v8::Isolate* isolate,
+                                            v8::Local<v8::String> source,
+                                            v8::Local<v8::String> filename,
+                                            const std::string& stamp) {
+  v8::Local<v8::Value> result;
+  // Exceptions thrown by the script propagate to the caller.
+  if (!atom::RunScriptWithCodeCache(isolate->GetCurrentContext(), source,
+                                    filename, stamp)
+           .ToLocal(&result))
+    return v8::Undefined(isolate);
+  return result;
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -122,6 +136,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("requestGarbageCollectionForTesting",
                  &RequestGarbageCollectionForTesting);
   dict.SetMethod("isSameOrigin", &IsSameOrigin);
+  dict.SetMethod("runScriptWithCodeCache", &RunScriptWithCodeCache);
 }
 
 }  // namespace
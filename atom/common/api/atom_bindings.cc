@@ -6,21 +6,30 @@
 
 #include <algorithm>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include "atom/common/api/locker.h"
+#include "atom/common/api/pending_promise.h"
 #include "atom/common/atom_version.h"
 #include "atom/common/chrome_version.h"
+#include "atom/common/code_cache.h"
+#include "atom/common/cpu_profile.h"
 #include "atom/common/heap_snapshot.h"
+#include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/node_includes.h"
+#include "atom/common/startup_timeline.h"
 #include "base/logging.h"
 #include "base/process/process_info.h"
 #include "base/process/process_metrics_iocounters.h"
 #include "base/sys_info.h"
 #include "base/threading/thread_restrictions.h"
 #include "native_mate/dictionary.h"
+#include "v8/include/v8-profiler.h"
 
 namespace atom {
 
@@ -38,6 +47,44 @@ void FatalErrorCallback(const char* location, const char* message) {
   AtomBindings::Crash();
 }
 
+// Converts a node of the sampling heap profile to the format of the
+// ".heapprofile" files used by DevTools.
+v8::Local<v8::Value> AllocationNodeToV8(v8::Isolate* isolate,
+                                        v8::AllocationProfile::Node* node) {
+  mate::Dictionary call_frame = mate::Dictionary::CreateEmpty(isolate);
+  call_frame.Set("functionName", node->name);
+  call_frame.Set("scriptId", std::to_string(node->script_id));
+  call_frame.Set("url", node->script_name);
+  // DevTools expects zero based positions.
+  call_frame.Set("lineNumber", node->line_number - 1);
+  call_frame.Set("columnNumber", node->column_number - 1);
+
+  double self_size = 0;
+  for (const auto& allocation : node->allocations)
+    self_size += static_cast<double>(allocation.size) * allocation.count;
+
+  std::vector<v8::Local<v8::Value>> children;
+  children.reserve(node->children.size());
+  for (auto* child : node->children)
+    children.push_back(AllocationNodeToV8(isolate, child));
+
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("callFrame", call_frame);
+  dict.Set("selfSize", self_size);
+  dict.Set("id", node->node_id);
+  dict.Set("children", children);
+  return dict.GetHandle();
+}
+
+void OnCpuProfileWritten(std::unique_ptr<atom::PendingPromise> promise,
+                         bool success) {
+  atom::PendingPromise::Scope scope(promise.get());
+  if (success)
+    promise->Resolve(v8::Undefined(promise->isolate()));
+  else
+    promise->RejectWithErrorMessage("Failed to save the CPU profile");
+}
+
 }  // namespace
 
 AtomBindings::AtomBindings(uv_loop_t* loop) {
@@ -63,7 +110,13 @@ void AtomBindings::BindTo(v8::Isolate* isolate, v8::Local<v8::Object> process) {
   dict.SetMethod("getCPUUsage", base::Bind(&AtomBindings::GetCPUUsage,
                                            base::Unretained(metrics_.get())));
   dict.SetMethod("getIOCounters", &GetIOCounters);
+  dict.SetMethod("getCodeCacheStatistics", &GetCodeCacheStatistics);
+  dict.SetMethod("getStartupTimeline", &GetStartupTimeline);
   dict.SetMethod("takeHeapSnapshot", &TakeHeapSnapshot);
+  dict.SetMethod("startSamplingHeapProfiler", &StartSamplingHeapProfiler);
+  dict.SetMethod("stopSamplingHeapProfiler", &StopSamplingHeapProfiler);
+  dict.SetMethod("startCpuProfile", &StartCpuProfile);
+  dict.SetMethod("stopCpuProfile", &StopCpuProfile);
 #if defined(OS_POSIX)
   dict.SetMethod("setFdLimit", &base::SetFdLimit);
 #endif
@@ -242,6 +295,32 @@ v8::Local<v8::Value> AtomBindings::GetIOCounters(v8::Isolate* isolate) {
   return dict.GetHandle();
 }
 
+// static
+v8::Local<v8::Value> AtomBindings::GetCodeCacheStatistics(
+    v8::Isolate* isolate) {
+  CodeCacheStatistics statistics = atom::GetCodeCacheStatistics();
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("produced", statistics.produced);
+  dict.Set("accepted", statistics.accepted);
+  dict.Set("rejected", statistics.rejected);
+  return dict.GetHandle();
+}
+
+// static
+v8::Local<v8::Value> AtomBindings::GetStartupTimeline(v8::Isolate* isolate) {
+  std::vector<StartupPhase> phases = atom::GetStartupTimeline();
+  v8::Local<v8::Array> timeline = v8::Array::New(isolate, phases.size());
+  for (size_t i = 0; i < phases.size(); ++i) {
+    mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+    dict.Set("name", phases[i].name);
+    // Milliseconds of the monotonic clock, comparable between processes.
+    dict.Set("start", (phases[i].start - base::TimeTicks()).InMillisecondsF());
+    dict.Set("end", (phases[i].end - base::TimeTicks()).InMillisecondsF());
+    timeline->Set(static_cast<uint32_t>(i), dict.GetHandle());
+  }
+  return timeline;
+}
+
 // static
 bool AtomBindings::TakeHeapSnapshot(v8::Isolate* isolate,
                                     const base::FilePath& file_path) {
@@ -253,4 +332,68 @@ bool AtomBindings::TakeHeapSnapshot(v8::Isolate* isolate,
   return atom::TakeHeapSnapshot(isolate, &file);
 }
 
+// static
+bool AtomBindings::StartSamplingHeapProfiler(v8::Isolate* isolate,
+                                             mate::Arguments* args) {
+  // Defaults of V8, one sample every 512KB with stacks of 16 frames.
+  int sampling_interval = 512 * 1024;
+  int stack_depth = 16;
+  mate::Dictionary options;
+  if (args->GetNext(&options)) {
+    options.Get("samplingInterval", &sampling_interval);
+    options.Get("stackDepth", &stack_depth);
+  }
+  if (sampling_interval <= 0 || stack_depth <= 0) {
+    args->ThrowError("Invalid sampling options");
+    return false;
+  }
+
+  return isolate->GetHeapProfiler()->StartSamplingHeapProfiler(
+      static_cast<uint64_t>(sampling_interval), stack_depth);
+}
+
+// static
+v8::Local<v8::Value> AtomBindings::StopSamplingHeapProfiler(
+    v8::Isolate* isolate) {
+  auto* heap_profiler = isolate->GetHeapProfiler();
+  std::unique_ptr<v8::AllocationProfile> profile(
+      heap_profiler->GetAllocationProfile());
+  heap_profiler->StopSamplingHeapProfiler();
+  if (!profile)
+    return v8::Null(isolate);
+
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("head", AllocationNodeToV8(isolate, profile->GetRootNode()));
+  return dict.GetHandle();
+}
+
+// static
+bool AtomBindings::StartCpuProfile(v8::Isolate* isolate,
+                                   mate::Arguments* args) {
+  // Default of DevTools, one sample every millisecond.
+  int sampling_interval = 1000;
+  mate::Dictionary options;
+  if (args->GetNext(&options))
+    options.Get("samplingInterval", &sampling_interval);
+  if (sampling_interval <= 0) {
+    args->ThrowError("Invalid sampling interval");
+    return false;
+  }
+
+  return atom::StartCpuProfile(
+      isolate, base::TimeDelta::FromMicroseconds(sampling_interval));
+}
+
+// static
+v8::Local<v8::Promise> AtomBindings::StopCpuProfile(
+    v8::Isolate* isolate,
+    const base::FilePath& file_path) {
+  auto promise = std::make_unique<PendingPromise>(isolate);
+  v8::Local<v8::Promise> handle = promise->GetPromise();
+  atom::StopCpuProfile(
+      isolate, file_path,
+      base::BindOnce(&OnCpuProfileWritten, std::move(promise)));
+  return handle;
+}
+
 }  // namespace atom
@@ -44,8 +44,17 @@ class AtomBindings {
   static v8::Local<v8::Value> GetCPUUsage(base::ProcessMetrics* metrics,
                                           v8::Isolate* isolate);
   static v8::Local<v8::Value> GetIOCounters(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetCodeCacheStatistics(v8::Isolate* isolate);
+  static v8::Local<v8::Value> GetStartupTimeline(v8::Isolate* isolate);
   static bool TakeHeapSnapshot(v8::Isolate* isolate,
                                const base::FilePath& file_path);
+  static bool StartSamplingHeapProfiler(v8::Isolate* isolate,
+                                        mate::Arguments* args);
+  static v8::Local<v8::Value> StopSamplingHeapProfiler(v8::Isolate* isolate);
+  static bool StartCpuProfile(v8::Isolate* isolate, mate::Arguments* args);
+  static v8::Local<v8::Promise> StopCpuProfile(
+      v8::Isolate* isolate,
+      const base::FilePath& file_path);
 
  private:
   void ActivateUVLoop(v8::Isolate* isolate);
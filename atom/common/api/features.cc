@@ -49,6 +49,14 @@ bool IsViewApiEnabled() {
 #endif
 }
 
+bool IsInitCodeCacheEnabled() {
+#if defined(ENABLE_INIT_CODE_CACHE)
+  return true;
+#else
+  return false;
+#endif
+}
+
 void Initialize(v8::Local<v8::Object> exports,
                 v8::Local<v8::Value> unused,
                 v8::Local<v8::Context> context,
@@ -60,6 +68,7 @@ void Initialize(v8::Local<v8::Object> exports,
   dict.SetMethod("isFakeLocationProviderEnabled",
                  &IsFakeLocationProviderEnabled);
   dict.SetMethod("isViewApiEnabled", &IsViewApiEnabled);
+  dict.SetMethod("isInitCodeCacheEnabled", &IsInitCodeCacheEnabled);
 }
 
 }  // namespace
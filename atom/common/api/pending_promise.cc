@@ -0,0 +1,41 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/api/pending_promise.h"
+
+#include "native_mate/converter.h"
+
+namespace atom {
+
+PendingPromise::PendingPromise(v8::Isolate* isolate)
+    : isolate_(isolate),
+      context_(isolate, isolate->GetCurrentContext()),
+      resolver_(isolate, v8::Promise::Resolver::New(isolate)) {}
+
+PendingPromise::~PendingPromise() {}
+
+v8::Local<v8::Promise> PendingPromise::GetPromise() const {
+  return resolver_.Get(isolate_)->GetPromise();
+}
+
+void PendingPromise::Resolve(v8::Local<v8::Value> value) {
+  resolver_.Get(isolate_)->Resolve(context_.Get(isolate_), value);
+}
+
+void PendingPromise::RejectWithErrorMessage(const std::string& message) {
+  v8::Local<v8::Value> error =
+      v8::Exception::Error(mate::StringToV8(isolate_, message));
+  resolver_.Get(isolate_)->Reject(context_.Get(isolate_), error);
+}
+
+PendingPromise::Scope::Scope(PendingPromise* promise)
+    : locker_(promise->isolate_),
+      handle_scope_(promise->isolate_),
+      context_scope_(promise->context_.Get(promise->isolate_)),
+      microtasks_scope_(promise->isolate_,
+                        v8::MicrotasksScope::kRunMicrotasks) {}
+
+PendingPromise::Scope::~Scope() {}
+
+}  // namespace atom
@@ -0,0 +1,58 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_API_PENDING_PROMISE_H_
+#define ATOM_COMMON_API_PENDING_PROMISE_H_
+
+#include <string>
+
+#include "atom/common/api/locker.h"
+#include "base/macros.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Keeps a promise until the task posted for it has finished. Unlike
+// util::Promise it is not tied to the browser's UI thread, it is resolved in
+// the thread that created it, which is the main thread of the process or the
+// thread of a worker.
+class PendingPromise {
+ public:
+  explicit PendingPromise(v8::Isolate* isolate);
+  ~PendingPromise();
+
+  v8::Isolate* isolate() const { return isolate_; }
+
+  v8::Local<v8::Promise> GetPromise() const;
+
+  // Must be called inside a Scope.
+  void Resolve(v8::Local<v8::Value> value);
+  void RejectWithErrorMessage(const std::string& message);
+
+  // Enters the context of the promise and runs the microtasks on leaving.
+  class Scope {
+   public:
+    explicit Scope(PendingPromise* promise);
+    ~Scope();
+
+   private:
+    mate::Locker locker_;
+    v8::HandleScope handle_scope_;
+    v8::Context::Scope context_scope_;
+    v8::MicrotasksScope microtasks_scope_;
+
+    DISALLOW_COPY_AND_ASSIGN(Scope);
+  };
+
+ private:
+  v8::Isolate* isolate_;
+  v8::Global<v8::Context> context_;
+  v8::Global<v8::Promise::Resolver> resolver_;
+
+  DISALLOW_COPY_AND_ASSIGN(PendingPromise);
+};
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_API_PENDING_PROMISE_H_
@@ -0,0 +1,268 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/code_cache.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/path_service.h"
+#include "base/sequenced_task_runner.h"
+#include "base/sha1.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
+#include "base/task_scheduler/post_task.h"
+
+namespace atom {
+
+namespace {
+
+// Limit of the size of the cache files of a directory.
+const size_t kMaxDiskSize = 16 * 1024 * 1024;
+
+// Returns a stamp of the running binary, which changes whenever the built-in
+// bundles or the V8 version and flags change. It is used as a directory name.
+std::string GetBinaryStamp() {
+  base::FilePath exe_path;
+  base::File::Info info;
+  if (!PathService::Get(base::FILE_EXE, &exe_path) ||
+      !base::GetFileInfo(exe_path, &info))
+    return std::string();
+  return base::Int64ToString(info.size) + "-" +
+         base::Int64ToString(info.last_modified.ToInternalValue()) + "-" +
+         base::UintToString(v8::ScriptCompiler::CachedDataVersionTag());
+}
+
+// Scripts are compiled on the main thread and on worker threads.
+class CodeCache {
+ public:
+  CodeCache() {}
+
+  // Returns the key of |source|. Named scripts are keyed by their name, the
+  // caller's |stamp| and the length of the source, which V8 verifies again
+  // when consuming the cache, so the source itself is never hashed. Scripts
+  // without a name can only be keyed by their contents.
+  std::string GetKey(v8::Isolate* isolate,
+                     v8::Local<v8::String> source,
+                     v8::Local<v8::String> resource_name,
+                     const std::string& stamp) {
+    std::string id;
+    if (resource_name.IsEmpty() || resource_name->Length() == 0) {
+      v8::String::Utf8Value utf8(isolate, source);
+      id.assign(*utf8, utf8.length());
+    } else {
+      v8::String::Utf8Value utf8(isolate, resource_name);
+      id.assign(*utf8, utf8.length());
+      id += '\n' + stamp + '\n' + base::IntToString(source->Length());
+    }
+    std::string hash = base::SHA1HashString(id);
+    return base::HexEncode(hash.data(), hash.size()) + "-" +
+           base::UintToString(v8::ScriptCompiler::CachedDataVersionTag());
+  }
+
+  // Only looks into memory, the directory is loaded in the background.
+  bool Get(const std::string& key, std::string* data) {
+    base::AutoLock auto_lock(lock_);
+    auto it = entries_.find(key);
+    if (it == entries_.end())
+      return false;
+    *data = it->second;
+    return true;
+  }
+
+  void Put(const std::string& key, std::string data) {
+    base::AutoLock auto_lock(lock_);
+    entries_[key] = data;
+    ++statistics_.produced;
+    if (file_task_runner_)
+      file_task_runner_->PostTask(
+          FROM_HERE, base::BindOnce(&CodeCache::WriteToDisk,
+                                    base::Unretained(this), key,
+                                    std::move(data)));
+  }
+
+  void Remove(const std::string& key) {
+    base::AutoLock auto_lock(lock_);
+    entries_.erase(key);
+  }
+
+  void RecordConsumed(bool rejected) {
+    base::AutoLock auto_lock(lock_);
+    if (rejected)
+      ++statistics_.rejected;
+    else
+      ++statistics_.accepted;
+  }
+
+  void SetDirectory(const base::FilePath& path) {
+    base::AutoLock auto_lock(lock_);
+    if (file_task_runner_)
+      return;
+    // Loading and writing share a sequence, so nothing is written before the
+    // directory has been loaded.
+    file_task_runner_ = base::CreateSequencedTaskRunnerWithTraits(
+        {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+         base::TaskShutdownBehavior::CONTINUE_ON_SHUTDOWN});
+    // The cache is leaked, so it outlives the task.
+    file_task_runner_->PostTask(
+        FROM_HERE, base::BindOnce(&CodeCache::LoadFromDisk,
+                                  base::Unretained(this), path));
+  }
+
+  CodeCacheStatistics GetStatistics() {
+    base::AutoLock auto_lock(lock_);
+    return statistics_;
+  }
+
+ private:
+  void AddEntries(std::map<std::string, std::string> entries) {
+    base::AutoLock auto_lock(lock_);
+    // Entries produced while loading are newer than the ones on disk.
+    for (auto& entry : entries)
+      entries_.emplace(entry.first, std::move(entry.second));
+  }
+
+  // Runs on |file_task_runner_|, like WriteToDisk.
+  void LoadFromDisk(const base::FilePath& directory) {
+    // Each binary gets its own subdirectory, so processes of the same binary
+    // never delete the files others are reading or writing.
+    std::string stamp = GetBinaryStamp();
+    if (stamp.empty())
+      return;
+    base::FilePath cache_directory = directory.AppendASCII(stamp);
+
+    // Only caches of other binaries are removed, which were left behind by
+    // an update of the app.
+    base::FileEnumerator directories(directory, false,
+                                     base::FileEnumerator::DIRECTORIES);
+    for (base::FilePath path = directories.Next(); !path.empty();
+         path = directories.Next()) {
+      if (path != cache_directory)
+        base::DeleteFile(path, true);
+    }
+    if (!base::CreateDirectory(cache_directory))
+      return;
+    disk_directory_ = cache_directory;
+
+    std::map<std::string, std::string> entries;
+    base::FileEnumerator files(cache_directory, false,
+                               base::FileEnumerator::FILES);
+    for (base::FilePath path = files.Next(); !path.empty();
+         path = files.Next()) {
+      // Skip the temporary files of unfinished writes.
+      std::string key = path.BaseName().MaybeAsASCII();
+      if (key.empty() || key.find('.') != std::string::npos)
+        continue;
+      std::string data;
+      if (disk_size_ >= kMaxDiskSize || !base::ReadFileToString(path, &data) ||
+          data.empty())
+        continue;
+      disk_size_ += data.size();
+      entries[key] = std::move(data);
+    }
+    AddEntries(std::move(entries));
+  }
+
+  void WriteToDisk(const std::string& key, const std::string& data) {
+    // Other processes write to the directory too, so the limit is only kept
+    // roughly.
+    if (disk_directory_.empty() || disk_size_ + data.size() > kMaxDiskSize)
+      return;
+    // Write to a temporary file first so readers never see partial data.
+    base::FilePath temp_path;
+    if (!base::CreateTemporaryFileInDir(disk_directory_, &temp_path))
+      return;
+    if (base::WriteFile(temp_path, data.data(), data.size()) !=
+            static_cast<int>(data.size()) ||
+        !base::ReplaceFile(temp_path, disk_directory_.AppendASCII(key),
+                           nullptr)) {
+      base::DeleteFile(temp_path, false);
+      return;
+    }
+    disk_size_ += data.size();
+  }
+
+  base::Lock lock_;
+  std::map<std::string, std::string> entries_;
+  scoped_refptr<base::SequencedTaskRunner> file_task_runner_;
+  CodeCacheStatistics statistics_;
+
+  // Only used on |file_task_runner_|.
+  base::FilePath disk_directory_;
+  size_t disk_size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(CodeCache);
+};
+
+base::LazyInstance<CodeCache>::Leaky g_code_cache = LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+v8::MaybeLocal<v8::Value> RunScriptWithCodeCache(
+    v8::Local<v8::Context> context,
+    v8::Local<v8::String> source,
+    v8::Local<v8::String> resource_name,
+    const std::string& stamp) {
+  v8::Isolate* isolate = context->GetIsolate();
+  CodeCache* cache = g_code_cache.Pointer();
+  std::string key = cache->GetKey(isolate, source, resource_name, stamp);
+
+  std::string data;
+  bool consume = cache->Get(key, &data);
+  // The source owns the CachedData, which only points into |data|.
+  v8::ScriptOrigin origin(resource_name.IsEmpty()
+                              ? v8::Local<v8::Value>(v8::Undefined(isolate))
+                              : v8::Local<v8::Value>(resource_name));
+  v8::ScriptCompiler::Source script_source(
+      source, origin,
+      consume ? new v8::ScriptCompiler::CachedData(
+                    reinterpret_cast<const uint8_t*>(data.data()), data.size())
+              : nullptr);
+
+  v8::Local<v8::Script> script;
+  if (!v8::ScriptCompiler::Compile(context, &script_source,
+                                   consume
+                                       ? v8::ScriptCompiler::kConsumeCodeCache
+                                       : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&script))
+    return v8::MaybeLocal<v8::Value>();
+
+  bool rejected = consume && script_source.GetCachedData()->rejected;
+  if (consume) {
+    cache->RecordConsumed(rejected);
+    if (rejected)
+      cache->Remove(key);
+  }
+
+  v8::MaybeLocal<v8::Value> result = script->Run(context);
+
+  // Create the cache after running the script, so the functions compiled
+  // lazily while running it are included too.
+  if (!consume || rejected) {
+    std::unique_ptr<v8::ScriptCompiler::CachedData> cached_data(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (cached_data)
+      cache->Put(key,
+                 std::string(reinterpret_cast<const char*>(cached_data->data),
+                             cached_data->length));
+  }
+
+  return result;
+}
+
+void SetCodeCacheDirectory(const base::FilePath& path) {
+  g_code_cache.Get().SetDirectory(path);
+}
+
+CodeCacheStatistics GetCodeCacheStatistics() {
+  return g_code_cache.Get().GetStatistics();
+}
+
+}  // namespace atom
@@ -0,0 +1,46 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_CODE_CACHE_H_
+#define ATOM_COMMON_CODE_CACHE_H_
+
+#include <string>
+
+#include "base/files/file_path.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+struct CodeCacheStatistics {
+  // Number of code caches created after compiling a script from source.
+  int produced = 0;
+  // Number of code caches V8 accepted.
+  int accepted = 0;
+  // Number of code caches V8 rejected, e.g. because of a flag mismatch.
+  int rejected = 0;
+};
+
+// Compiles and runs |source| in |context|. The compiled code is cached per
+// process, so later compilations of the same source skip parsing and
+// compiling. |resource_name| is the file name shown in stack traces, scripts
+// with a name are keyed by it and by |stamp|, which must change whenever the
+// source changes without the binary changing, e.g. the modification time of
+// the file. Scripts without a name are keyed by their contents.
+v8::MaybeLocal<v8::Value> RunScriptWithCodeCache(
+    v8::Local<v8::Context> context,
+    v8::Local<v8::String> source,
+    v8::Local<v8::String> resource_name = v8::Local<v8::String>(),
+    const std::string& stamp = std::string());
+
+// Persists the code cache in |path|, so it survives across processes. The
+// directory is loaded in the background, has a subdirectory per binary and is
+// limited in size. Only the first directory set is used, and only processes
+// that can access the file system should set it.
+void SetCodeCacheDirectory(const base::FilePath& path);
+
+CodeCacheStatistics GetCodeCacheStatistics();
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_CODE_CACHE_H_
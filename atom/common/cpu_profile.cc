@@ -0,0 +1,176 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/cpu_profile.h"
+
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/json/json_writer.h"
+#include "base/lazy_instance.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/task_runner_util.h"
+#include "base/task_scheduler/post_task.h"
+#include "base/threading/thread_local.h"
+#include "base/values.h"
+#include "native_mate/converter.h"
+#include "v8/include/v8-profiler.h"
+
+namespace {
+
+// Title of the profile recorded by Electron.
+const char kProfileTitle[] = "electron";
+
+v8::Local<v8::String> GetProfileTitle(v8::Isolate* isolate) {
+  return mate::StringToV8(isolate, kProfileTitle);
+}
+
+struct CpuProfilerState {
+  v8::Isolate* isolate;
+  v8::CpuProfiler* profiler;
+};
+
+// Isolates are bound to the thread they run on, so is the profiler.
+base::LazyInstance<base::ThreadLocalPointer<CpuProfilerState>>::Leaky
+    g_profiler_tls = LAZY_INSTANCE_INITIALIZER;
+
+std::unique_ptr<base::DictionaryValue> ProfileNodeToValue(
+    const v8::CpuProfileNode* node) {
+  auto call_frame = std::make_unique<base::DictionaryValue>();
+  call_frame->SetString("functionName", node->GetFunctionNameStr());
+  call_frame->SetString("scriptId", base::IntToString(node->GetScriptId()));
+  call_frame->SetString("url", node->GetScriptResourceNameStr());
+  // DevTools expects zero based positions.
+  call_frame->SetInteger("lineNumber", node->GetLineNumber() - 1);
+  call_frame->SetInteger("columnNumber", node->GetColumnNumber() - 1);
+
+  auto children = std::make_unique<base::ListValue>();
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    children->AppendInteger(node->GetChild(i)->GetNodeId());
+
+  auto value = std::make_unique<base::DictionaryValue>();
+  value->SetInteger("id", node->GetNodeId());
+  value->Set("callFrame", std::move(call_frame));
+  value->SetInteger("hitCount", node->GetHitCount());
+  value->Set("children", std::move(children));
+  return value;
+}
+
+void AppendProfileNodes(const v8::CpuProfileNode* node,
+                        base::ListValue* nodes) {
+  nodes->Append(ProfileNodeToValue(node));
+  for (int i = 0; i < node->GetChildrenCount(); ++i)
+    AppendProfileNodes(node->GetChild(i), nodes);
+}
+
+std::string SerializeProfile(const v8::CpuProfile* profile) {
+  auto nodes = std::make_unique<base::ListValue>();
+  AppendProfileNodes(profile->GetTopDownRoot(), nodes.get());
+
+  auto samples = std::make_unique<base::ListValue>();
+  auto time_deltas = std::make_unique<base::ListValue>();
+  int64_t last_timestamp = profile->GetStartTime();
+  for (int i = 0; i < profile->GetSamplesCount(); ++i) {
+    samples->AppendInteger(profile->GetSample(i)->GetNodeId());
+    int64_t timestamp = profile->GetSampleTimestamp(i);
+    time_deltas->AppendInteger(static_cast<int>(timestamp - last_timestamp));
+    last_timestamp = timestamp;
+  }
+
+  base::DictionaryValue value;
+  value.Set("nodes", std::move(nodes));
+  value.SetDouble("startTime", static_cast<double>(profile->GetStartTime()));
+  value.SetDouble("endTime", static_cast<double>(profile->GetEndTime()));
+  value.Set("samples", std::move(samples));
+  value.Set("timeDeltas", std::move(time_deltas));
+
+  std::string json;
+  base::JSONWriter::Write(value, &json);
+  return json;
+}
+
+bool WriteProfileToPath(const base::FilePath& file_path,
+                        const std::string& json) {
+  base::File file(file_path,
+                  base::File::FLAG_CREATE_ALWAYS | base::File::FLAG_WRITE);
+  if (!file.IsValid())
+    return false;
+  return file.WriteAtCurrentPos(json.data(), json.size()) ==
+         static_cast<int>(json.size());
+}
+
+// Stops the profiler of |isolate| and returns the serialized profile, or an
+// empty string when no profile was being recorded.
+std::string StopProfiling(v8::Isolate* isolate) {
+  CpuProfilerState* state = g_profiler_tls.Pointer()->Get();
+  // The profiler of another isolate keeps running.
+  if (!state || state->isolate != isolate)
+    return std::string();
+  g_profiler_tls.Pointer()->Set(nullptr);
+  std::unique_ptr<CpuProfilerState> owned_state(state);
+
+  std::string json;
+  {
+    v8::HandleScope handle_scope(isolate);
+    v8::CpuProfile* profile =
+        state->profiler->StopProfiling(GetProfileTitle(isolate));
+    if (profile) {
+      json = SerializeProfile(profile);
+      profile->Delete();
+    }
+  }
+  state->profiler->Dispose();
+  return json;
+}
+
+const base::TaskTraits kWriteProfileTraits = {
+    base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+    base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN};
+
+}  // namespace
+
+namespace atom {
+
+bool StartCpuProfile(v8::Isolate* isolate, base::TimeDelta sampling_interval) {
+  DCHECK(isolate);
+  if (g_profiler_tls.Pointer()->Get())
+    return false;
+
+  v8::HandleScope handle_scope(isolate);
+  auto* profiler = v8::CpuProfiler::New(isolate);
+  profiler->SetSamplingInterval(
+      static_cast<int>(sampling_interval.InMicroseconds()));
+  profiler->StartProfiling(GetProfileTitle(isolate), true);
+  g_profiler_tls.Pointer()->Set(new CpuProfilerState{isolate, profiler});
+  return true;
+}
+
+std::string StopCpuProfile(v8::Isolate* isolate) {
+  return StopProfiling(isolate);
+}
+
+void StopCpuProfile(v8::Isolate* isolate,
+                    const base::FilePath& file_path,
+                    base::OnceCallback<void(bool success)> callback) {
+  std::string json = StopProfiling(isolate);
+  if (json.empty()) {
+    std::move(callback).Run(false);
+    return;
+  }
+
+  WriteCpuProfile(file_path, std::move(json), std::move(callback));
+}
+
+void WriteCpuProfile(const base::FilePath& file_path,
+                     std::string profile,
+                     base::OnceCallback<void(bool success)> callback) {
+  base::PostTaskWithTraitsAndReplyWithResult(
+      FROM_HERE, kWriteProfileTraits,
+      base::BindOnce(&WriteProfileToPath, file_path, std::move(profile)),
+      std::move(callback));
+}
+
+}  // namespace atom
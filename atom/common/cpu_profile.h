@@ -0,0 +1,42 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_CPU_PROFILE_H_
+#define ATOM_COMMON_CPU_PROFILE_H_
+
+#include <string>
+
+#include "base/callback.h"
+#include "base/files/file_path.h"
+#include "base/time/time.h"
+#include "v8/include/v8.h"
+
+namespace atom {
+
+// Starts recording a CPU profile of |isolate|, sampling the stack every
+// |sampling_interval|. Returns false if a profile is already being recorded
+// on the current thread.
+bool StartCpuProfile(v8::Isolate* isolate, base::TimeDelta sampling_interval);
+
+// Stops the recording started by StartCpuProfile and returns the profile in
+// the ".cpuprofile" format used by DevTools, or an empty string when no
+// profile was being recorded.
+std::string StopCpuProfile(v8::Isolate* isolate);
+
+// Like above, but writes the profile to |file_path| on a background
+// sequence, |callback| is called on the calling sequence when done. The file
+// is only created when a profile was being recorded.
+void StopCpuProfile(v8::Isolate* isolate,
+                    const base::FilePath& file_path,
+                    base::OnceCallback<void(bool success)> callback);
+
+// Writes a profile returned by StopCpuProfile to |file_path| on a background
+// sequence, |callback| is called on the calling sequence when done.
+void WriteCpuProfile(const base::FilePath& file_path,
+                     std::string profile,
+                     base::OnceCallback<void(bool success)> callback);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_CPU_PROFILE_H_
@@ -8,4 +8,14 @@ namespace atom {
 
 DraggableRegion::DraggableRegion() : draggable(false) {}
 
+bool DraggableRegion::operator==(const DraggableRegion& other) const {
+  return draggable == other.draggable && bounds == other.bounds;
+}
+
+bool DraggableRegion::operator!=(const DraggableRegion& other) const {
+  return !(*this == other);
+}
+
+DraggableRegionChange::DraggableRegionChange() : index(0) {}
+
 }  // namespace atom
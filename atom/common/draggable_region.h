@@ -5,6 +5,8 @@
 #ifndef ATOM_COMMON_DRAGGABLE_REGION_H_
 #define ATOM_COMMON_DRAGGABLE_REGION_H_
 
+#include <stdint.h>
+
 #include "ui/gfx/geometry/rect.h"
 
 namespace atom {
@@ -14,6 +16,17 @@ struct DraggableRegion {
   gfx::Rect bounds;
 
   DraggableRegion();
+
+  bool operator==(const DraggableRegion& other) const;
+  bool operator!=(const DraggableRegion& other) const;
+};
+
+// A region that replaces the one at |index| in the list of draggable regions.
+struct DraggableRegionChange {
+  uint32_t index;
+  DraggableRegion region;
+
+  DraggableRegionChange();
 };
 
 }  // namespace atom
@@ -4,10 +4,31 @@
 
 #include "atom/common/heap_snapshot.h"
 
+#include <string.h>
+
+#include <string>
+#include <utility>
+
+#include "base/bind.h"
+#include "base/containers/circular_deque.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/task_runner_util.h"
+#include "base/task_scheduler/post_task.h"
+#include "third_party/zlib/zlib.h"
 #include "v8/include/v8-profiler.h"
 
 namespace {
 
+// Serialized chunks are collected until this size before being queued for the
+// background writer.
+const size_t kBackgroundChunkSize = 1 << 20;
+
+// When more than this many bytes are waiting to be written, the serializing
+// thread waits for the background writer before queuing more.
+const size_t kMaxPendingBytes = 8 * kBackgroundChunkSize;
+
 class HeapSnapshotOutputStream : public v8::OutputStream {
  public:
   explicit HeapSnapshotOutputStream(base::File* file) : file_(file) {
@@ -30,6 +51,214 @@ class HeapSnapshotOutputStream : public v8::OutputStream {
   bool is_complete_ = false;
 };
 
+// Writes the queued chunks of the snapshot to the file. The chunks are queued
+// by the serializing thread and written on a background sequence.
+class HeapSnapshotFileWriter
+    : public base::RefCountedThreadSafe<HeapSnapshotFileWriter> {
+ public:
+  HeapSnapshotFileWriter(base::File file, bool compress)
+      : queue_drained_(&queue_lock_),
+        file_(std::move(file)),
+        compress_(compress),
+        failed_(!file_.IsValid()) {}
+
+  void Enqueue(std::string chunk) {
+    base::AutoLock auto_lock(queue_lock_);
+    pending_bytes_ += chunk.size();
+    queue_.push_back(std::move(chunk));
+  }
+
+  // Blocks until at most |max_bytes| are waiting to be written.
+  void WaitForPendingBytes(size_t max_bytes) {
+    base::AutoLock auto_lock(queue_lock_);
+    while (pending_bytes_ > max_bytes)
+      queue_drained_.Wait();
+  }
+
+  // Writes the queued chunks in order, returns the number of bytes written
+  // so far.
+  int64_t WritePending() {
+    base::AutoLock auto_lock(write_lock_);
+    while (true) {
+      std::string chunk;
+      {
+        base::AutoLock queue_auto_lock(queue_lock_);
+        if (queue_.empty())
+          break;
+        chunk.swap(queue_.front());
+        queue_.pop_front();
+        pending_bytes_ -= chunk.size();
+        queue_drained_.Signal();
+      }
+      Write(chunk);
+    }
+    return bytes_written_;
+  }
+
+  bool Finish() {
+    WritePending();
+    base::AutoLock auto_lock(write_lock_);
+    if (compress_ && InitializeStream()) {
+      stream_.next_in = nullptr;
+      stream_.avail_in = 0;
+      Deflate(Z_FINISH);
+      deflateEnd(&stream_);
+      stream_initialized_ = false;
+    }
+    file_.Close();
+    return !failed_;
+  }
+
+ private:
+  friend class base::RefCountedThreadSafe<HeapSnapshotFileWriter>;
+
+  void Write(const std::string& chunk) {
+    if (!compress_) {
+      WriteToFile(chunk.data(), chunk.size());
+      return;
+    }
+
+    if (!InitializeStream())
+      return;
+    stream_.next_in =
+        reinterpret_cast<Bytef*>(const_cast<char*>(chunk.data()));
+    stream_.avail_in = static_cast<uInt>(chunk.size());
+    Deflate(Z_NO_FLUSH);
+  }
+
+  ~HeapSnapshotFileWriter() {
+    if (stream_initialized_)
+      deflateEnd(&stream_);
+  }
+
+  bool InitializeStream() {
+    if (stream_initialized_ || failed_)
+      return !failed_;
+    memset(&stream_, 0, sizeof(stream_));
+    // Adding 16 to the window bits writes a gzip header and trailer.
+    if (deflateInit2(&stream_, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                     MAX_WBITS + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      failed_ = true;
+      return false;
+    }
+    stream_initialized_ = true;
+    return true;
+  }
+
+  void Deflate(int flush) {
+    char buffer[kOutputBufferSize];
+    do {
+      stream_.next_out = reinterpret_cast<Bytef*>(buffer);
+      stream_.avail_out = sizeof(buffer);
+      int result = deflate(&stream_, flush);
+      if (result == Z_STREAM_ERROR) {
+        failed_ = true;
+        return;
+      }
+      WriteToFile(buffer, sizeof(buffer) - stream_.avail_out);
+    } while (stream_.avail_out == 0);
+  }
+
+  void WriteToFile(const char* data, size_t size) {
+    if (failed_ || size == 0)
+      return;
+    int bytes_written = file_.WriteAtCurrentPos(data, static_cast<int>(size));
+    if (bytes_written != static_cast<int>(size))
+      failed_ = true;
+    else
+      bytes_written_ += bytes_written;
+  }
+
+  static const size_t kOutputBufferSize = 65536;
+
+  base::Lock queue_lock_;
+  base::ConditionVariable queue_drained_;
+  base::circular_deque<std::string> queue_;
+  size_t pending_bytes_ = 0;
+
+  // Held while writing, the members below are guarded by it.
+  base::Lock write_lock_;
+  base::File file_;
+  bool compress_;
+  bool failed_;
+  int64_t bytes_written_ = 0;
+
+  z_stream stream_;
+  bool stream_initialized_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(HeapSnapshotFileWriter);
+};
+
+// Collects the chunks serialized by V8 and posts them to the writer.
+class BackgroundHeapSnapshotOutputStream : public v8::OutputStream {
+ public:
+  BackgroundHeapSnapshotOutputStream(
+      scoped_refptr<base::SequencedTaskRunner> task_runner,
+      scoped_refptr<HeapSnapshotFileWriter> writer,
+      const atom::HeapSnapshotProgressCallback& progress_callback)
+      : task_runner_(task_runner),
+        writer_(writer),
+        progress_callback_(progress_callback) {}
+
+  bool IsComplete() const { return is_complete_; }
+
+  // v8::OutputStream
+  int GetChunkSize() override { return 65536; }
+
+  void EndOfStream() override {
+    is_complete_ = true;
+    Flush();
+  }
+
+  v8::OutputStream::WriteResult WriteAsciiChunk(char* data, int size) override {
+    buffer_.append(data, size);
+    if (buffer_.size() >= kBackgroundChunkSize)
+      Flush();
+    return kContinue;
+  }
+
+ private:
+  void Flush() {
+    if (buffer_.empty())
+      return;
+    std::string chunk;
+    chunk.swap(buffer_);
+    writer_->Enqueue(std::move(chunk));
+
+    if (progress_callback_.is_null()) {
+      task_runner_->PostTask(
+          FROM_HERE,
+          base::BindOnce(
+              base::IgnoreResult(&HeapSnapshotFileWriter::WritePending),
+              writer_));
+    } else {
+      base::PostTaskAndReplyWithResult(
+          task_runner_.get(), FROM_HERE,
+          base::BindOnce(&HeapSnapshotFileWriter::WritePending, writer_),
+          progress_callback_);
+    }
+
+    // When the disk is slower than the serializer, wait for the background
+    // writer so the queued chunks do not pile up in memory. This thread never
+    // writes to the file itself.
+    writer_->WaitForPendingBytes(kMaxPendingBytes);
+  }
+
+  scoped_refptr<base::SequencedTaskRunner> task_runner_;
+  scoped_refptr<HeapSnapshotFileWriter> writer_;
+  atom::HeapSnapshotProgressCallback progress_callback_;
+  std::string buffer_;
+  bool is_complete_ = false;
+
+  DISALLOW_COPY_AND_ASSIGN(BackgroundHeapSnapshotOutputStream);
+};
+
+void OnHeapSnapshotWritten(bool is_complete,
+                           base::OnceCallback<void(bool)> callback,
+                           bool success) {
+  std::move(callback).Run(is_complete && success);
+}
+
 }  // namespace
 
 namespace atom {
@@ -53,4 +282,36 @@ bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file) {
   return stream.IsComplete();
 }
 
+void TakeHeapSnapshotInBackground(
+    v8::Isolate* isolate,
+    base::File file,
+    bool compress,
+    const HeapSnapshotProgressCallback& progress_callback,
+    base::OnceCallback<void(bool success)> callback) {
+  DCHECK(isolate);
+
+  auto task_runner = base::CreateSequencedTaskRunnerWithTraits(
+      {base::MayBlock(), base::TaskPriority::USER_VISIBLE,
+       base::TaskShutdownBehavior::SKIP_ON_SHUTDOWN});
+  scoped_refptr<HeapSnapshotFileWriter> writer(
+      new HeapSnapshotFileWriter(std::move(file), compress));
+
+  bool is_complete = false;
+  auto* snapshot = isolate->GetHeapProfiler()->TakeHeapSnapshot();
+  if (snapshot) {
+    BackgroundHeapSnapshotOutputStream stream(task_runner, writer,
+                                              progress_callback);
+    snapshot->Serialize(&stream, v8::HeapSnapshot::kJSON);
+    const_cast<v8::HeapSnapshot*>(snapshot)->Delete();
+    is_complete = stream.IsComplete();
+  }
+
+  // The writer closes the file after all pending chunks, also when taking
+  // the snapshot failed.
+  base::PostTaskAndReplyWithResult(
+      task_runner.get(), FROM_HERE,
+      base::BindOnce(&HeapSnapshotFileWriter::Finish, writer),
+      base::BindOnce(&OnHeapSnapshotWritten, is_complete, std::move(callback)));
+}
+
 }  // namespace atom
@@ -5,6 +5,7 @@
 #ifndef ATOM_COMMON_HEAP_SNAPSHOT_H_
 #define ATOM_COMMON_HEAP_SNAPSHOT_H_
 
+#include "base/callback.h"
 #include "base/files/file.h"
 #include "v8/include/v8.h"
 
@@ -12,6 +13,23 @@ namespace atom {
 
 bool TakeHeapSnapshot(v8::Isolate* isolate, base::File* file);
 
+// Called with the number of bytes written to the file so far.
+using HeapSnapshotProgressCallback =
+    base::RepeatingCallback<void(int64_t bytes_written)>;
+
+// Takes a heap snapshot of |isolate| and hands the serialized chunks to a
+// background sequence that writes them to |file|, gzip compressed when
+// |compress| is true. The calling thread never writes to the file, but it
+// waits for the background sequence when more than a few MB are waiting to
+// be written. |callback| is called on the calling sequence once the file is
+// written.
+void TakeHeapSnapshotInBackground(
+    v8::Isolate* isolate,
+    base::File file,
+    bool compress,
+    const HeapSnapshotProgressCallback& progress_callback,
+    base::OnceCallback<void(bool success)> callback);
+
 }  // namespace atom
 
 #endif  // ATOM_COMMON_HEAP_SNAPSHOT_H_
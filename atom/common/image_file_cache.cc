@@ -0,0 +1,250 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/image_file_cache.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "atom/common/asar/archive.h"
+#include "atom/common/asar/asar_util.h"
+#include "base/containers/mru_cache.h"
+#include "base/files/file_enumerator.h"
+#include "base/files/file_path.h"
+#include "base/files/file_util.h"
+#include "base/lazy_instance.h"
+#include "base/strings/string_util.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/thread_restrictions.h"
+#include "base/time/time.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace atom {
+
+namespace {
+
+// Number of directories whose listings are kept.
+const size_t kMaxDirectoryListings = 64;
+
+// Limit of the memory used by the decoded images.
+const size_t kMaxDecodedImagesSize = 32 * 1024 * 1024;
+
+// Identifies a version of a file, files in asar archives never change.
+struct FileVersion {
+  base::Time last_modified;
+  int64_t size = 0;
+
+  bool operator==(const FileVersion& other) const {
+    return last_modified == other.last_modified && size == other.size;
+  }
+};
+
+// Returns how the names of the files in |path| are compared.
+base::FilePath::StringType GetNameKey(const base::FilePath& path,
+                                      bool in_asar) {
+  base::FilePath::StringType name = path.BaseName().value();
+#if defined(OS_WIN) || defined(OS_MACOSX)
+  // The default file systems of Windows and macOS ignore case, while asar
+  // archives do not.
+  if (!in_asar)
+    return base::ToLowerASCII(name);
+#endif
+  return name;
+}
+
+bool GetFileVersion(const base::FilePath& path, FileVersion* version) {
+  base::FilePath asar_path, relative_path;
+  if (asar::GetAsarArchivePath(path, &asar_path, &relative_path)) {
+    std::shared_ptr<asar::Archive> archive =
+        asar::GetOrCreateAsarArchive(asar_path);
+    asar::Archive::Stats stats;
+    if (!archive || !archive->Stat(relative_path, &stats) || !stats.is_file)
+      return false;
+    version->size = stats.size;
+    return true;
+  }
+
+  base::ThreadRestrictions::ScopedAllowIO allow_io;
+  base::File::Info info;
+  if (!base::GetFileInfo(path, &info) || info.is_directory)
+    return false;
+  version->last_modified = info.last_modified;
+  version->size = info.size;
+  return true;
+}
+
+class ImageFileCache {
+ public:
+  ImageFileCache()
+      : listings_(kMaxDirectoryListings),
+        images_(base::MRUCache<base::FilePath, Image>::NO_AUTO_EVICT) {}
+
+  // Returns the names of the files in |dir|, or nullptr if it can not be
+  // listed.
+  std::shared_ptr<const ImageDirectoryListing::Names> List(
+      const base::FilePath& dir) {
+    base::FilePath asar_path, relative_dir;
+    bool in_asar = asar::GetAsarArchivePath(dir, &asar_path, &relative_dir);
+
+    // The listings of asar archives never change, only directories on the
+    // file system have to be checked for modifications.
+    base::Time last_modified;
+    if (!in_asar) {
+      base::ThreadRestrictions::ScopedAllowIO allow_io;
+      base::File::Info info;
+      if (!base::GetFileInfo(dir, &info) || !info.is_directory)
+        return nullptr;
+      last_modified = info.last_modified;
+    }
+
+    {
+      base::AutoLock auto_lock(lock_);
+      auto it = listings_.Get(dir);
+      if (it != listings_.end() && it->second.last_modified == last_modified)
+        return it->second.names;
+    }
+
+    auto names = std::make_shared<ImageDirectoryListing::Names>();
+    bool listed = in_asar ? ListArchive(asar_path, relative_dir, names.get())
+                          : ListDirectory(dir, names.get());
+    if (!listed)
+      return nullptr;
+
+    Listing listing;
+    listing.last_modified = last_modified;
+    listing.names = names;
+    base::AutoLock auto_lock(lock_);
+    listings_.Put(dir, std::move(listing));
+    return names;
+  }
+
+  bool Read(const base::FilePath& path,
+            ImageDecoder decoder,
+            SkBitmap* bitmap) {
+    FileVersion version;
+    if (!GetFileVersion(path, &version))
+      return false;
+
+    {
+      base::AutoLock auto_lock(lock_);
+      auto it = images_.Get(path);
+      if (it != images_.end() && it->second.version == version) {
+        *bitmap = it->second.bitmap;
+        return true;
+      }
+    }
+
+    std::string contents;
+    {
+      base::ThreadRestrictions::ScopedAllowIO allow_io;
+      if (!asar::ReadFileToString(path, &contents))
+        return false;
+    }
+    std::unique_ptr<SkBitmap> decoded =
+        decoder(reinterpret_cast<const unsigned char*>(contents.data()),
+                contents.size());
+    if (!decoded)
+      return false;
+
+    // The pixels are shared by all the images loaded from |path|.
+    decoded->setImmutable();
+    *bitmap = *decoded;
+
+    Image image;
+    image.version = version;
+    image.bitmap = *decoded;
+    image.size = decoded->computeByteSize();
+    if (image.size > kMaxDecodedImagesSize)
+      return true;
+
+    base::AutoLock auto_lock(lock_);
+    auto it = images_.Peek(path);
+    if (it != images_.end()) {
+      images_size_ -= it->second.size;
+      images_.Erase(it);
+    }
+    images_size_ += image.size;
+    images_.Put(path, std::move(image));
+    while (images_size_ > kMaxDecodedImagesSize) {
+      auto oldest = images_.rbegin();
+      images_size_ -= oldest->second.size;
+      images_.Erase(oldest);
+    }
+    return true;
+  }
+
+ private:
+  struct Listing {
+    base::Time last_modified;
+    std::shared_ptr<const ImageDirectoryListing::Names> names;
+  };
+
+  struct Image {
+    FileVersion version;
+    SkBitmap bitmap;
+    size_t size = 0;
+  };
+
+  static bool ListArchive(const base::FilePath& asar_path,
+                          base::FilePath relative_dir,
+                          ImageDirectoryListing::Names* names) {
+    std::shared_ptr<asar::Archive> archive =
+        asar::GetOrCreateAsarArchive(asar_path);
+    if (!archive)
+      return false;
+    // The root of the archive is represented by an empty path.
+    if (relative_dir.value() == base::FilePath::kCurrentDirectory)
+      relative_dir = base::FilePath();
+    std::vector<base::FilePath> files;
+    if (!archive->Readdir(relative_dir, &files))
+      return false;
+    for (const base::FilePath& file : files)
+      names->insert(GetNameKey(file, true));
+    return true;
+  }
+
+  static bool ListDirectory(const base::FilePath& dir,
+                            ImageDirectoryListing::Names* names) {
+    base::ThreadRestrictions::ScopedAllowIO allow_io;
+    base::FileEnumerator enumerator(dir, false, base::FileEnumerator::FILES);
+    for (base::FilePath file = enumerator.Next(); !file.empty();
+         file = enumerator.Next())
+      names->insert(GetNameKey(file, false));
+    return true;
+  }
+
+  // Images are loaded on the main thread, in renderers and in workers.
+  base::Lock lock_;
+  base::MRUCache<base::FilePath, Listing> listings_;
+  base::MRUCache<base::FilePath, Image> images_;
+  size_t images_size_ = 0;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageFileCache);
+};
+
+base::LazyInstance<ImageFileCache>::Leaky g_image_file_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+ImageDirectoryListing::ImageDirectoryListing(const base::FilePath& dir) {
+  base::FilePath asar_path, relative_dir;
+  in_asar_ = asar::GetAsarArchivePath(dir, &asar_path, &relative_dir);
+  names_ = g_image_file_cache.Get().List(dir);
+}
+
+ImageDirectoryListing::~ImageDirectoryListing() {}
+
+bool ImageDirectoryListing::MayContain(const base::FilePath& path) const {
+  return !names_ || names_->count(GetNameKey(path, in_asar_)) > 0;
+}
+
+bool ReadImageFile(const base::FilePath& path,
+                   ImageDecoder decoder,
+                   SkBitmap* bitmap) {
+  return g_image_file_cache.Get().Read(path, decoder, bitmap);
+}
+
+}  // namespace atom
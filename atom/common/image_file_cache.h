@@ -0,0 +1,56 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_IMAGE_FILE_CACHE_H_
+#define ATOM_COMMON_IMAGE_FILE_CACHE_H_
+
+#include <stddef.h>
+
+#include <memory>
+#include <set>
+
+#include "base/files/file_path.h"
+#include "base/macros.h"
+
+class SkBitmap;
+
+namespace atom {
+
+// Decodes the encoded image |data|, returns nullptr on failure.
+typedef std::unique_ptr<SkBitmap> (*ImageDecoder)(const unsigned char* data,
+                                                  size_t size);
+
+// The names of the files in a directory, used to look for images without
+// touching the file system for each of them. Listings are cached per process,
+// and read again when the directory is modified.
+class ImageDirectoryListing {
+ public:
+  typedef std::set<base::FilePath::StringType> Names;
+
+  explicit ImageDirectoryListing(const base::FilePath& dir);
+  ~ImageDirectoryListing();
+
+  // Returns false when |path| was not in the directory when it was listed,
+  // which can miss files added within the resolution of the directory's
+  // modification time. Returns true when the directory can not be listed, so
+  // callers still have to handle failures to read |path|.
+  bool MayContain(const base::FilePath& path) const;
+
+ private:
+  bool in_asar_ = false;
+  std::shared_ptr<const Names> names_;
+
+  DISALLOW_COPY_AND_ASSIGN(ImageDirectoryListing);
+};
+
+// Reads the image at |path|, which can be inside an asar archive, and decodes
+// it with |decoder|. Decoded images are cached per process by path and are
+// reused until the file is modified.
+bool ReadImageFile(const base::FilePath& path,
+                   ImageDecoder decoder,
+                   SkBitmap* bitmap);
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_IMAGE_FILE_CACHE_H_
@@ -13,12 +13,14 @@
 #include "atom/common/api/locker.h"
 #include "atom/common/atom_command_line.h"
 #include "atom/common/native_mate_converters/file_path_converter.h"
+#include "atom/common/startup_timeline.h"
 #include "base/base_paths.h"
 #include "base/command_line.h"
 #include "base/environment.h"
 #include "base/path_service.h"
 #include "base/run_loop.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/threading/platform_thread.h"
 #include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/browser/browser_thread.h"
@@ -53,6 +55,7 @@
   V(atom_browser_view)                       \
   V(atom_browser_web_view_manager)           \
   V(atom_browser_window)                     \
+  V(atom_browser_worker)                     \
   V(atom_common_asar)                        \
   V(atom_common_clipboard)                   \
   V(atom_common_crash_reporter)              \
@@ -163,12 +166,14 @@ NodeBindings::NodeBindings(BrowserEnvironment browser_env)
 
 NodeBindings::~NodeBindings() {
   // Quit the embed thread.
-  embed_closed_ = true;
-  uv_sem_post(&embed_sem_);
-  WakeupEmbedThread();
+  if (embed_thread_started_) {
+    embed_closed_ = true;
+    uv_sem_post(&embed_sem_);
+    WakeupEmbedThread();
 
-  // Wait for everything to be done.
-  uv_thread_join(&embed_thread_);
+    // Wait for everything to be done.
+    uv_thread_join(&embed_thread_);
+  }
 
   // Clear uv.
   uv_sem_destroy(&embed_sem_);
@@ -232,6 +237,7 @@ void NodeBindings::Initialize() {
 node::Environment* NodeBindings::CreateEnvironment(
     v8::Handle<v8::Context> context,
     node::MultiIsolatePlatform* platform) {
+  ScopedStartupPhase phase("CreateEnvironment");
 #if defined(OS_WIN)
   auto& atom_args = AtomCommandLine::argv();
   std::vector<std::string> args(atom_args.size());
@@ -291,6 +297,7 @@ node::Environment* NodeBindings::CreateEnvironment(
 }
 
 void NodeBindings::LoadEnvironment(node::Environment* env) {
+  ScopedStartupPhase phase("LoadEnvironment");
   node::LoadEnvironment(env);
   mate::EmitEvent(env->isolate(), env->process_object(), "loaded");
 }
@@ -302,17 +309,34 @@ void NodeBindings::PrepareMessageLoop() {
 
   // Start worker that will interrupt main loop when having uv events.
   uv_sem_init(&embed_sem_, 0);
-  uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+  if (UsesEmbedThread()) {
+    uv_thread_create(&embed_thread_, EmbedThreadRunner, this);
+    embed_thread_started_ = true;
+  }
 }
 
 void NodeBindings::RunMessageLoop() {
   // The MessageLoop should have been created, remember the one in main thread.
-  task_runner_ = base::ThreadTaskRunnerHandle::Get();
+  {
+    base::AutoLock auto_lock(task_runner_lock_);
+    task_runner_ = base::ThreadTaskRunnerHandle::Get();
+  }
 
   // Run uv loop for once to give the uv__io_poll a chance to add all events.
   UvRunOnce();
 }
 
+void NodeBindings::DetachFromThread() {
+  DCHECK_EQ(browser_env_, WORKER);
+  set_uv_env(nullptr);
+
+  // Wakeups already posted to this thread are dropped, later ones wait for
+  // the next RunMessageLoop, whose UvRunOnce releases the embed thread.
+  base::AutoLock auto_lock(task_runner_lock_);
+  weak_factory_.InvalidateWeakPtrs();
+  task_runner_ = nullptr;
+}
+
 void NodeBindings::UvRunOnce() {
   node::Environment* env = uv_env();
 
@@ -345,12 +369,30 @@ void NodeBindings::UvRunOnce() {
   if (r == 0)
     base::RunLoop().QuitWhenIdle();  // Quit from uv.
 
-  // Tell the worker thread to continue polling.
-  uv_sem_post(&embed_sem_);
+  // Tell the worker thread to continue polling. Bindings reused by a WORKER
+  // may be detached while the embed thread is still polling, it must not be
+  // released twice.
+  if (embed_thread_started_) {
+    base::AutoLock auto_lock(task_runner_lock_);
+    if (embed_waiting_) {
+      embed_waiting_ = false;
+      uv_sem_post(&embed_sem_);
+    }
+  }
+
+  DidRunUvLoop();
+}
+
+bool NodeBindings::UsesEmbedThread() const {
+  return true;
 }
 
 void NodeBindings::WakeupMainThread() {
-  DCHECK(task_runner_);
+  base::AutoLock auto_lock(task_runner_lock_);
+  embed_waiting_ = true;
+  // Detached, RunMessageLoop will run the uv loop.
+  if (!task_runner_)
+    return;
   task_runner_->PostTask(FROM_HERE, base::BindOnce(&NodeBindings::UvRunOnce,
                                                    weak_factory_.GetWeakPtr()));
 }
@@ -362,6 +404,7 @@ void NodeBindings::WakeupEmbedThread() {
 // static
 void NodeBindings::EmbedThreadRunner(void* arg) {
   NodeBindings* self = static_cast<NodeBindings*>(arg);
+  base::PlatformThread::SetName("NodeEmbedThread");
 
   while (true) {
     // Wait for the main loop to deal with events.
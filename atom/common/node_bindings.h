@@ -9,6 +9,7 @@
 #include "base/macros.h"
 #include "base/memory/weak_ptr.h"
 #include "base/single_thread_task_runner.h"
+#include "base/synchronization/lock.h"
 #include "uv.h"  // NOLINT(build/include)
 #include "v8/include/v8.h"
 
@@ -55,6 +56,10 @@ class NodeBindings {
   // Do message loop integration.
   virtual void RunMessageLoop();
 
+  // Stop running the uv loop on the current thread, the bindings of a WORKER
+  // can then be reused on another thread by calling RunMessageLoop there.
+  void DetachFromThread();
+
   // Gets/sets the environment to wrap uv loop.
   void set_uv_env(node::Environment* env) { uv_env_ = env; }
   node::Environment* uv_env() const { return uv_env_; }
@@ -70,6 +75,13 @@ class NodeBindings {
   // Run the libuv loop for once.
   void UvRunOnce();
 
+  // Whether uv events are polled by the embed thread, derived classes that
+  // watch the uv loop from the message loop return false.
+  virtual bool UsesEmbedThread() const;
+
+  // Called after each UvRunOnce.
+  virtual void DidRunUvLoop() {}
+
   // Make the main thread run libuv loop.
   void WakeupMainThread();
 
@@ -82,6 +94,11 @@ class NodeBindings {
   // Current thread's MessageLoop.
   scoped_refptr<base::SingleThreadTaskRunner> task_runner_;
 
+  // Guards |task_runner_|, |embed_waiting_| and the weak pointers used by the
+  // embed thread, which change when a WORKER's bindings move to another
+  // thread.
+  base::Lock task_runner_lock_;
+
   // Current thread's libuv loop.
   uv_loop_t* uv_loop_;
 
@@ -92,6 +109,9 @@ class NodeBindings {
   // Whether the libuv loop has ended.
   bool embed_closed_ = false;
 
+  // Whether the embed thread has been created.
+  bool embed_thread_started_ = false;
+
   // Loop used when constructed in WORKER mode
   uv_loop_t worker_loop_;
 
@@ -104,6 +124,10 @@ class NodeBindings {
   // Semaphore to wait for main loop in the embed thread.
   uv_sem_t embed_sem_;
 
+  // Whether the embed thread waits on |embed_sem_|, it starts waiting before
+  // its first poll and after each wakeup of the main thread.
+  bool embed_waiting_ = true;
+
   // Environment that to wrap the uv loop.
   node::Environment* uv_env_ = nullptr;
 
@@ -6,10 +6,21 @@
 
 #include <sys/epoll.h>
 
+#include "atom/common/options_switches.h"
+#include "base/bind.h"
+#include "base/command_line.h"
+
 namespace atom {
 
 NodeBindingsLinux::NodeBindingsLinux(BrowserEnvironment browser_env)
-    : NodeBindings(browser_env), epoll_(epoll_create(1)) {
+    : NodeBindings(browser_env),
+      epoll_(epoll_create(1)),
+      // Worker threads have no FileDescriptorWatcher, so they keep polling
+      // from the embed thread.
+      use_message_pump_(browser_env != WORKER &&
+                        base::CommandLine::ForCurrentProcess()->HasSwitch(
+                            switches::kUvMessagePump)),
+      weak_factory_(this) {
   int backend_fd = uv_backend_fd(uv_loop_);
   struct epoll_event ev = {0};
   ev.events = EPOLLIN;
@@ -24,13 +35,48 @@ void NodeBindingsLinux::RunMessageLoop() {
   uv_loop_->data = this;
   uv_loop_->on_watcher_queue_updated = OnWatcherQueueChanged;
 
+  // uv's backend fd is an epoll fd, it becomes readable whenever one of the
+  // fds watched by uv has events, so the message loop can watch it directly.
+  if (use_message_pump_)
+    backend_fd_watcher_ = base::FileDescriptorWatcher::WatchReadable(
+        uv_backend_fd(uv_loop_),
+        base::BindRepeating(&NodeBindingsLinux::OnBackendFdReadable,
+                            weak_factory_.GetWeakPtr()));
+
   NodeBindings::RunMessageLoop();
 }
 
+bool NodeBindingsLinux::UsesEmbedThread() const {
+  return !use_message_pump_;
+}
+
+void NodeBindingsLinux::DidRunUvLoop() {
+  if (!use_message_pump_)
+    return;
+
+  // Map the next expiring uv timer onto a delayed task.
+  uv_timer_.Cancel();
+  int timeout = uv_backend_timeout(uv_loop_);
+  if (timeout == 0) {
+    ScheduleUvRunOnce();
+  } else if (timeout > 0) {
+    uv_timer_.Reset(base::Bind(&NodeBindingsLinux::UvRunOnce,
+                               weak_factory_.GetWeakPtr()));
+    task_runner_->PostDelayedTask(FROM_HERE, uv_timer_.callback(),
+                                  base::TimeDelta::FromMilliseconds(timeout));
+  }
+}
+
 // static
 void NodeBindingsLinux::OnWatcherQueueChanged(uv_loop_t* loop) {
   NodeBindingsLinux* self = static_cast<NodeBindingsLinux*>(loop->data);
 
+  // New watchers are only added to the epoll set when the uv loop runs.
+  if (self->use_message_pump_) {
+    self->ScheduleUvRunOnce();
+    return;
+  }
+
   // We need to break the io polling in the epoll thread when loop's watcher
   // queue changes, otherwise new events cannot be notified.
   self->WakeupEmbedThread();
@@ -47,6 +93,27 @@ void NodeBindingsLinux::PollEvents() {
   } while (r == -1 && errno == EINTR);
 }
 
+void NodeBindingsLinux::OnBackendFdReadable() {
+  UvRunOnce();
+}
+
+void NodeBindingsLinux::ScheduleUvRunOnce() {
+  // Watchers queued before RunMessageLoop are picked up by its first
+  // UvRunOnce.
+  if (uv_run_scheduled_ || !task_runner_)
+    return;
+
+  uv_run_scheduled_ = true;
+  task_runner_->PostTask(
+      FROM_HERE, base::BindOnce(&NodeBindingsLinux::RunScheduledUvRunOnce,
+                                weak_factory_.GetWeakPtr()));
+}
+
+void NodeBindingsLinux::RunScheduledUvRunOnce() {
+  uv_run_scheduled_ = false;
+  UvRunOnce();
+}
+
 // static
 NodeBindings* NodeBindings::Create(BrowserEnvironment browser_env) {
   return new NodeBindingsLinux(browser_env);
@@ -5,8 +5,12 @@
 #ifndef ATOM_COMMON_NODE_BINDINGS_LINUX_H_
 #define ATOM_COMMON_NODE_BINDINGS_LINUX_H_
 
+#include <memory>
+
 #include "atom/common/node_bindings.h"
+#include "base/cancelable_callback.h"
 #include "base/compiler_specific.h"
+#include "base/files/file_descriptor_watcher_posix.h"
 
 namespace atom {
 
@@ -17,15 +21,40 @@ class NodeBindingsLinux : public NodeBindings {
 
   void RunMessageLoop() override;
 
+ protected:
+  bool UsesEmbedThread() const override;
+  void DidRunUvLoop() override;
+
  private:
   // Called when uv's watcher queue changes.
   static void OnWatcherQueueChanged(uv_loop_t* loop);
 
   void PollEvents() override;
 
+  // Called by the message loop when uv's backend fd has events.
+  void OnBackendFdReadable();
+
+  // Runs the uv loop from the message loop, coalescing repeated requests.
+  void ScheduleUvRunOnce();
+  void RunScheduledUvRunOnce();
+
   // Epoll to poll for uv's backend fd.
   int epoll_;
 
+  // Whether the uv loop is driven by the message loop, see --uv-message-pump.
+  bool use_message_pump_;
+
+  // Watches uv's backend fd when |use_message_pump_| is set.
+  std::unique_ptr<base::FileDescriptorWatcher::Controller> backend_fd_watcher_;
+
+  // Delayed task for the next expiring uv timer.
+  base::CancelableClosure uv_timer_;
+
+  // Whether a UvRunOnce has been posted and not run yet.
+  bool uv_run_scheduled_ = false;
+
+  base::WeakPtrFactory<NodeBindingsLinux> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(NodeBindingsLinux);
 };
 
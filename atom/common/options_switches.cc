@@ -134,6 +134,9 @@ const char kDisableBlinkFeatures[] = "disableBlinkFeatures";
 // Enable the node integration in WebWorker.
 const char kNodeIntegrationInWorker[] = "nodeIntegrationInWorker";
 
+// Number of node environments of finished WebWorkers kept for new ones.
+const char kNodeWorkerPoolSize[] = "nodeWorkerPoolSize";
+
 // Enable the web view tag.
 const char kWebviewTag[] = "webviewTag";
 
@@ -204,6 +207,9 @@ const char kWebviewTag[] = "webview-tag";
 // Command switch passed to renderer process to control nodeIntegration.
 const char kNodeIntegrationInWorker[] = "node-integration-in-worker";
 
+// Number of node environments of finished WebWorkers kept for new ones.
+const char kNodeWorkerPoolSize[] = "node-worker-pool-size";
+
 // Widevine options
 // Path to Widevine CDM binaries.
 const char kWidevineCdmPath[] = "widevine-cdm-path";
@@ -216,6 +222,12 @@ const char kDiskCacheSize[] = "disk-cache-size";
 // Ignore the limit of 6 connections per host.
 const char kIgnoreConnectionsLimit[] = "ignore-connections-limit";
 
+// Directory where renderers persist the code cache of Electron's scripts.
+const char kCodeCachePath[] = "code-cache-path";
+
+// Poll libuv's backend fd from the message loop instead of a dedicated thread.
+const char kUvMessagePump[] = "uv-message-pump";
+
 }  // namespace switches
 
 }  // namespace atom
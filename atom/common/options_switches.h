@@ -66,6 +66,7 @@ extern const char kScrollBounce[];
 extern const char kEnableBlinkFeatures[];
 extern const char kDisableBlinkFeatures[];
 extern const char kNodeIntegrationInWorker[];
+extern const char kNodeWorkerPoolSize[];
 extern const char kWebviewTag[];
 extern const char kNativeWindowOpen[];
 extern const char kCustomArgs[];
@@ -104,6 +105,7 @@ extern const char kScrollBounce[];
 extern const char kHiddenPage[];
 extern const char kNativeWindowOpen[];
 extern const char kNodeIntegrationInWorker[];
+extern const char kNodeWorkerPoolSize[];
 extern const char kWebviewTag[];
 
 extern const char kWidevineCdmPath[];
@@ -112,6 +114,9 @@ extern const char kWidevineCdmVersion[];
 extern const char kDiskCacheSize[];
 extern const char kIgnoreConnectionsLimit[];
 
+extern const char kCodeCachePath[];
+extern const char kUvMessagePump[];
+
 }  // namespace switches
 
 }  // namespace atom
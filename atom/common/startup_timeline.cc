@@ -0,0 +1,58 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "atom/common/startup_timeline.h"
+
+#include "base/lazy_instance.h"
+#include "base/synchronization/lock.h"
+#include "base/trace_event/trace_event.h"
+
+namespace atom {
+
+namespace {
+
+// Phases like DidCreateScriptContext repeat on every navigation, only keep
+// the first ones.
+const size_t kMaxPhases = 100;
+
+struct StartupTimeline {
+  base::Lock lock;
+  std::vector<StartupPhase> phases;
+};
+
+base::LazyInstance<StartupTimeline>::Leaky g_startup_timeline =
+    LAZY_INSTANCE_INITIALIZER;
+
+void AddPhase(const char* name, base::TimeTicks start, base::TimeTicks end) {
+  StartupTimeline* timeline = g_startup_timeline.Pointer();
+  base::AutoLock auto_lock(timeline->lock);
+  if (timeline->phases.size() < kMaxPhases)
+    timeline->phases.push_back({name, start, end});
+}
+
+}  // namespace
+
+ScopedStartupPhase::ScopedStartupPhase(const char* name)
+    : name_(name), start_(base::TimeTicks::Now()) {
+  TRACE_EVENT_BEGIN0("startup", name_);
+}
+
+ScopedStartupPhase::~ScopedStartupPhase() {
+  TRACE_EVENT_END0("startup", name_);
+  AddPhase(name_, start_, base::TimeTicks::Now());
+}
+
+void RecordStartupMark(const char* name) {
+  TRACE_EVENT_INSTANT0("startup", name, TRACE_EVENT_SCOPE_PROCESS);
+  base::TimeTicks now = base::TimeTicks::Now();
+  AddPhase(name, now, now);
+}
+
+std::vector<StartupPhase> GetStartupTimeline() {
+  StartupTimeline* timeline = g_startup_timeline.Pointer();
+  base::AutoLock auto_lock(timeline->lock);
+  return timeline->phases;
+}
+
+}  // namespace atom
@@ -0,0 +1,45 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef ATOM_COMMON_STARTUP_TIMELINE_H_
+#define ATOM_COMMON_STARTUP_TIMELINE_H_
+
+#include <vector>
+
+#include "base/macros.h"
+#include "base/time/time.h"
+
+namespace atom {
+
+struct StartupPhase {
+  // Always a string literal.
+  const char* name;
+  base::TimeTicks start;
+  base::TimeTicks end;
+};
+
+// Records the phase |name| of the process startup for the lifetime of this
+// object, in the startup timeline and as a trace event in the "startup"
+// category. |name| must be a string literal.
+class ScopedStartupPhase {
+ public:
+  explicit ScopedStartupPhase(const char* name);
+  ~ScopedStartupPhase();
+
+ private:
+  const char* name_;
+  base::TimeTicks start_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedStartupPhase);
+};
+
+// Records a point of the startup that has no duration.
+void RecordStartupMark(const char* name);
+
+// Returns the recorded phases in the order they finished.
+std::vector<StartupPhase> GetStartupTimeline();
+
+}  // namespace atom
+
+#endif  // ATOM_COMMON_STARTUP_TIMELINE_H_
@@ -5,8 +5,12 @@
 #include "atom/renderer/api/atom_api_spell_check_client.h"
 
 #include <algorithm>
+#include <set>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
+#include "atom/common/native_mate_converters/callback.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "base/logging.h"
 #include "base/threading/thread_task_runner_handle.h"
@@ -23,6 +27,9 @@ namespace api {
 
 namespace {
 
+// Maximum number of words whose spelling is remembered.
+const size_t kWordCacheSize = 8192;
+
 bool HasWordCharacters(const base::string16& text, int index) {
   const base::char16* data = text.data();
   int length = text.length();
@@ -40,22 +47,39 @@ bool HasWordCharacters(const base::string16& text, int index) {
 
 class SpellCheckClient::SpellcheckRequest {
  public:
-  SpellcheckRequest(const base::string16& text,
+  // A word found in the text, it is misspelled when neither the word nor all
+  // of its contraction |components| are spelled correctly.
+  struct Occurrence {
+    blink::WebTextCheckingResult range;
+    base::string16 word;
+    std::vector<base::string16> components;
+  };
+
+  SpellcheckRequest(int id,
+                    const base::string16& text,
                     blink::WebTextCheckingCompletion* completion)
-      : text_(text), completion_(completion) {
+      : id_(id), text_(text), completion_(completion) {
     DCHECK(completion);
   }
   ~SpellcheckRequest() {}
 
+  int id() const { return id_; }
   base::string16 text() { return text_; }
   blink::WebTextCheckingCompletion* completion() { return completion_; }
+  std::vector<Occurrence>* occurrences() { return &occurrences_; }
+  std::vector<base::string16>* words() { return &words_; }
 
  private:
+  int id_;
   base::string16 text_;  // Text to be checked in this task.
 
   // The interface to send the misspelled ranges to WebKit.
   blink::WebTextCheckingCompletion* completion_;
 
+  // Words found in |text_| and the words sent to JavaScript.
+  std::vector<Occurrence> occurrences_;
+  std::vector<base::string16> words_;
+
   DISALLOW_COPY_AND_ASSIGN(SpellcheckRequest);
 };
 
@@ -63,22 +87,28 @@ SpellCheckClient::SpellCheckClient(const std::string& language,
                                    bool auto_spell_correct_turned_on,
                                    v8::Isolate* isolate,
                                    v8::Local<v8::Object> provider)
-    : isolate_(isolate),
+    : word_cache_(kWordCacheSize),
+      isolate_(isolate),
       context_(isolate, isolate->GetCurrentContext()),
       provider_(isolate, provider) {
   DCHECK(!context_.IsEmpty());
 
   character_attributes_.SetDefaultLanguage(language);
 
-  // Persistent the method.
+  // Persistent the methods.
   mate::Dictionary dict(isolate, provider);
   dict.Get("spellCheck", &spell_check_);
+  dict.Get("spellCheckWords", &spell_check_words_);
 }
 
 SpellCheckClient::~SpellCheckClient() {
   context_.Reset();
 }
 
+void SpellCheckClient::ClearWordCache() {
+  word_cache_.Clear();
+}
+
 void SpellCheckClient::CheckSpelling(
     const blink::WebString& text,
     int& misspelling_start,
@@ -107,12 +137,13 @@ void SpellCheckClient::RequestCheckingOfText(
     pending_request_param_->completion()->DidCancelCheckingText();
   }
 
-  pending_request_param_.reset(new SpellcheckRequest(text, completionCallback));
+  int request_id = ++next_request_id_;
+  pending_request_param_.reset(
+      new SpellcheckRequest(request_id, text, completionCallback));
 
   base::ThreadTaskRunnerHandle::Get()->PostTask(
-      FROM_HERE,
-      base::BindOnce(&SpellCheckClient::PerformSpellCheck, AsWeakPtr(),
-                     base::Owned(pending_request_param_.release())));
+      FROM_HERE, base::BindOnce(&SpellCheckClient::PerformSpellCheck,
+                                AsWeakPtr(), request_id));
 }
 
 bool SpellCheckClient::IsSpellCheckingEnabled() const {
@@ -132,22 +163,11 @@ void SpellCheckClient::SpellCheckText(
     const base::string16& text,
     bool stop_at_first_result,
     std::vector<blink::WebTextCheckingResult>* results) {
-  if (text.empty() || spell_check_.IsEmpty())
+  if (text.empty() || (spell_check_.IsEmpty() && spell_check_words_.IsEmpty()))
     return;
 
-  if (!text_iterator_.IsInitialized() &&
-      !text_iterator_.Initialize(&character_attributes_, true)) {
-    // We failed to initialize text_iterator_, return as spelled correctly.
-    VLOG(1) << "Failed to initialize SpellcheckWordIterator";
-    return;
-  }
-
-  if (!contraction_iterator_.IsInitialized() &&
-      !contraction_iterator_.Initialize(&character_attributes_, false)) {
-    // We failed to initialize the word iterator, return as spelled correctly.
-    VLOG(1) << "Failed to initialize contraction_iterator_";
+  if (!InitializeIterators())
     return;
-  }
 
   text_iterator_.SetText(text.c_str(), text.size());
 
@@ -182,10 +202,32 @@ void SpellCheckClient::SpellCheckText(
   }
 }
 
-bool SpellCheckClient::SpellCheckWord(
-    const SpellCheckScope& scope,
-    const base::string16& word_to_check) const {
-  DCHECK(!scope.spell_check_.IsEmpty());
+bool SpellCheckClient::InitializeIterators() {
+  if (!text_iterator_.IsInitialized() &&
+      !text_iterator_.Initialize(&character_attributes_, true)) {
+    // We failed to initialize text_iterator_, return as spelled correctly.
+    VLOG(1) << "Failed to initialize SpellcheckWordIterator";
+    return false;
+  }
+
+  if (!contraction_iterator_.IsInitialized() &&
+      !contraction_iterator_.Initialize(&character_attributes_, false)) {
+    // We failed to initialize the word iterator, return as spelled correctly.
+    VLOG(1) << "Failed to initialize contraction_iterator_";
+    return false;
+  }
+
+  return true;
+}
+
+bool SpellCheckClient::SpellCheckWord(const SpellCheckScope& scope,
+                                      const base::string16& word_to_check) {
+  // Only the batch provider is available, which can not answer
+  // synchronously, use what it reported before.
+  if (scope.spell_check_.IsEmpty()) {
+    auto cached = word_cache_.Get(word_to_check);
+    return cached == word_cache_.end() || cached->second;
+  }
 
   v8::Local<v8::Value> word = mate::ConvertToV8(isolate_, word_to_check);
   v8::Local<v8::Value> result =
@@ -203,6 +245,18 @@ bool SpellCheckClient::SpellCheckWord(
 // (e.g. "in'n'out") but each word is valid.
 bool SpellCheckClient::IsValidContraction(const SpellCheckScope& scope,
                                           const base::string16& contraction) {
+  std::vector<base::string16> components;
+  GetContractionWords(contraction, &components);
+  for (const auto& word : components) {
+    if (!SpellCheckWord(scope, word))
+      return false;
+  }
+  return true;
+}
+
+bool SpellCheckClient::GetContractionWords(
+    const base::string16& contraction,
+    std::vector<base::string16>* components) {
   DCHECK(contraction_iterator_.IsInitialized());
 
   contraction_iterator_.SetText(contraction.c_str(), contraction.length());
@@ -219,27 +273,132 @@ bool SpellCheckClient::IsValidContraction(const SpellCheckScope& scope,
     if (status == SpellcheckWordIterator::IS_SKIPPABLE)
       continue;
 
-    if (!SpellCheckWord(scope, word))
-      return false;
+    components->push_back(word);
   }
-  return true;
+  return !components->empty();
 }
 
-void SpellCheckClient::PerformSpellCheck(SpellcheckRequest* param) {
-  DCHECK(param);
+void SpellCheckClient::PerformSpellCheck(int request_id) {
+  // The request has been replaced by a newer one.
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
 
+  if (!spell_check_words_.IsEmpty() && InitializeIterators()) {
+    SpellCheckScope scope(*this);
+    PerformBatchSpellCheck(scope);
+    return;
+  }
+
+  std::unique_ptr<SpellcheckRequest> param(std::move(pending_request_param_));
   std::vector<blink::WebTextCheckingResult> results;
   SpellCheckText(param->text(), false, &results);
   param->completion()->DidFinishCheckingText(results);
 }
 
+void SpellCheckClient::PerformBatchSpellCheck(const SpellCheckScope& scope) {
+  DCHECK(pending_request_param_);
+  DCHECK(!scope.spell_check_words_.IsEmpty());
+
+  const base::string16 text = pending_request_param_->text();
+  auto* occurrences = pending_request_param_->occurrences();
+  std::set<base::string16> unknown_words;
+  auto add_word = [&](const base::string16& word) {
+    if (word_cache_.Get(word) == word_cache_.end())
+      unknown_words.insert(word);
+  };
+
+  text_iterator_.SetText(text.c_str(), text.size());
+
+  base::string16 word;
+  int word_start;
+  int word_length;
+  for (auto status =
+           text_iterator_.GetNextWord(&word, &word_start, &word_length);
+       status != SpellcheckWordIterator::IS_END_OF_TEXT;
+       status = text_iterator_.GetNextWord(&word, &word_start, &word_length)) {
+    if (status == SpellcheckWordIterator::IS_SKIPPABLE)
+      continue;
+
+    SpellcheckRequest::Occurrence occurrence;
+    occurrence.range.location = word_start;
+    occurrence.range.length = word_length;
+    occurrence.word = word;
+    GetContractionWords(word, &occurrence.components);
+
+    add_word(occurrence.word);
+    for (const auto& component : occurrence.components)
+      add_word(component);
+    occurrences->push_back(std::move(occurrence));
+  }
+
+  // Every word is known, there is no need to wait for JavaScript.
+  if (unknown_words.empty()) {
+    FinishPendingRequest();
+    return;
+  }
+
+  auto* words = pending_request_param_->words();
+  words->assign(unknown_words.begin(), unknown_words.end());
+
+  v8::Local<v8::Value> args[] = {
+      mate::ConvertToV8(isolate_, *words),
+      mate::ConvertToV8(
+          isolate_,
+          base::Bind(&SpellCheckClient::OnBatchSpellCheckDone, AsWeakPtr(),
+                     pending_request_param_->id()))};
+  // The callback may be invoked synchronously, so nothing in the pending
+  // request can be touched after this call.
+  scope.spell_check_words_->Call(scope.provider_, arraysize(args), args);
+}
+
+void SpellCheckClient::OnBatchSpellCheckDone(
+    int request_id,
+    const std::vector<base::string16>& misspelled) {
+  if (!pending_request_param_ || pending_request_param_->id() != request_id)
+    return;
+
+  std::unordered_set<base::string16> misspelled_words(misspelled.begin(),
+                                                      misspelled.end());
+  for (const auto& word : *pending_request_param_->words())
+    word_cache_.Put(word, misspelled_words.count(word) == 0);
+
+  FinishPendingRequest();
+}
+
+void SpellCheckClient::FinishPendingRequest() {
+  std::unique_ptr<SpellcheckRequest> param(std::move(pending_request_param_));
+  DCHECK(param);
+
+  auto is_correct = [this](const base::string16& word) {
+    auto cached = word_cache_.Get(word);
+    return cached == word_cache_.end() || cached->second;
+  };
+
+  std::vector<blink::WebTextCheckingResult> results;
+  for (const auto& occurrence : *param->occurrences()) {
+    if (is_correct(occurrence.word))
+      continue;
+
+    // If the given word is a concatenated word of two or more valid words
+    // (e.g. "hello:hello"), we should treat it as a valid word. Like
+    // IsValidContraction, a word without components is valid.
+    if (std::all_of(occurrence.components.begin(),
+                    occurrence.components.end(), is_correct))
+      continue;
+
+    results.push_back(occurrence.range);
+  }
+  param->completion()->DidFinishCheckingText(results);
+}
+
 SpellCheckClient::SpellCheckScope::SpellCheckScope(
     const SpellCheckClient& client)
     : handle_scope_(client.isolate_),
       context_scope_(
           v8::Local<v8::Context>::New(client.isolate_, client.context_)),
       provider_(client.provider_.NewHandle()),
-      spell_check_(client.spell_check_.NewHandle()) {}
+      spell_check_(client.spell_check_.NewHandle()),
+      spell_check_words_(client.spell_check_words_.NewHandle()) {}
 
 SpellCheckClient::SpellCheckScope::~SpellCheckScope() = default;
 
@@ -10,6 +10,7 @@
 #include <vector>
 
 #include "base/callback.h"
+#include "base/containers/mru_cache.h"
 #include "base/memory/weak_ptr.h"
 #include "chrome/renderer/spellchecker/spellcheck_worditerator.h"
 #include "native_mate/scoped_persistent.h"
@@ -36,6 +37,9 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
                    v8::Local<v8::Object> provider);
   ~SpellCheckClient() override;
 
+  // Forgets the spelling of words reported by the batch provider.
+  void ClearWordCache();
+
  private:
   class SpellcheckRequest;
   // blink::WebTextCheckClient:
@@ -60,6 +64,7 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
     v8::Context::Scope context_scope_;
     v8::Local<v8::Object> provider_;
     v8::Local<v8::Function> spell_check_;
+    v8::Local<v8::Function> spell_check_words_;
 
     explicit SpellCheckScope(const SpellCheckClient& client);
     ~SpellCheckScope();
@@ -70,17 +75,39 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
                       bool stop_at_first_result,
                       std::vector<blink::WebTextCheckingResult>* results);
 
-  // Call JavaScript to check spelling a word.
+  // Call JavaScript to check spelling a word, with only the batch provider
+  // the spelling is taken from |word_cache_|.
   bool SpellCheckWord(const SpellCheckScope& scope,
-                      const base::string16& word_to_check) const;
+                      const base::string16& word_to_check);
 
   // Returns whether or not the given word is a contraction of valid words
   // (e.g. "word:word").
   bool IsValidContraction(const SpellCheckScope& scope,
                           const base::string16& word);
 
+  // Splits the given contraction into its component words, returns false if
+  // the word is not a contraction.
+  bool GetContractionWords(const base::string16& word,
+                           std::vector<base::string16>* components);
+
+  // Returns whether the |text_iterator_| and |contraction_iterator_| are
+  // ready to be used.
+  bool InitializeIterators();
+
   // Performs spell checking from the request queue.
-  void PerformSpellCheck(SpellcheckRequest* param);
+  void PerformSpellCheck(int request_id);
+
+  // Collects the unknown words of the pending request and sends them to
+  // JavaScript in one batch.
+  void PerformBatchSpellCheck(const SpellCheckScope& scope);
+
+  // Called by JavaScript with the misspelled words of the batch identified by
+  // |request_id|.
+  void OnBatchSpellCheckDone(int request_id,
+                             const std::vector<base::string16>& misspelled);
+
+  // Resolves the pending request using only the results in |word_cache_|.
+  void FinishPendingRequest();
 
   // Represents character attributes used for filtering out characters which
   // are not supported by this SpellCheck object.
@@ -99,10 +126,19 @@ class SpellCheckClient : public blink::WebSpellCheckPanelHostClient,
   // requests so we do not have to use vectors.)
   std::unique_ptr<SpellcheckRequest> pending_request_param_;
 
+  // Identifies the pending request, results of older requests are dropped.
+  int next_request_id_ = 0;
+
+  // Spelling of the words checked by the batch provider, so repeated words
+  // are not sent to JavaScript again. The results of spellCheck are not
+  // cached, it is asked for every word.
+  base::MRUCache<base::string16, bool> word_cache_;
+
   v8::Isolate* isolate_;
   v8::Persistent<v8::Context> context_;
   mate::ScopedPersistent<v8::Object> provider_;
   mate::ScopedPersistent<v8::Function> spell_check_;
+  mate::ScopedPersistent<v8::Function> spell_check_words_;
 
   DISALLOW_COPY_AND_ASSIGN(SpellCheckClient);
 };
@@ -217,8 +217,10 @@ void WebFrame::SetSpellCheckProvider(mate::Arguments* args,
                                      const std::string& language,
                                      bool auto_spell_correct_turned_on,
                                      v8::Local<v8::Object> provider) {
-  if (!provider->Has(mate::StringToV8(args->isolate(), "spellCheck"))) {
-    args->ThrowError("\"spellCheck\" has to be defined");
+  if (!provider->Has(mate::StringToV8(args->isolate(), "spellCheck")) &&
+      !provider->Has(mate::StringToV8(args->isolate(), "spellCheckWords"))) {
+    args->ThrowError(
+        "\"spellCheck\" or \"spellCheckWords\" has to be defined");
     return;
   }
 
@@ -233,6 +235,11 @@ void WebFrame::SetSpellCheckProvider(mate::Arguments* args,
   web_frame_->SetSpellCheckPanelHostClient(spell_check_client_.get());
 }
 
+void WebFrame::ClearSpellCheckCache() {
+  if (spell_check_client_)
+    spell_check_client_->ClearWordCache();
+}
+
 void WebFrame::RegisterURLSchemeAsBypassingCSP(const std::string& scheme) {
   // Register scheme to bypass pages's Content Security Policy.
   blink::SchemeRegistry::RegisterURLSchemeAsBypassingContentSecurityPolicy(
@@ -493,6 +500,7 @@ void WebFrame::BuildPrototype(v8::Isolate* isolate,
                  &WebFrame::RegisterEmbedderCustomElement)
       .SetMethod("getWebFrameId", &WebFrame::GetWebFrameId)
       .SetMethod("setSpellCheckProvider", &WebFrame::SetSpellCheckProvider)
+      .SetMethod("clearSpellCheckCache", &WebFrame::ClearSpellCheckCache)
       .SetMethod("registerURLSchemeAsBypassingCSP",
                  &WebFrame::RegisterURLSchemeAsBypassingCSP)
       .SetMethod("registerURLSchemeAsPrivileged",
@@ -61,6 +61,9 @@ class WebFrame : public mate::Wrappable<WebFrame> {
                              bool auto_spell_correct_turned_on,
                              v8::Local<v8::Object> provider);
 
+  // Forget the spelling of words reported by spellCheckWords.
+  void ClearSpellCheckCache();
+
   void RegisterURLSchemeAsBypassingCSP(const std::string& scheme);
   void RegisterURLSchemeAsPrivileged(const std::string& scheme,
                                      mate::Arguments* args);
@@ -4,16 +4,19 @@
 
 #include "atom/renderer/atom_render_frame_observer.h"
 
+#include <algorithm>
 #include <string>
 #include <vector>
 
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/event_emitter_caller.h"
+#include "atom/common/cpu_profile.h"
 #include "atom/common/heap_snapshot.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_includes.h"
+#include "base/bind.h"
 #include "base/strings/string_number_conversions.h"
-#include "base/threading/thread_restrictions.h"
+#include "base/threading/thread_task_runner_handle.h"
 #include "base/trace_event/trace_event.h"
 #include "content/public/renderer/render_frame.h"
 #include "content/public/renderer/render_view.h"
@@ -33,6 +36,9 @@ namespace atom {
 
 namespace {
 
+// The draggable regions are sent at most once per frame.
+const int kDraggableRegionsUpdateIntervalMs = 1000 / 60;
+
 bool GetIPCObject(v8::Isolate* isolate,
                   v8::Local<v8::Context> context,
                   v8::Local<v8::Object>* ipc) {
@@ -67,6 +73,30 @@ base::StringPiece NetResourceProvider(int key) {
   return base::StringPiece();
 }
 
+// The frame may be gone by the time the file is written.
+void SendResultMessage(int routing_id, const base::ListValue& args) {
+  auto* render_frame = content::RenderFrame::FromRoutingID(routing_id);
+  if (render_frame)
+    render_frame->Send(
+        new AtomFrameHostMsg_Message(routing_id, "ipc-message", args));
+}
+
+void SendHeapSnapshotProgress(int routing_id,
+                              const std::string& channel,
+                              int64_t bytes_written) {
+  base::ListValue args;
+  args.AppendString(channel);
+  args.AppendDouble(static_cast<double>(bytes_written));
+  SendResultMessage(routing_id, args);
+}
+
+void SendResult(int routing_id, const std::string& channel, bool success) {
+  base::ListValue args;
+  args.AppendString(channel);
+  args.AppendBoolean(success);
+  SendResultMessage(routing_id, args);
+}
+
 }  // namespace
 
 AtomRenderFrameObserver::AtomRenderFrameObserver(
@@ -74,7 +104,8 @@ AtomRenderFrameObserver::AtomRenderFrameObserver(
     RendererClientBase* renderer_client)
     : content::RenderFrameObserver(frame),
       render_frame_(frame),
-      renderer_client_(renderer_client) {
+      renderer_client_(renderer_client),
+      weak_factory_(this) {
   // Initialise resource for directory listing.
   net::NetModule::SetResourceProvider(NetResourceProvider);
 }
@@ -101,6 +132,26 @@ void AtomRenderFrameObserver::DidCreateScriptContext(
 }
 
 void AtomRenderFrameObserver::DraggableRegionsChanged() {
+  // Layout can change the regions many times per frame, only the latest
+  // regions are sent.
+  if (draggable_regions_update_pending_)
+    return;
+  draggable_regions_update_pending_ = true;
+  base::TimeDelta delay =
+      last_draggable_regions_update_ +
+      base::TimeDelta::FromMilliseconds(kDraggableRegionsUpdateIntervalMs) -
+      base::TimeTicks::Now();
+  base::ThreadTaskRunnerHandle::Get()->PostDelayedTask(
+      FROM_HERE,
+      base::BindOnce(&AtomRenderFrameObserver::SendDraggableRegions,
+                     weak_factory_.GetWeakPtr()),
+      std::max(delay, base::TimeDelta()));
+}
+
+void AtomRenderFrameObserver::SendDraggableRegions() {
+  draggable_regions_update_pending_ = false;
+  last_draggable_regions_update_ = base::TimeTicks::Now();
+
   blink::WebVector<blink::WebDraggableRegion> webregions =
       render_frame_->GetWebFrame()->GetDocument().DraggableRegions();
   std::vector<DraggableRegion> regions;
@@ -112,7 +163,31 @@ void AtomRenderFrameObserver::DraggableRegionsChanged() {
     region.draggable = webregion.draggable;
     regions.push_back(region);
   }
-  Send(new AtomFrameHostMsg_UpdateDraggableRegions(routing_id(), regions));
+
+  // Only send the regions that differ from the ones the browser has.
+  std::vector<DraggableRegionChange> changes;
+  for (size_t i = 0; i < regions.size(); ++i) {
+    if (i < draggable_regions_.size() && regions[i] == draggable_regions_[i])
+      continue;
+    DraggableRegionChange change;
+    change.index = static_cast<uint32_t>(i);
+    change.region = regions[i];
+    changes.push_back(change);
+  }
+  if (draggable_regions_version_ > 0 && changes.empty() &&
+      regions.size() == draggable_regions_.size())
+    return;
+
+  draggable_regions_.swap(regions);
+  Send(new AtomFrameHostMsg_UpdateDraggableRegions(
+      routing_id(), ++draggable_regions_version_,
+      static_cast<uint32_t>(draggable_regions_.size()), changes));
+}
+
+void AtomRenderFrameObserver::OnResendDraggableRegions() {
+  draggable_regions_.clear();
+  draggable_regions_version_ = 0;
+  DraggableRegionsChanged();
 }
 
 void AtomRenderFrameObserver::WillReleaseScriptContext(
@@ -164,6 +239,10 @@ bool AtomRenderFrameObserver::OnMessageReceived(const IPC::Message& message) {
   IPC_BEGIN_MESSAGE_MAP(AtomRenderFrameObserver, message)
     IPC_MESSAGE_HANDLER(AtomFrameMsg_Message, OnBrowserMessage)
     IPC_MESSAGE_HANDLER(AtomFrameMsg_TakeHeapSnapshot, OnTakeHeapSnapshot)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_StartCpuProfile, OnStartCpuProfile)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_StopCpuProfile, OnStopCpuProfile)
+    IPC_MESSAGE_HANDLER(AtomFrameMsg_ResendDraggableRegions,
+                        OnResendDraggableRegions)
     IPC_MESSAGE_UNHANDLED(handled = false)
   IPC_END_MESSAGE_MAP()
 
@@ -200,18 +279,36 @@ void AtomRenderFrameObserver::OnBrowserMessage(bool send_to_all,
 
 void AtomRenderFrameObserver::OnTakeHeapSnapshot(
     IPC::PlatformFileForTransit file_handle,
-    const std::string& channel) {
-  base::ThreadRestrictions::ScopedAllowIO allow_io;
-
-  auto file = IPC::PlatformFileForTransitToFile(file_handle);
-  bool success = TakeHeapSnapshot(blink::MainThreadIsolate(), &file);
+    const std::string& channel,
+    bool compress,
+    bool report_progress) {
+  int routing_id = render_frame_->GetRoutingID();
+  HeapSnapshotProgressCallback progress_callback;
+  if (report_progress)
+    progress_callback =
+        base::BindRepeating(&SendHeapSnapshotProgress, routing_id, channel);
+
+  TakeHeapSnapshotInBackground(
+      blink::MainThreadIsolate(),
+      IPC::PlatformFileForTransitToFile(file_handle), compress,
+      progress_callback,
+      base::BindOnce(&SendResult, routing_id, channel));
+}
 
-  base::ListValue args;
-  args.AppendString(channel);
-  args.AppendBoolean(success);
+void AtomRenderFrameObserver::OnStartCpuProfile(int sampling_interval_us,
+                                                const std::string& channel) {
+  bool success =
+      StartCpuProfile(blink::MainThreadIsolate(),
+                      base::TimeDelta::FromMicroseconds(sampling_interval_us));
+  SendResult(render_frame_->GetRoutingID(), channel, success);
+}
 
-  render_frame_->Send(new AtomFrameHostMsg_Message(
-      render_frame_->GetRoutingID(), "ipc-message", args));
+void AtomRenderFrameObserver::OnStopCpuProfile(const std::string& channel) {
+  // The browser writes the file, so it is left alone when nothing was
+  // being recorded.
+  render_frame_->Send(new AtomFrameHostMsg_CpuProfile(
+      render_frame_->GetRoutingID(), channel,
+      StopCpuProfile(blink::MainThreadIsolate())));
 }
 
 void AtomRenderFrameObserver::EmitIPCEvent(blink::WebLocalFrame* frame,
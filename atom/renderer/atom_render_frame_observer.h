@@ -6,9 +6,13 @@
 #define ATOM_RENDERER_ATOM_RENDER_FRAME_OBSERVER_H_
 
 #include <string>
+#include <vector>
 
+#include "atom/common/draggable_region.h"
 #include "atom/renderer/renderer_client_base.h"
+#include "base/memory/weak_ptr.h"
 #include "base/strings/string16.h"
+#include "base/time/time.h"
 #include "content/public/renderer/render_frame_observer.h"
 #include "ipc/ipc_platform_file.h"
 #include "third_party/blink/public/web/web_local_frame.h"
@@ -59,12 +63,26 @@ class AtomRenderFrameObserver : public content::RenderFrameObserver {
                         const base::ListValue& args,
                         int32_t sender_id);
   void OnTakeHeapSnapshot(IPC::PlatformFileForTransit file_handle,
-                          const std::string& channel);
+                          const std::string& channel,
+                          bool compress,
+                          bool report_progress);
+  void OnStartCpuProfile(int sampling_interval_us, const std::string& channel);
+  void OnStopCpuProfile(const std::string& channel);
+  void OnResendDraggableRegions();
+  void SendDraggableRegions();
 
   content::RenderFrame* render_frame_;
   RendererClientBase* renderer_client_;
   bool document_created_ = false;
 
+  // The draggable regions known by the browser and their version.
+  std::vector<DraggableRegion> draggable_regions_;
+  uint32_t draggable_regions_version_ = 0;
+  base::TimeTicks last_draggable_regions_update_;
+  bool draggable_regions_update_pending_ = false;
+
+  base::WeakPtrFactory<AtomRenderFrameObserver> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(AtomRenderFrameObserver);
 };
 
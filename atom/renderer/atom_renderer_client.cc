@@ -10,8 +10,10 @@
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/asar/asar_util.h"
+#include "atom/common/code_cache.h"
 #include "atom/common/node_bindings.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "atom/renderer/api/atom_api_renderer_ipc.h"
 #include "atom/renderer/atom_render_frame_observer.h"
 #include "atom/renderer/web_worker_observer.h"
@@ -46,6 +48,12 @@ AtomRendererClient::~AtomRendererClient() {
 
 void AtomRendererClient::RenderThreadStarted() {
   RendererClientBase::RenderThreadStarted();
+
+  // Unsandboxed renderers can share the code cache through the disk.
+  base::CommandLine* command_line = base::CommandLine::ForCurrentProcess();
+  if (command_line->HasSwitch(switches::kCodeCachePath))
+    SetCodeCacheDirectory(
+        command_line->GetSwitchValuePath(switches::kCodeCachePath));
 }
 
 void AtomRendererClient::RenderFrameCreated(
@@ -86,6 +94,7 @@ void AtomRendererClient::DidCreateScriptContext(
   if (!render_frame->IsMainFrame() && !IsDevToolsExtension(render_frame))
     return;
 
+  ScopedStartupPhase phase("DidCreateScriptContext");
   injected_frames_.insert(render_frame);
 
   // Prepare the node bindings.
@@ -187,12 +196,15 @@ void AtomRendererClient::SetupMainWorldOverrides(
   // an argument.
   std::string left = "(function (binding, require) {\n";
   std::string right = "\n})";
-  auto script = v8::Script::Compile(v8::String::Concat(
+  auto source = v8::String::Concat(
       mate::ConvertToV8(isolate, left)->ToString(),
       v8::String::Concat(node::isolated_bundle_value.ToStringChecked(isolate),
-                         mate::ConvertToV8(isolate, right)->ToString())));
-  auto func =
-      v8::Handle<v8::Function>::Cast(script->Run(context).ToLocalChecked());
+                         mate::ConvertToV8(isolate, right)->ToString()));
+  auto func = v8::Handle<v8::Function>::Cast(
+      RunScriptWithCodeCache(
+          context, source,
+          mate::StringToV8(isolate, "electron/js2c/isolated_bundle"))
+          .ToLocalChecked());
 
   auto binding = v8::Object::New(isolate);
   api::Initialize(binding, v8::Null(isolate), context, nullptr);
@@ -6,10 +6,12 @@
 
 #include "atom/common/api/api_messages.h"
 #include "atom/common/api/atom_bindings.h"
+#include "atom/common/code_cache.h"
 #include "atom/common/native_mate_converters/string16_converter.h"
 #include "atom/common/native_mate_converters/value_converter.h"
 #include "atom/common/node_bindings.h"
 #include "atom/common/options_switches.h"
+#include "atom/common/startup_timeline.h"
 #include "atom/renderer/api/atom_api_renderer_ipc.h"
 #include "atom/renderer/atom_render_frame_observer.h"
 #include "base/base_paths.h"
@@ -92,8 +94,10 @@ base::FilePath::StringType GetExecPath() {
 
 v8::Local<v8::Value> CreatePreloadScript(v8::Isolate* isolate,
                                          v8::Local<v8::String> preloadSrc) {
-  auto script = v8::Script::Compile(preloadSrc);
-  auto func = script->Run();
+  v8::Local<v8::Value> func;
+  if (!RunScriptWithCodeCache(isolate->GetCurrentContext(), preloadSrc)
+           .ToLocal(&func))
+    return v8::Undefined(isolate);
   return func;
 }
 
@@ -186,6 +190,7 @@ void AtomSandboxedRendererClient::DidCreateScriptContext(
   if (!render_frame->IsMainFrame() && !IsDevTools(render_frame))
     return;
 
+  ScopedStartupPhase phase("DidCreateScriptContext");
   auto* isolate = context->GetIsolate();
   v8::HandleScope handle_scope(isolate);
   v8::Context::Scope context_scope(context);
@@ -194,12 +199,15 @@ void AtomSandboxedRendererClient::DidCreateScriptContext(
   std::string left = "(function(binding, require) {\n";
   std::string right = "\n})";
   // Compile the wrapper and run it to get the function object
-  auto script = v8::Script::Compile(v8::String::Concat(
+  auto source = v8::String::Concat(
       mate::ConvertToV8(isolate, left)->ToString(),
       v8::String::Concat(node::preload_bundle_value.ToStringChecked(isolate),
-                         mate::ConvertToV8(isolate, right)->ToString())));
-  auto func =
-      v8::Handle<v8::Function>::Cast(script->Run(context).ToLocalChecked());
+                         mate::ConvertToV8(isolate, right)->ToString()));
+  auto func = v8::Handle<v8::Function>::Cast(
+      RunScriptWithCodeCache(
+          context, source,
+          mate::StringToV8(isolate, "electron/js2c/preload_bundle"))
+          .ToLocalChecked());
   // Create and initialize the binding object
   auto binding = v8::Object::New(isolate);
   InitializeBindings(binding, context);
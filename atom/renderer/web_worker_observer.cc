@@ -4,12 +4,20 @@
 
 #include "atom/renderer/web_worker_observer.h"
 
+#include <vector>
+
 #include "atom/common/api/atom_bindings.h"
 #include "atom/common/api/event_emitter_caller.h"
 #include "atom/common/asar/asar_util.h"
 #include "atom/common/node_bindings.h"
+#include "atom/common/options_switches.h"
+#include "base/command_line.h"
 #include "base/lazy_instance.h"
+#include "base/strings/string_number_conversions.h"
+#include "base/synchronization/lock.h"
 #include "base/threading/thread_local.h"
+#include "native_mate/dictionary.h"
+#include "native_mate/key_cache.h"
 
 #include "atom/common/node_includes.h"
 
@@ -21,37 +29,78 @@ static base::LazyInstance<
     base::ThreadLocalPointer<WebWorkerObserver>>::DestructorAtExit lazy_tls =
     LAZY_INSTANCE_INITIALIZER;
 
+// The observers of finished workers waiting for a new worker, and the
+// statistics of the workers of this process.
+struct WorkerPool {
+  base::Lock lock;
+  std::vector<WebWorkerObserver*> idle_observers;
+  int created_count = 0;
+  int reused_count = 0;
+  base::TimeDelta total_spawn_time;
+};
+
+base::LazyInstance<WorkerPool>::Leaky g_worker_pool = LAZY_INSTANCE_INITIALIZER;
+
+size_t GetWorkerPoolSize() {
+  static const size_t pool_size = [] {
+    unsigned size = 0;
+    base::StringToUint(
+        base::CommandLine::ForCurrentProcess()->GetSwitchValueASCII(
+            switches::kNodeWorkerPoolSize),
+        &size);
+    return static_cast<size_t>(size);
+  }();
+  return pool_size;
+}
+
 }  // namespace
 
 // static
 WebWorkerObserver* WebWorkerObserver::GetCurrent() {
   WebWorkerObserver* self = lazy_tls.Pointer()->Get();
-  return self ? self : new WebWorkerObserver;
+  if (self)
+    return self;
+
+  WorkerPool& pool = g_worker_pool.Get();
+  {
+    base::AutoLock auto_lock(pool.lock);
+    if (!pool.idle_observers.empty()) {
+      self = pool.idle_observers.back();
+      pool.idle_observers.pop_back();
+    }
+  }
+  if (!self)
+    self = new WebWorkerObserver;
+  lazy_tls.Pointer()->Set(self);
+  return self;
 }
 
 WebWorkerObserver::WebWorkerObserver()
     : node_bindings_(NodeBindings::Create(NodeBindings::WORKER)),
-      atom_bindings_(new AtomBindings(node_bindings_->uv_loop())) {
-  lazy_tls.Pointer()->Set(this);
-}
+      atom_bindings_(new AtomBindings(node_bindings_->uv_loop())) {}
 
-WebWorkerObserver::~WebWorkerObserver() {
-  lazy_tls.Pointer()->Set(nullptr);
-  node::FreeEnvironment(node_bindings_->uv_env());
-  asar::ClearArchives();
-}
+WebWorkerObserver::~WebWorkerObserver() {}
 
 void WebWorkerObserver::ContextCreated(v8::Local<v8::Context> context) {
+  base::TimeTicks start_time = base::TimeTicks::Now();
   v8::Context::Scope context_scope(context);
 
-  // Start the embed thread.
-  node_bindings_->PrepareMessageLoop();
+  // Start the embed thread, which keeps running for reused observers.
+  reused_ = message_loop_prepared_;
+  if (!message_loop_prepared_) {
+    node_bindings_->PrepareMessageLoop();
+    message_loop_prepared_ = true;
+  }
 
   // Setup node environment for each window.
   node::Environment* env = node_bindings_->CreateEnvironment(context);
 
   // Add Electron extended APIs.
   atom_bindings_->BindTo(env->isolate(), env->process_object());
+  mate::Dictionary process(env->isolate(), env->process_object());
+  process.SetMethod("getWorkerStatistics",
+                    base::Bind(&WebWorkerObserver::GetWorkerStatistics,
+                               base::Unretained(this)));
 
   // Load everything.
   node_bindings_->LoadEnvironment(env);
@@ -61,6 +110,14 @@ void WebWorkerObserver::ContextCreated(v8::Local<v8::Context> context) {
 
   // Give the node loop a run to make sure everything is ready.
   node_bindings_->RunMessageLoop();
+
+  spawn_time_ = base::TimeTicks::Now() - start_time;
+  WorkerPool& pool = g_worker_pool.Get();
+  base::AutoLock auto_lock(pool.lock);
+  pool.created_count++;
+  if (reused_)
+    pool.reused_count++;
+  pool.total_spawn_time += spawn_time_;
 }
 
 void WebWorkerObserver::ContextWillDestroy(v8::Local<v8::Context> context) {
@@ -68,7 +125,42 @@ void WebWorkerObserver::ContextWillDestroy(v8::Local<v8::Context> context) {
   if (env)
     mate::EmitEvent(env->isolate(), env->process_object(), "exit");
 
+  lazy_tls.Pointer()->Set(nullptr);
+  env = node_bindings_->uv_env();
+  atom_bindings_->EnvironmentDestroyed(env);
+  node::FreeEnvironment(env);
+  asar::ClearArchives();
+  mate::ClearKeyCache();
+
+  // Keep the uv loop and bindings for the next worker when the pool has room.
+  WorkerPool& pool = g_worker_pool.Get();
+  {
+    base::AutoLock auto_lock(pool.lock);
+    if (pool.idle_observers.size() < GetWorkerPoolSize()) {
+      node_bindings_->DetachFromThread();
+      pool.idle_observers.push_back(this);
+      return;
+    }
+  }
+
   delete this;
 }
 
+v8::Local<v8::Value> WebWorkerObserver::GetWorkerStatistics(
+    v8::Isolate* isolate) {
+  WorkerPool& pool = g_worker_pool.Get();
+  base::AutoLock auto_lock(pool.lock);
+  mate::Dictionary dict = mate::Dictionary::CreateEmpty(isolate);
+  dict.Set("spawnTime", spawn_time_.InMillisecondsF());
+  dict.Set("reused", reused_);
+  dict.Set("workersCreated", pool.created_count);
+  dict.Set("workersReused", pool.reused_count);
+  dict.Set("averageSpawnTime",
+           pool.created_count > 0
+               ? (pool.total_spawn_time / pool.created_count).InMillisecondsF()
+               : 0.0);
+  dict.Set("idleCount", static_cast<int>(pool.idle_observers.size()));
+  return dict.GetHandle();
+}
+
 }  // namespace atom
@@ -8,6 +8,7 @@
 #include <memory>
 
 #include "base/macros.h"
+#include "base/time/time.h"
 #include "v8/include/v8.h"
 
 namespace atom {
@@ -16,6 +17,10 @@ class AtomBindings;
 class NodeBindings;
 
 // Watches for WebWorker and insert node integration to it.
+//
+// When the --node-worker-pool-size switch is set, the observers of finished
+// workers are kept in a pool and handed to new workers, which then reuse the
+// uv loop, embed thread and Electron bindings instead of creating them again.
 class WebWorkerObserver {
  public:
   // Returns the WebWorkerObserver for current worker thread.
@@ -28,9 +33,21 @@ class WebWorkerObserver {
   WebWorkerObserver();
   ~WebWorkerObserver();
 
+  // Returns this worker's spawn time and the statistics of all workers.
+  v8::Local<v8::Value> GetWorkerStatistics(v8::Isolate* isolate);
+
   std::unique_ptr<NodeBindings> node_bindings_;
   std::unique_ptr<AtomBindings> atom_bindings_;
 
+  // Whether the uv loop has been prepared by a previous worker.
+  bool message_loop_prepared_ = false;
+
+  // Whether the current worker reused this observer from the pool.
+  bool reused_ = false;
+
+  // Time taken by ContextCreated for the current worker.
+  base::TimeDelta spawn_time_;
+
   DISALLOW_COPY_AND_ASSIGN(WebWorkerObserver);
 };
 
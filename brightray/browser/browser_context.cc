@@ -7,10 +7,12 @@
 #include <memory>
 #include <utility>
 
+#include "base/bind.h"
 #include "base/files/file_path.h"
 #include "base/path_service.h"
 #include "base/strings/string_util.h"
 #include "base/threading/thread_restrictions.h"
+#include "base/trace_event/trace_event.h"
 #include "brightray/browser/brightray_paths.h"
 #include "brightray/browser/browser_client.h"
 #include "brightray/browser/inspectable_web_contents_impl.h"
@@ -77,6 +79,10 @@ BrowserContext::BrowserContext(const std::string& partition, bool in_memory)
 
 BrowserContext::~BrowserContext() {
   DCHECK_CURRENTLY_ON(BrowserThread::UI);
+  // Lossy preferences are only written along with other changes, make them
+  // part of the write done when the PrefService is destroyed.
+  if (prefs_)
+    prefs_->SchedulePendingLossyWrites();
   NotifyWillBeDestroyed(this);
   ShutdownStoragePartitions();
   io_handle_->ShutdownOnUIThread();
@@ -91,19 +97,75 @@ void BrowserContext::OnDestruct() const {
 }
 
 void BrowserContext::InitPrefs() {
+  if (!prefs_)
+    CreatePrefService(false);
+}
+
+void BrowserContext::InitPrefsAsync() {
+  if (!prefs_)
+    CreatePrefService(true);
+}
+
+void BrowserContext::RunWhenPrefsLoaded(
+    base::OnceCallback<void(PrefService*)> callback) {
+  PrefService* pref_service = prefs();
+  if (pref_service->GetInitializationStatus() !=
+      PrefService::INITIALIZATION_STATUS_WAITING) {
+    std::move(callback).Run(pref_service);
+    return;
+  }
+  // The observers are destroyed with the PrefService.
+  pref_service->AddPrefInitObserver(base::BindOnce(
+      [](PrefService* pref_service,
+         base::OnceCallback<void(PrefService*)> callback,
+         bool) { std::move(callback).Run(pref_service); },
+      base::Unretained(pref_service), std::move(callback)));
+}
+
+PrefService* BrowserContext::prefs() {
+  InitPrefs();
+  return prefs_.get();
+}
+
+// static
+void BrowserContext::CommitPendingPrefWrites() {
+  for (const auto& it : browser_context_map_) {
+    BrowserContext* browser_context = it.second.get();
+    if (!browser_context || !browser_context->prefs_)
+      continue;
+    browser_context->prefs_->SchedulePendingLossyWrites();
+    browser_context->prefs_->CommitPendingWrite();
+  }
+}
+
+void BrowserContext::CreatePrefService(bool async) {
+  TRACE_EVENT1("startup", "BrowserContext::CreatePrefService", "async", async);
   auto prefs_path = GetPath().Append(FILE_PATH_LITERAL("Preferences"));
   base::ThreadRestrictions::ScopedAllowIO allow_io;
   PrefServiceFactory prefs_factory;
   scoped_refptr<JsonPrefStore> pref_store =
       base::MakeRefCounted<JsonPrefStore>(prefs_path);
-  pref_store->ReadPrefs();  // Synchronous.
+  // The file is read by the PrefService when it is asynchronous.
+  if (!async)
+    pref_store->ReadPrefs();  // Synchronous.
   prefs_factory.set_user_prefs(pref_store);
+  prefs_factory.set_async(async);
 
   auto registry = WrapRefCounted(new PrefRegistrySimple);
   RegisterInternalPrefs(registry.get());
   RegisterPrefs(registry.get());
 
   prefs_ = prefs_factory.Create(registry.get());
+  if (async) {
+    TRACE_EVENT_ASYNC_BEGIN0("startup", "BrowserContext::LoadPrefs", this);
+    prefs_->AddPrefInitObserver(base::BindOnce(&BrowserContext::OnPrefsLoaded,
+                                               weak_factory_.GetWeakPtr()));
+  }
+}
+
+void BrowserContext::OnPrefsLoaded(bool success) {
+  TRACE_EVENT_ASYNC_END1("startup", "BrowserContext::LoadPrefs", this,
+                         "success", success);
 }
 
 void BrowserContext::RegisterInternalPrefs(PrefRegistrySimple* registry) {
@@ -127,8 +189,18 @@ net::URLRequestContextGetter* BrowserContext::CreateRequestContext(
 }
 
 std::string BrowserContext::GetMediaDeviceIDSalt() {
-  if (!media_device_id_salt_.get())
-    media_device_id_salt_.reset(new MediaDeviceIDSalt(prefs_.get()));
+  if (!media_device_id_salt_.get()) {
+    // A salt stored now would be replaced by the persisted one, so device ids
+    // requested before the preferences are read are not persistent.
+    if (prefs()->GetInitializationStatus() ==
+        PrefService::INITIALIZATION_STATUS_WAITING) {
+      if (temporary_media_device_id_salt_.empty())
+        temporary_media_device_id_salt_ =
+            content::BrowserContext::CreateRandomMediaDeviceIDSalt();
+      return temporary_media_device_id_salt_;
+    }
+    media_device_id_salt_.reset(new MediaDeviceIDSalt(prefs()));
+  }
   return media_device_id_salt_->GetSalt();
 }
 
@@ -9,6 +9,7 @@
 #include <memory>
 #include <string>
 
+#include "base/callback_forward.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/weak_ptr.h"
 #include "brightray/browser/media/media_device_id_salt.h"
@@ -70,8 +71,26 @@ class BrowserContext
   std::string GetMediaDeviceIDSalt() override;
   base::FilePath GetPath() const override;
 
+  // Reads the preferences synchronously, unless they are already being read.
+  // Called by prefs(), so partitions that never use their preferences never
+  // read them.
   void InitPrefs();
-  PrefService* prefs() { return prefs_.get(); }
+
+  // Starts reading the preferences in the background. prefs() can be used
+  // right away, but only has the persisted values once they are loaded, and
+  // values set before that are replaced by the persisted ones.
+  void InitPrefsAsync();
+
+  // Runs |callback| with prefs() once the preferences have been read, right
+  // away unless they are being read in the background. Use it to write
+  // preferences that must not be lost.
+  void RunWhenPrefsLoaded(base::OnceCallback<void(PrefService*)> callback);
+
+  PrefService* prefs();
+
+  // Writes the preferences of all browser contexts, including the batched
+  // lossy ones, called at shutdown as contexts may outlive the message loop.
+  static void CommitPendingPrefWrites();
 
   virtual std::string GetUserAgent() const = 0;
   virtual void OnMainRequestContextCreated(URLRequestContextGetter* getter) {}
@@ -90,6 +109,8 @@ class BrowserContext
   friend struct BrowserContextDeleter;
 
   void RegisterInternalPrefs(PrefRegistrySimple* pref_registry);
+  void CreatePrefService(bool async);
+  void OnPrefsLoaded(bool success);
   void OnDestruct() const;
 
   // partition_id => browser_context
@@ -119,6 +140,8 @@ class BrowserContext
 
   std::unique_ptr<PrefService> prefs_;
   std::unique_ptr<MediaDeviceIDSalt> media_device_id_salt_;
+  // Used while the preferences holding the real salt are being read.
+  std::string temporary_media_device_id_salt_;
   // Self-destructing class responsible for creating URLRequestContextGetter
   // on the UI thread and deletes itself on the IO thread.
   URLRequestContextGetter::Handle* io_handle_;
@@ -292,6 +292,8 @@ void BrowserMainParts::PostMainMessageLoopStart() {
 }
 
 void BrowserMainParts::PostMainMessageLoopRun() {
+  BrowserContext::CommitPendingPrefWrites();
+
 #if defined(USE_X11)
   // Unset the X11 error handlers. The X11 error handlers log the errors using a
   // |PostTask()| on the message-loop. But since the message-loop is in the
@@ -199,7 +199,9 @@ void InspectableWebContentsImpl::RegisterPrefs(PrefRegistrySimple* registry) {
   RectToDictionary(gfx::Rect(0, 0, 800, 600), bounds_dict.get());
   registry->RegisterDictionaryPref(kDevToolsBoundsPref, std::move(bounds_dict));
   registry->RegisterDoublePref(kDevToolsZoomPref, 0.);
-  registry->RegisterDictionaryPref(kDevToolsPreferences);
+  // DevTools updates its settings constantly, batch them with other writes.
+  registry->RegisterDictionaryPref(kDevToolsPreferences,
+                                   PrefRegistry::LOSSY_PREF);
 }
 
 InspectableWebContentsImpl::InspectableWebContentsImpl(
@@ -381,12 +381,8 @@ net::URLRequestContext* URLRequestContextGetter::GetURLRequestContext() {
     http_network_session_.reset(new net::HttpNetworkSession(
         network_session_params, network_session_context));
 
-    std::unique_ptr<net::HttpCache::BackendFactory> backend;
-    if (in_memory_) {
-      backend = net::HttpCache::DefaultBackend::InMemory(0);
-    } else {
-      backend.reset(delegate_->CreateHttpCacheBackendFactory(base_path_));
-    }
+    std::unique_ptr<net::HttpCache::BackendFactory> backend(
+        delegate_->CreateHttpCacheBackendFactory(base_path_, in_memory_));
 
     storage_->set_http_transaction_factory(std::make_unique<net::HttpCache>(
         content::CreateDevToolsNetworkTransactionFactory(
@@ -53,7 +53,8 @@ class URLRequestContextGetter : public net::URLRequestContextGetter {
         net::URLRequestContext* url_request_context,
         content::ProtocolHandlerMap* protocol_handlers) = 0;
     virtual net::HttpCache::BackendFactory* CreateHttpCacheBackendFactory(
-        const base::FilePath& base_path) = 0;
+        const base::FilePath& base_path,
+        bool in_memory) = 0;
     virtual std::unique_ptr<net::CertVerifier> CreateCertVerifier(
         RequireCTDelegate* ct_delegate) = 0;
     virtual void GetCookieableSchemes(
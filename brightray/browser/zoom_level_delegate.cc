@@ -39,13 +39,19 @@ std::string GetHash(const base::FilePath& partition_path) {
 
 // static
 void ZoomLevelDelegate::RegisterPrefs(PrefRegistrySimple* registry) {
-  registry->RegisterDictionaryPref(kPartitionDefaultZoomLevel);
-  registry->RegisterDictionaryPref(kPartitionPerHostZoomLevels);
+  // Zoom levels change often and are not worth a write of their own, they
+  // are flushed at shutdown by BrowserContext.
+  registry->RegisterDictionaryPref(kPartitionDefaultZoomLevel,
+                                   PrefRegistry::LOSSY_PREF);
+  registry->RegisterDictionaryPref(kPartitionPerHostZoomLevels,
+                                   PrefRegistry::LOSSY_PREF);
 }
 
 ZoomLevelDelegate::ZoomLevelDelegate(PrefService* pref_service,
                                      const base::FilePath& partition_path)
-    : pref_service_(pref_service), host_zoom_map_(nullptr) {
+    : pref_service_(pref_service),
+      host_zoom_map_(nullptr),
+      weak_factory_(this) {
   DCHECK(pref_service_);
   partition_key_ = GetHash(partition_path);
 }
@@ -145,6 +151,21 @@ void ZoomLevelDelegate::InitHostZoomMap(content::HostZoomMap* host_zoom_map) {
   DCHECK(host_zoom_map);
   host_zoom_map_ = host_zoom_map;
 
+  // The preferences might still be read in the background.
+  if (pref_service_->GetInitializationStatus() ==
+      PrefService::INITIALIZATION_STATUS_WAITING) {
+    pref_service_->AddPrefInitObserver(base::BindOnce(
+        [](base::WeakPtr<ZoomLevelDelegate> self, bool) {
+          if (self)
+            self->LoadZoomLevels();
+        },
+        weak_factory_.GetWeakPtr()));
+    return;
+  }
+  LoadZoomLevels();
+}
+
+void ZoomLevelDelegate::LoadZoomLevels() {
   // Initialize the default zoom level.
   host_zoom_map_->SetDefaultZoomLevel(GetDefaultZoomLevelPref());
 
@@ -10,6 +10,7 @@
 
 #include "base/files/file_path.h"
 #include "base/macros.h"
+#include "base/memory/weak_ptr.h"
 #include "components/prefs/pref_service.h"
 #include "content/public/browser/host_zoom_map.h"
 #include "content/public/browser/zoom_level_delegate.h"
@@ -43,6 +44,10 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   void InitHostZoomMap(content::HostZoomMap* host_zoom_map) override;
 
  private:
+  // Reads the persisted zoom levels into the HostZoomMap, called once the
+  // preferences have been loaded.
+  void LoadZoomLevels();
+
   void ExtractPerHostZoomLevels(
       const base::DictionaryValue* host_zoom_dictionary);
 
@@ -56,6 +61,8 @@ class ZoomLevelDelegate : public content::ZoomLevelDelegate {
   std::unique_ptr<content::HostZoomMap::Subscription> zoom_subscription_;
   std::string partition_key_;
 
+  base::WeakPtrFactory<ZoomLevelDelegate> weak_factory_;
+
   DISALLOW_COPY_AND_ASSIGN(ZoomLevelDelegate);
 };
 
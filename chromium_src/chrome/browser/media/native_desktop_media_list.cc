@@ -11,10 +11,14 @@
 using base::PlatformThreadRef;
 
 #include "base/hash.h"
+#include "base/lazy_instance.h"
 #include "base/logging.h"
+#include "base/memory/ref_counted.h"
 #include "base/strings/string_number_conversions.h"
 #include "base/strings/utf_string_conversions.h"
+#include "base/synchronization/lock.h"
 #include "base/task_scheduler/post_task.h"
+#include "base/time/time.h"
 #include "chrome/browser/media/desktop_media_list_observer.h"
 #include "content/public/browser/browser_thread.h"
 #include "media/base/video_util.h"
@@ -33,15 +37,26 @@ namespace {
 // Update the list every second.
 const int kDefaultUpdatePeriod = 1000;
 
+// How long a cached thumbnail is reused before the source is scaled again.
+const int kThumbnailCacheTimeoutSeconds = 10;
+
 // Returns a hash of a DesktopFrame content to detect when image for a desktop
-// media source has changed.
+// media source has changed. The rows are hashed one by one since the stride of
+// the frame may be larger than its width.
 uint32_t GetFrameHash(webrtc::DesktopFrame* frame) {
-  int data_size = frame->stride() * frame->size().height();
-  return base::Hash(frame->data(), data_size);
+  const int width = frame->size().width();
+  const int height = frame->size().height();
+  uint32_t hash = static_cast<uint32_t>(base::HashInts32(width, height));
+  for (int y = 0; y < height; ++y) {
+    const uint8_t* row = frame->GetFrameDataAtPos(webrtc::DesktopVector(0, y));
+    hash = static_cast<uint32_t>(base::HashInts32(
+        hash, base::Hash(row, width * webrtc::DesktopFrame::kBytesPerPixel)));
+  }
+  return hash;
 }
 
-gfx::ImageSkia ScaleDesktopFrame(std::unique_ptr<webrtc::DesktopFrame> frame,
-                                 gfx::Size size) {
+SkBitmap ScaleDesktopFrame(std::unique_ptr<webrtc::DesktopFrame> frame,
+                           gfx::Size size) {
   gfx::Rect scaled_rect = media::ComputeLetterboxRegion(
       gfx::Rect(0, 0, size.width(), size.height()),
       gfx::Size(frame->size().width(), frame->size().height()));
@@ -67,9 +82,93 @@ gfx::ImageSkia ScaleDesktopFrame(std::unique_ptr<webrtc::DesktopFrame> frame,
     }
   }
 
-  return gfx::ImageSkia::CreateFrom1xBitmap(result);
+  result.setImmutable();
+  return result;
 }
 
+// Thumbnails of the sources, kept between media lists so the sources that did
+// not change since the last refresh are not scaled again. Thumbnails expire
+// after kThumbnailCacheTimeoutSeconds. It is shared by the workers and the
+// scaling tasks running on different threads.
+class ThumbnailCache {
+ public:
+  ThumbnailCache() {}
+
+  bool Get(const DesktopMediaID& id,
+           uint32_t frame_hash,
+           const gfx::Size& thumbnail_size,
+           SkBitmap* thumbnail) {
+    base::AutoLock auto_lock(lock_);
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second.frame_hash != frame_hash ||
+        it->second.thumbnail_size != thumbnail_size ||
+        IsExpired(it->second, base::TimeTicks::Now()))
+      return false;
+    *thumbnail = it->second.thumbnail;
+    return true;
+  }
+
+  void Put(const DesktopMediaID& id,
+           uint32_t frame_hash,
+           const gfx::Size& thumbnail_size,
+           const SkBitmap& thumbnail) {
+    base::AutoLock auto_lock(lock_);
+    entries_[id] = {frame_hash, thumbnail_size, thumbnail,
+                    base::TimeTicks::Now()};
+  }
+
+  // Forgets the expired thumbnails and the sources of |type| that are not in
+  // |ids| anymore.
+  void RemoveStaleEntries(DesktopMediaID::Type type,
+                          const std::set<DesktopMediaID>& ids) {
+    base::AutoLock auto_lock(lock_);
+    const base::TimeTicks now = base::TimeTicks::Now();
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      if (IsExpired(it->second, now) ||
+          (it->first.type == type && ids.find(it->first) == ids.end()))
+        it = entries_.erase(it);
+      else
+        ++it;
+    }
+  }
+
+ private:
+  struct Entry {
+    uint32_t frame_hash;
+    gfx::Size thumbnail_size;
+    SkBitmap thumbnail;
+    base::TimeTicks time;
+  };
+
+  static bool IsExpired(const Entry& entry, base::TimeTicks now) {
+    return now - entry.time >
+           base::TimeDelta::FromSeconds(kThumbnailCacheTimeoutSeconds);
+  }
+
+  base::Lock lock_;
+  std::map<DesktopMediaID, Entry> entries_;
+
+  DISALLOW_COPY_AND_ASSIGN(ThumbnailCache);
+};
+
+base::LazyInstance<ThumbnailCache>::Leaky g_thumbnail_cache =
+    LAZY_INSTANCE_INITIALIZER;
+
+// Runs |done| when the last reference is released, it is held by the worker
+// and by each task scaling a thumbnail of the same refresh.
+class RefreshBarrier : public base::RefCountedThreadSafe<RefreshBarrier> {
+ public:
+  explicit RefreshBarrier(base::OnceClosure done) : done_(std::move(done)) {}
+
+ private:
+  friend class base::RefCountedThreadSafe<RefreshBarrier>;
+  ~RefreshBarrier() { std::move(done_).Run(); }
+
+  base::OnceClosure done_;
+
+  DISALLOW_COPY_AND_ASSIGN(RefreshBarrier);
+};
+
 }  // namespace
 
 NativeDesktopMediaList::SourceDescription::SourceDescription(
@@ -89,7 +188,19 @@ class NativeDesktopMediaList::Worker
                content::DesktopMediaID::Id view_dialog_id);
 
  private:
-  typedef std::map<DesktopMediaID, uint32> ImageHashesMap;
+  // Scales |frame| on the thread pool and posts the thumbnail to the media
+  // list.
+  static void ScaleThumbnail(base::WeakPtr<NativeDesktopMediaList> media_list,
+                             int index,
+                             DesktopMediaID id,
+                             uint32_t frame_hash,
+                             std::unique_ptr<webrtc::DesktopFrame> frame,
+                             const gfx::Size& thumbnail_size,
+                             scoped_refptr<RefreshBarrier> barrier);
+
+  static void PostThumbnail(base::WeakPtr<NativeDesktopMediaList> media_list,
+                            int index,
+                            const SkBitmap& thumbnail);
 
   // webrtc::DesktopCapturer::Callback interface.
   void OnCaptureResult(webrtc::DesktopCapturer::Result result,
@@ -102,8 +213,6 @@ class NativeDesktopMediaList::Worker
 
   std::unique_ptr<webrtc::DesktopFrame> current_frame_;
 
-  ImageHashesMap image_hashes_;
-
   DISALLOW_COPY_AND_ASSIGN(Worker);
 };
 
@@ -162,19 +271,31 @@ void NativeDesktopMediaList::Worker::Refresh(
       BrowserThread::UI, FROM_HERE,
       base::Bind(&NativeDesktopMediaList::OnSourcesList, media_list_, sources));
 
-  ImageHashesMap new_image_hashes;
-
-  // Get a thumbnail for each source.
-  for (size_t i = 0; i < sources.size(); ++i) {
+  // Notify the media list once the last thumbnail has been posted.
+  auto barrier = base::MakeRefCounted<RefreshBarrier>(base::BindOnce(
+      [](base::WeakPtr<NativeDesktopMediaList> media_list) {
+        BrowserThread::PostTask(
+            BrowserThread::UI, FROM_HERE,
+            base::Bind(&NativeDesktopMediaList::OnRefreshFinished,
+                       media_list));
+      },
+      media_list_));
+
+  // Get a thumbnail for each source, an empty |thumbnail_size| means the
+  // thumbnails are not wanted.
+  std::set<DesktopMediaID> screen_ids, window_ids;
+  for (size_t i = 0; i < sources.size() && !thumbnail_size.IsEmpty(); ++i) {
     SourceDescription& source = sources[i];
     switch (source.id.type) {
       case DesktopMediaID::TYPE_SCREEN:
+        screen_ids.insert(source.id);
         if (!screen_capturer_->SelectSource(source.id.id))
           continue;
         screen_capturer_->CaptureFrame();
         break;
 
       case DesktopMediaID::TYPE_WINDOW:
+        window_ids.insert(source.id);
         if (!window_capturer_->SelectSource(source.id.id))
           continue;
         window_capturer_->CaptureFrame();
@@ -189,32 +310,64 @@ void NativeDesktopMediaList::Worker::Refresh(
     // been closed).
     if (current_frame_) {
       uint32_t frame_hash = GetFrameHash(current_frame_.get());
-      new_image_hashes[source.id] = frame_hash;
 
       // Scale the image only if it has changed.
-      ImageHashesMap::iterator it = image_hashes_.find(source.id);
-      if (it == image_hashes_.end() || it->second != frame_hash) {
-        gfx::ImageSkia thumbnail =
-            ScaleDesktopFrame(std::move(current_frame_), thumbnail_size);
-        BrowserThread::PostTask(
-            BrowserThread::UI, FROM_HERE,
-            base::Bind(&NativeDesktopMediaList::OnSourceThumbnail, media_list_,
-                       i, thumbnail));
+      SkBitmap thumbnail;
+      if (g_thumbnail_cache.Get().Get(source.id, frame_hash, thumbnail_size,
+                                      &thumbnail)) {
+        PostThumbnail(media_list_, i, thumbnail);
+      } else {
+        // The capturers may reuse the frame buffer for the next capture, so
+        // the scaling task gets its own copy.
+        std::unique_ptr<webrtc::DesktopFrame> frame(
+            webrtc::BasicDesktopFrame::CopyOf(*current_frame_));
+        base::PostTaskWithTraits(
+            FROM_HERE, {base::TaskPriority::USER_VISIBLE},
+            base::BindOnce(&Worker::ScaleThumbnail, media_list_, i, source.id,
+                           frame_hash, std::move(frame), thumbnail_size,
+                           barrier));
       }
+      current_frame_.reset();
     }
   }
 
-  image_hashes_.swap(new_image_hashes);
-
-  BrowserThread::PostTask(
-      BrowserThread::UI, FROM_HERE,
-      base::Bind(&NativeDesktopMediaList::OnRefreshFinished, media_list_));
+  if (screen_capturer_ && !thumbnail_size.IsEmpty())
+    g_thumbnail_cache.Get().RemoveStaleEntries(DesktopMediaID::TYPE_SCREEN,
+                                               screen_ids);
+  if (window_capturer_ && !thumbnail_size.IsEmpty())
+    g_thumbnail_cache.Get().RemoveStaleEntries(DesktopMediaID::TYPE_WINDOW,
+                                               window_ids);
 
   // Destroy capturers when done.
   screen_capturer_.reset();
   window_capturer_.reset();
 }
 
+// static
+void NativeDesktopMediaList::Worker::ScaleThumbnail(
+    base::WeakPtr<NativeDesktopMediaList> media_list,
+    int index,
+    DesktopMediaID id,
+    uint32_t frame_hash,
+    std::unique_ptr<webrtc::DesktopFrame> frame,
+    const gfx::Size& thumbnail_size,
+    scoped_refptr<RefreshBarrier> barrier) {
+  SkBitmap thumbnail = ScaleDesktopFrame(std::move(frame), thumbnail_size);
+  g_thumbnail_cache.Get().Put(id, frame_hash, thumbnail_size, thumbnail);
+  PostThumbnail(media_list, index, thumbnail);
+}
+
+// static
+void NativeDesktopMediaList::Worker::PostThumbnail(
+    base::WeakPtr<NativeDesktopMediaList> media_list,
+    int index,
+    const SkBitmap& thumbnail) {
+  BrowserThread::PostTask(
+      BrowserThread::UI, FROM_HERE,
+      base::Bind(&NativeDesktopMediaList::OnSourceThumbnail, media_list, index,
+                 gfx::ImageSkia::CreateFrom1xBitmap(thumbnail)));
+}
+
 void NativeDesktopMediaList::Worker::OnCaptureResult(
     webrtc::DesktopCapturer::Result result,
     std::unique_ptr<webrtc::DesktopFrame> frame) {
@@ -27,7 +27,7 @@ const MenuItem = function (options) {
 
   this.overrideReadOnlyProperty('type', 'normal')
   this.overrideReadOnlyProperty('role')
-  this.overrideReadOnlyProperty('accelerator')
+  this.overrideProperty('accelerator')
   this.overrideReadOnlyProperty('icon')
   this.overrideReadOnlyProperty('submenu')
 
@@ -37,6 +37,12 @@ const MenuItem = function (options) {
   this.overrideProperty('visible', true)
   this.overrideProperty('checked', false)
 
+  // The native menu keeps a copy of these, update it when they change.
+  this.overrideStateProperty('enabled')
+  this.overrideStateProperty('visible')
+  this.overrideStateProperty('checked')
+  this.overrideStateProperty('accelerator')
+
   if (!MenuItem.types.includes(this.type)) {
     throw new Error(`Unknown menu item type: ${this.type}`)
   }
@@ -72,6 +78,24 @@ MenuItem.prototype.overrideProperty = function (name, defaultValue = null) {
   }
 }
 
+MenuItem.prototype.overrideStateProperty = function (name) {
+  let value = this[name]
+  Object.defineProperty(this, name, {
+    enumerable: true,
+    configurable: true,
+    get: () => value,
+    set: (newValue) => {
+      value = newValue
+      if (!this.menu) return
+      if (name === 'accelerator') {
+        this.menu._updateCommandAccelerator(this)
+      } else {
+        this.menu._updateCommandState(this)
+      }
+    }
+  })
+}
+
 MenuItem.prototype.overrideReadOnlyProperty = function (name, defaultValue) {
   this.overrideProperty(name, defaultValue)
   Object.defineProperty(this, name, {
@@ -14,6 +14,7 @@ Object.setPrototypeOf(Menu.prototype, EventEmitter.prototype)
 
 // Menu Delegate.
 // This object should hold no reference to |Menu| to avoid cyclic reference.
+// The native menu only asks it about commands without a pushed state.
 const delegate = {
   isCommandIdChecked: (menu, id) => menu.commandsMap[id] ? menu.commandsMap[id].checked : undefined,
   isCommandIdEnabled: (menu, id) => menu.commandsMap[id] ? menu.commandsMap[id].enabled : undefined,
@@ -33,7 +34,10 @@ const delegate = {
     // Ensure radio groups have at least one menu item seleted
     for (const id in menu.groupsMap) {
       const found = menu.groupsMap[id].find(item => item.checked) || null
-      if (!found) v8Util.setHiddenValue(menu.groupsMap[id][0], 'checked', true)
+      if (!found) {
+        v8Util.setHiddenValue(menu.groupsMap[id][0], 'checked', true)
+        menu._updateCommandState(menu.groupsMap[id][0])
+      }
     }
   }
 }
@@ -122,6 +126,22 @@ Menu.prototype.insert = function (pos, item) {
   // Remember the items.
   this.items.splice(pos, 0, item)
   this.commandsMap[item.commandId] = item
+
+  // Push the state so the native menu does not have to ask for it.
+  this._updateCommandState(item)
+  this._updateCommandAccelerator(item)
+}
+
+Menu.prototype._updateCommandState = function (item) {
+  this.setCommandState(item.commandId, !!item.checked, !!item.enabled, !!item.visible)
+}
+
+Menu.prototype._updateCommandAccelerator = function (item) {
+  if (item.accelerator != null) {
+    this.setCommandAccelerator(item.commandId, item.accelerator, null)
+  } else {
+    this.setCommandAccelerator(item.commandId, null, item.getDefaultRoleAccelerator())
+  }
 }
 
 Menu.prototype._callMenuWillShow = function () {
@@ -246,6 +266,7 @@ function insertItemByType (item, pos) {
             if (other !== item) v8Util.setHiddenValue(other, 'checked', false)
           })
           v8Util.setHiddenValue(item, 'checked', true)
+          this.groupsMap[item.groupId].forEach(other => this._updateCommandState(other))
         }
       })
       this.insertRadioItem(pos, item.commandId, item.label, item.groupId)
@@ -28,6 +28,7 @@ module.exports = [
   { name: 'View', file: 'view' },
   { name: 'webContents', file: 'web-contents' },
   { name: 'WebContentsView', file: 'web-contents-view' },
+  { name: 'Worker', file: 'worker' },
   // The internal modules, invisible unless you know their names.
   { name: 'NavigationController', file: 'navigation-controller', private: true }
 ]
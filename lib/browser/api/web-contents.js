@@ -160,22 +160,64 @@ WebContents.prototype.executeJavaScript = function (code, hasUserGesture, callba
   }
 }
 
-WebContents.prototype.takeHeapSnapshot = function (filePath) {
+WebContents.prototype.takeHeapSnapshot = function (filePath, options = {}) {
   return new Promise((resolve, reject) => {
     const channel = `ELECTRON_TAKE_HEAP_SNAPSHOT_RESULT_${getNextId()}`
+    const { compress = false, onProgress } = options
+    // The renderer reports the bytes written so far before the final result.
+    const listener = (event, result) => {
+      if (typeof result === 'number') {
+        if (onProgress) onProgress(result)
+        return
+      }
+      ipcMain.removeListener(channel, listener)
+      if (result) {
+        resolve()
+      } else {
+        reject(new Error('takeHeapSnapshot failed'))
+      }
+    }
+    ipcMain.on(channel, listener)
+    this._takeHeapSnapshot(filePath, channel, {
+      compress,
+      reportProgress: typeof onProgress === 'function'
+    })
+  })
+}
+
+// Sends a profiling request to the renderer and waits for its result on a
+// private channel.
+const sendProfileRequest = function (name, send) {
+  return new Promise((resolve, reject) => {
+    const channel = `ELECTRON_CPU_PROFILE_RESULT_${getNextId()}`
     ipcMain.once(channel, (event, success) => {
       if (success) {
         resolve()
       } else {
-        reject(new Error('takeHeapSnapshot failed'))
+        reject(new Error(`${name} failed`))
       }
     })
-    if (!this._takeHeapSnapshot(filePath, channel)) {
-      ipcMain.emit(channel, false)
+    try {
+      send(channel)
+    } catch (error) {
+      ipcMain.removeAllListeners(channel)
+      reject(error)
     }
   })
 }
 
+WebContents.prototype.startCpuProfile = function (options = {}) {
+  return sendProfileRequest('startCpuProfile', (channel) => {
+    this._startCpuProfile(channel, options)
+  })
+}
+
+WebContents.prototype.stopCpuProfile = function (filePath) {
+  return sendProfileRequest('stopCpuProfile', (channel) => {
+    this._stopCpuProfile(filePath, channel)
+  })
+}
+
 // Translate the options of printToPDF.
 WebContents.prototype.printToPDF = function (options, callback) {
   const printingSetting = Object.assign({}, defaultPrintingSetting)
@@ -329,5 +371,42 @@ module.exports = {
 
   getAllWebContents () {
     return binding.getAllWebContents()
+  },
+
+  captureThumbnails (contentsList, options, callback) {
+    if (typeof options === 'function') {
+      callback = options
+      options = {}
+    }
+    const { concurrency = 4, buffers = [], ...captureOptions } = options
+    if (!Number.isInteger(concurrency) || concurrency < 1) {
+      throw new TypeError('Concurrency must be a positive integer')
+    }
+    const results = new Array(contentsList.length).fill(null)
+    let next = 0
+    let pending = contentsList.length
+    if (pending === 0) return process.nextTick(callback, results)
+
+    // Keep at most |concurrency| copies in flight so capturing many windows
+    // does not stall the compositor.
+    const captureNext = () => {
+      const index = next++
+      if (index >= contentsList.length) return
+      const contents = contentsList[index]
+      const done = (result) => {
+        results[index] = result
+        if (--pending === 0) {
+          callback(results)
+        } else {
+          captureNext()
+        }
+      }
+      if (contents.isDestroyed()) return process.nextTick(done, null)
+      const buffer = buffers[index]
+      contents.capturePixels(buffer ? { ...captureOptions, buffer } : captureOptions, done)
+    }
+    for (let i = 0; i < Math.min(concurrency, contentsList.length); i++) {
+      captureNext()
+    }
   }
 }
@@ -0,0 +1,6 @@
+const { EventEmitter } = require('events')
+const { Worker } = process.atomBinding('worker')
+
+Object.setPrototypeOf(Worker.prototype, EventEmitter.prototype)
+
+module.exports = Worker
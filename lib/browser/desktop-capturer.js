@@ -8,17 +8,54 @@ const deepEqual = (a, b) => JSON.stringify(a) === JSON.stringify(b)
 // A queue for holding all requests from renderer process.
 let requestsQueue = []
 
+// The last sources captured for each set of options, used to answer requests
+// that accept sources of a certain age without capturing again. Only the most
+// recently used sets of options are kept.
+const resultsCache = new Map()
+const maxCachedResults = 8
+
+const getCachedResult = (key) => {
+  const cached = resultsCache.get(key)
+  if (cached) {
+    resultsCache.delete(key)
+    resultsCache.set(key, cached)
+  }
+  return cached
+}
+
+const setCachedResult = (key, result) => {
+  resultsCache.delete(key)
+  resultsCache.set(key, { time: Date.now(), result })
+  if (resultsCache.size > maxCachedResults) {
+    resultsCache.delete(resultsCache.keys().next().value)
+  }
+}
+
 const electronSources = 'ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES'
 const capturerResult = (id) => `ELECTRON_RENDERER_DESKTOP_CAPTURER_RESULT_${id}`
+const capturerThumbnail = (id) => `ELECTRON_RENDERER_DESKTOP_CAPTURER_THUMBNAIL_${id}`
+
+ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize, id, extraOptions = {}) => {
+  const options = {
+    captureWindow,
+    captureScreen,
+    thumbnailSize
+  }
+
+  const { maxAge = 0, streamThumbnails = false } = extraOptions
+  const cached = getCachedResult(JSON.stringify(options))
+  if (cached && Date.now() - cached.time <= maxAge) {
+    if (streamThumbnails) {
+      cached.result.forEach(source => event.sender.send(capturerThumbnail(id), source))
+    }
+    event.sender.send(capturerResult(id), cached.result)
+    return
+  }
 
-ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize, id) => {
   const request = {
     id,
-    options: {
-      captureWindow,
-      captureScreen,
-      thumbnailSize
-    },
+    options,
+    streamThumbnails,
     webContents: event.sender
   }
   requestsQueue.push(request)
@@ -33,20 +70,36 @@ ipcMain.on(electronSources, (event, captureWindow, captureScreen, thumbnailSize,
   })
 })
 
-desktopCapturer.emit = (event, name, sources) => {
+const serializeSource = (source) => {
+  return {
+    id: source.id,
+    name: source.name,
+    thumbnail: source.thumbnail.toDataURL(),
+    display_id: source.display_id
+  }
+}
+
+const onThumbnail = (source) => {
+  // Send the thumbnail to the requests waiting for the running capture.
+  const handledRequest = requestsQueue[0]
+  let result = null
+  requestsQueue.forEach(request => {
+    const webContents = request.webContents
+    if (!webContents || !request.streamThumbnails) return
+    if (!deepEqual(handledRequest.options, request.options)) return
+    if (result === null) result = serializeSource(source)
+    webContents.send(capturerThumbnail(request.id), result)
+  })
+}
+
+const onFinished = (sources) => {
   // Receiving sources result from main process, now send them back to renderer.
   const handledRequest = requestsQueue.shift()
   const handledWebContents = handledRequest.webContents
   const unhandledRequestsQueue = []
 
-  const result = sources.map(source => {
-    return {
-      id: source.id,
-      name: source.name,
-      thumbnail: source.thumbnail.toDataURL(),
-      display_id: source.display_id
-    }
-  })
+  const result = sources.map(serializeSource)
+  setCachedResult(JSON.stringify(handledRequest.options), result)
 
   if (handledWebContents) {
     handledWebContents.send(capturerResult(handledRequest.id), result)
@@ -69,3 +122,12 @@ desktopCapturer.emit = (event, name, sources) => {
     return desktopCapturer.startHandling(captureWindow, captureScreen, thumbnailSize)
   }
 }
+
+desktopCapturer.emit = (event, name, ...args) => {
+  switch (name) {
+    case 'thumbnail':
+      return onThumbnail(...args)
+    case 'finished':
+      return onFinished(...args)
+  }
+}
@@ -387,6 +387,31 @@ ipcMain.on('ELECTRON_BROWSER_ASYNC_CALL_TO_GUEST_VIEW', function (event, context
   }
 })
 
+// Serves the promise-based clipboard methods of renderers that can not access
+// the clipboard themselves.
+const clipboardAsyncMethods = {
+  availableFormatsAsync: (type) => electron.clipboard.availableFormatsAsync(type),
+  readTextAsync: (type) => electron.clipboard.readTextAsync(type),
+  readRTFAsync: (type) => electron.clipboard.readRTFAsync(type),
+  readHTMLAsync: (type) => electron.clipboard.readHTMLAsync(type),
+  readBufferAsync: (format) => electron.clipboard.readBufferAsync(format),
+  readImageAsync: (type) => electron.clipboard.readImageAsync(type).then((image) => image.toPNGAsync()),
+  writeImageAsync: (buffer, type) => electron.clipboard.writeImageAsync(buffer, type)
+}
+
+ipcMain.on('ELECTRON_BROWSER_CLIPBOARD_ASYNC', function (event, requestId, method, ...args) {
+  const channel = `ELECTRON_RENDERER_CLIPBOARD_ASYNC_RESPONSE_${requestId}`
+  if (!hasProp.call(clipboardAsyncMethods, method)) {
+    event.sender.send(channel, `Unknown clipboard method ${method}`)
+    return
+  }
+  clipboardAsyncMethods[method](...args).then((result) => {
+    if (!event.sender.isDestroyed()) event.sender.send(channel, null, result)
+  }, (error) => {
+    if (!event.sender.isDestroyed()) event.sender.send(channel, error.message)
+  })
+})
+
 // Implements window.close()
 ipcMain.on('ELECTRON_BROWSER_WINDOW_CLOSE', function (event) {
   const window = event.sender.getOwnerBrowserWindow()
@@ -1,8 +1,41 @@
 if (process.platform === 'linux' && process.type === 'renderer') {
   // On Linux we could not access clipboard in renderer process.
-  module.exports = require('electron').remote.clipboard
+  const { ipcRenderer, nativeImage, remote } = require('electron')
+  const clipboard = Object.create(remote.clipboard)
+
+  // The promise-based methods are served by the main process asynchronously,
+  // so they do not block the renderer like the remote calls.
+  let nextRequestId = 0
+  const invokeInMainProcess = (method, ...args) => new Promise((resolve, reject) => {
+    const requestId = ++nextRequestId
+    ipcRenderer.once(`ELECTRON_RENDERER_CLIPBOARD_ASYNC_RESPONSE_${requestId}`, (event, error, result) => {
+      if (error) {
+        reject(new Error(error))
+      } else {
+        resolve(result)
+      }
+    })
+    ipcRenderer.send('ELECTRON_BROWSER_CLIPBOARD_ASYNC', requestId, method, ...args)
+  })
+
+  for (const method of ['availableFormatsAsync', 'readTextAsync', 'readRTFAsync', 'readHTMLAsync', 'readBufferAsync']) {
+    clipboard[method] = (...args) => invokeInMainProcess(method, ...args)
+  }
+
+  // Images are passed as PNG data, which is encoded and decoded in background
+  // threads on both sides.
+  clipboard.readImageAsync = (type) => {
+    return invokeInMainProcess('readImageAsync', type).then(nativeImage.createFromBufferAsync)
+  }
+  clipboard.writeImageAsync = (image, type) => {
+    const data = Buffer.isBuffer(image) ? Promise.resolve(image) : image.toPNGAsync()
+    return data.then((buffer) => invokeInMainProcess('writeImageAsync', buffer, type))
+  }
+
+  module.exports = clipboard
 } else {
   const clipboard = process.atomBinding('clipboard')
+  const { nativeImage } = require('electron')
 
   // Read/write to find pasteboard over IPC since only main process is notified
   // of changes
@@ -11,5 +44,16 @@ if (process.platform === 'linux' && process.type === 'renderer') {
     clipboard.writeFindText = require('electron').remote.clipboard.writeFindText
   }
 
+  // Encoded images are decoded in a background thread before being written.
+  const { _writeImageAsync } = clipboard
+  delete clipboard._writeImageAsync
+  clipboard.writeImageAsync = (image, type) => {
+    if (!Buffer.isBuffer(image)) return _writeImageAsync(image, type)
+    return nativeImage.createFromBufferAsync(image).then((decoded) => {
+      if (decoded.isEmpty()) throw new Error('Failed to decode the image')
+      return _writeImageAsync(decoded, type)
+    })
+  }
+
   module.exports = clipboard
 }
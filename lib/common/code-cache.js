@@ -0,0 +1,51 @@
+'use strict'
+
+// Compiles Electron's own modules through the V8 code cache, so processes
+// after the first one skip parsing and compiling them.
+
+const fs = require('original-fs')
+const path = require('path')
+const Module = require('module')
+const vm = require('vm')
+
+const v8Util = process.atomBinding('v8_util')
+
+const BASE_INTERNAL_PATH = path.resolve(__dirname, '..') + path.sep
+
+// The modules are cached by name, so the cache must be invalidated whenever
+// they change, which for packed modules means whenever the archive changes.
+const ARCHIVE_PATH = path.extname(BASE_INTERNAL_PATH) === '.asar'
+  ? BASE_INTERNAL_PATH.slice(0, -path.sep.length) : null
+let archiveStamp = null
+
+const getStamp = function (filename) {
+  if (ARCHIVE_PATH && archiveStamp) return archiveStamp
+  const stats = fs.statSync(ARCHIVE_PATH || filename)
+  const stamp = `${stats.size}-${stats.mtime.getTime()}`
+  if (ARCHIVE_PATH) archiveStamp = stamp
+  return stamp
+}
+
+// Node compiles the module wrapper with vm.runInThisContext, so it is replaced
+// for the duration of one compilation and node still creates the require
+// function and runs the module itself.
+const originalRunInThisContext = vm.runInThisContext
+const runInThisContextWithCodeCache = function (code, options) {
+  vm.runInThisContext = originalRunInThisContext
+  const { filename } = options
+  return v8Util.runScriptWithCodeCache(code, filename, getStamp(filename))
+}
+
+const originalCompile = Module.prototype._compile
+Module.prototype._compile = function (content, filename) {
+  if (!filename.startsWith(BASE_INTERNAL_PATH)) {
+    return originalCompile.call(this, content, filename)
+  }
+
+  vm.runInThisContext = runInThisContextWithCodeCache
+  try {
+    return originalCompile.call(this, content, filename)
+  } finally {
+    vm.runInThisContext = originalRunInThisContext
+  }
+}
@@ -3,6 +3,11 @@ const util = require('util')
 
 process.atomBinding = require('@electron/internal/common/atom-binding-setup')(process.binding, process.type)
 
+if (process.atomBinding('features').isInitCodeCacheEnabled() &&
+    !process.env.ELECTRON_DISABLE_INIT_CODE_CACHE) {
+  require('@electron/internal/common/code-cache')
+}
+
 // setImmediate and process.nextTick makes use of uv_check and uv_prepare to
 // run the callbacks, however since we only run uv loop on requests, the
 // callbacks wouldn't be called until something else activated the uv loop,
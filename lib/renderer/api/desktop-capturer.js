@@ -14,6 +14,15 @@ function isValid (options) {
   return Array.isArray(types)
 }
 
+function deserializeSource (source) {
+  return {
+    id: source.id,
+    name: source.name,
+    thumbnail: nativeImage.createFromDataURL(source.thumbnail),
+    display_id: source.display_id
+  }
+}
+
 exports.getSources = function (options, callback) {
   if (!isValid(options)) return callback(new Error('Invalid options'))
   const captureWindow = includes.call(options.types, 'window')
@@ -27,19 +36,20 @@ exports.getSources = function (options, callback) {
   }
 
   const id = incrementId()
-  ipcRenderer.send('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', captureWindow, captureScreen, options.thumbnailSize, id)
+  const streamThumbnails = typeof options.onThumbnail === 'function'
+  const extraOptions = {
+    maxAge: options.maxAge || 0,
+    streamThumbnails
+  }
+  const thumbnailChannel = `ELECTRON_RENDERER_DESKTOP_CAPTURER_THUMBNAIL_${id}`
+  if (streamThumbnails) {
+    ipcRenderer.on(thumbnailChannel, (event, source) => {
+      options.onThumbnail(deserializeSource(source))
+    })
+  }
+  ipcRenderer.send('ELECTRON_BROWSER_DESKTOP_CAPTURER_GET_SOURCES', captureWindow, captureScreen, options.thumbnailSize, id, extraOptions)
   return ipcRenderer.once(`ELECTRON_RENDERER_DESKTOP_CAPTURER_RESULT_${id}`, (event, sources) => {
-    callback(null, (() => {
-      const results = []
-      sources.forEach(source => {
-        results.push({
-          id: source.id,
-          name: source.name,
-          thumbnail: nativeImage.createFromDataURL(source.thumbnail),
-          display_id: source.display_id
-        })
-      })
-      return results
-    })())
+    ipcRenderer.removeAllListeners(thumbnailChannel)
+    callback(null, sources.map(deserializeSource))
   })
 }
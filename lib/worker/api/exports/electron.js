@@ -0,0 +1,14 @@
+const common = require('@electron/internal/common/api/exports/electron')
+
+// Only the modules that are safe to use off the main thread.
+Object.defineProperty(exports, 'nativeImage', {
+  enumerable: true,
+  get: common.memoizedGetter(() => require('@electron/internal/common/api/native-image'))
+})
+
+if (process._workerScriptPath) {
+  Object.defineProperty(exports, 'parentPort', {
+    enumerable: true,
+    get: common.memoizedGetter(() => require('@electron/internal/worker/parent-port'))
+  })
+}
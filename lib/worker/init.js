@@ -20,8 +20,23 @@ Module.globalPaths.push(path.join(__dirname, 'api', 'exports'))
 global.require = require
 global.module = module
 
-// Set the __filename to the path of html file if it is file: protocol.
-if (self.location.protocol === 'file:') {
+if (process._workerScriptPath) {
+  // Worker created in the main process, run its script as the main module.
+  const parentPort = require('@electron/internal/worker/parent-port')
+
+  // Report uncaught errors to the main process and stop the worker instead of
+  // quitting the app.
+  process.on('uncaughtException', (error) => {
+    const isError = error instanceof Error
+    process._reportWorkerError(isError ? error.message : String(error),
+      isError ? String(error.stack) : '')
+    parentPort.close()
+  })
+  process.exit = () => parentPort.close()
+
+  Module._load(process._workerScriptPath, null, true)
+} else if (self.location.protocol === 'file:') {
+  // Set the __filename to the path of html file if it is file: protocol.
   let pathname = process.platform === 'win32' && self.location.pathname[0] === '/' ? self.location.pathname.substr(1) : self.location.pathname
   global.__filename = path.normalize(decodeURIComponent(pathname))
   global.__dirname = path.dirname(global.__filename)
@@ -0,0 +1,20 @@
+'use strict'
+
+const { EventEmitter } = require('events')
+
+// The other end of the Worker object in the main process.
+const parentPort = new EventEmitter()
+
+parentPort.postMessage = function (message, transferList) {
+  process._postMessageToParent(message, transferList)
+}
+
+parentPort.close = function () {
+  process._closeWorker()
+}
+
+process.on('-worker-message', (message) => {
+  parentPort.emit('message', message)
+})
+
+module.exports = parentPort
@@ -6,6 +6,7 @@
 #define NATIVE_MATE_DICTIONARY_H_
 
 #include "native_mate/converter.h"
+#include "native_mate/key_cache.h"
 #include "native_mate/object_template_builder.h"
 
 namespace mate {
@@ -26,6 +27,9 @@ inline bool IsTrue(v8::Maybe<bool> maybe) {
 //
 //   http://heycam.github.io/webidl/#idl-dictionaries
 //
+// Keys passed as string literals are converted through the per-isolate key
+// cache, so prefer literals over temporary strings on hot paths.
+//
 // WARNING: You cannot retain a Dictionary object in the heap. The underlying
 //          storage for Dictionary is tied to the closest enclosing
 //          v8::HandleScope. Generally speaking, you should store a Dictionary
@@ -40,12 +44,12 @@ class Dictionary {
 
   static Dictionary CreateEmpty(v8::Isolate* isolate);
 
-  template <typename T>
-  bool Get(const base::StringPiece& key, T* out) const {
+  template <typename K, typename T>
+  bool Get(const K& key, T* out) const {
     // Check for existence before getting, otherwise this method will always
     // returns true when T == v8::Local<v8::Value>.
     v8::Local<v8::Context> context = isolate_->GetCurrentContext();
-    v8::Local<v8::String> v8_key = StringToV8(isolate_, key);
+    v8::Local<v8::String> v8_key = KeyToV8(isolate_, key);
     if (!internal::IsTrue(GetHandle()->Has(context, v8_key)))
       return false;
 
@@ -55,11 +59,11 @@ class Dictionary {
     return ConvertFromV8(isolate_, val, out);
   }
 
-  template <typename T>
-  bool GetHidden(const base::StringPiece& key, T* out) const {
+  template <typename K, typename T>
+  bool GetHidden(const K& key, T* out) const {
     v8::Local<v8::Context> context = isolate_->GetCurrentContext();
     v8::Local<v8::Private> privateKey =
-        v8::Private::ForApi(isolate_, StringToV8(isolate_, key));
+        v8::Private::ForApi(isolate_, KeyToV8(isolate_, key));
     v8::Local<v8::Value> value;
     v8::Maybe<bool> result = GetHandle()->HasPrivate(context, privateKey);
     if (internal::IsTrue(result) &&
@@ -68,50 +72,51 @@ class Dictionary {
     return false;
   }
 
-  template <typename T>
-  bool Set(const base::StringPiece& key, const T& val) {
+  template <typename K, typename T>
+  bool Set(const K& key, const T& val) {
     v8::Local<v8::Value> v8_value;
     if (!TryConvertToV8(isolate_, val, &v8_value))
       return false;
     v8::Maybe<bool> result = GetHandle()->Set(
-        isolate_->GetCurrentContext(), StringToV8(isolate_, key), v8_value);
+        isolate_->GetCurrentContext(), KeyToV8(isolate_, key), v8_value);
     return !result.IsNothing() && result.FromJust();
   }
 
-  template <typename T>
-  bool SetHidden(const base::StringPiece& key, T val) {
+  template <typename K, typename T>
+  bool SetHidden(const K& key, T val) {
     v8::Local<v8::Value> v8_value;
     if (!TryConvertToV8(isolate_, val, &v8_value))
       return false;
     v8::Local<v8::Context> context = isolate_->GetCurrentContext();
     v8::Local<v8::Private> privateKey =
-        v8::Private::ForApi(isolate_, StringToV8(isolate_, key));
+        v8::Private::ForApi(isolate_, KeyToV8(isolate_, key));
     v8::Maybe<bool> result =
         GetHandle()->SetPrivate(context, privateKey, v8_value);
     return !result.IsNothing() && result.FromJust();
   }
 
-  template <typename T>
-  bool SetReadOnly(const base::StringPiece& key, T val) {
+  template <typename K, typename T>
+  bool SetReadOnly(const K& key, T val) {
     v8::Local<v8::Value> v8_value;
     if (!TryConvertToV8(isolate_, val, &v8_value))
       return false;
     v8::Maybe<bool> result = GetHandle()->DefineOwnProperty(
-        isolate_->GetCurrentContext(), StringToV8(isolate_, key), v8_value,
+        isolate_->GetCurrentContext(), KeyToV8(isolate_, key), v8_value,
         v8::ReadOnly);
     return !result.IsNothing() && result.FromJust();
   }
 
-  template <typename T>
-  bool SetMethod(const base::StringPiece& key, const T& callback) {
+  template <typename K, typename T>
+  bool SetMethod(const K& key, const T& callback) {
     return GetHandle()->Set(
-        StringToV8(isolate_, key),
+        KeyToV8(isolate_, key),
         CallbackTraits<T>::CreateTemplate(isolate_, callback)->GetFunction());
   }
 
-  bool Delete(const base::StringPiece& key) {
+  template <typename K>
+  bool Delete(const K& key) {
     v8::Maybe<bool> result = GetHandle()->Delete(isolate_->GetCurrentContext(),
-                                                 StringToV8(isolate_, key));
+                                                 KeyToV8(isolate_, key));
     return !result.IsNothing() && result.FromJust();
   }
 
@@ -0,0 +1,79 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#include "native_mate/key_cache.h"
+
+#include <string.h>
+
+#include <string>
+#include <unordered_map>
+
+#include "base/lazy_instance.h"
+#include "base/threading/thread_local.h"
+
+namespace mate {
+
+namespace {
+
+// Isolates are not shared between threads in Electron, so the cache of each
+// thread only holds the keys of a single isolate.
+struct CachedKey {
+  std::string text;
+  v8::Eternal<v8::String> string;
+};
+
+struct KeyCache {
+  v8::Isolate* isolate = nullptr;
+  std::unordered_map<const char*, CachedKey> keys;
+};
+
+base::LazyInstance<base::ThreadLocalPointer<KeyCache>>::Leaky g_key_cache_tls =
+    LAZY_INSTANCE_INITIALIZER;
+
+}  // namespace
+
+namespace internal {
+
+v8::Local<v8::String> GetCachedKey(v8::Isolate* isolate,
+                                   const char* key,
+                                   size_t length) {
+  KeyCache* cache = g_key_cache_tls.Pointer()->Get();
+  if (!cache) {
+    cache = new KeyCache;
+    g_key_cache_tls.Pointer()->Set(cache);
+  }
+  if (cache->isolate != isolate) {
+    cache->isolate = isolate;
+    cache->keys.clear();
+  }
+
+  auto it = cache->keys.find(key);
+  if (it != cache->keys.end() && it->second.text.size() == length &&
+      memcmp(it->second.text.data(), key, length) == 0)
+    return it->second.string.Get(isolate);
+
+  v8::Local<v8::String> string =
+      v8::String::NewFromUtf8(isolate, key, v8::String::kInternalizedString,
+                              static_cast<uint32_t>(length));
+  // Eternal handles are never freed, so a buffer whose contents change is
+  // only cached with the key it held first.
+  if (it == cache->keys.end()) {
+    CachedKey& cached = cache->keys[key];
+    cached.text.assign(key, length);
+    cached.string.Set(isolate, string);
+  }
+  return string;
+}
+
+}  // namespace internal
+
+void ClearKeyCache() {
+  KeyCache* cache = g_key_cache_tls.Pointer()->Get();
+  if (cache) {
+    g_key_cache_tls.Pointer()->Set(nullptr);
+    delete cache;
+  }
+}
+
+}  // namespace mate
@@ -0,0 +1,47 @@
+// Copyright (c) 2018 GitHub, Inc.
+// Use of this source code is governed by the MIT license that can be
+// found in the LICENSE file.
+
+#ifndef NATIVE_MATE_KEY_CACHE_H_
+#define NATIVE_MATE_KEY_CACHE_H_
+
+#include <stddef.h>
+#include <string.h>
+
+#include "native_mate/converter.h"
+
+namespace mate {
+
+namespace internal {
+
+// Returns the internalized V8 string for |key|, the string is only created
+// once per isolate and then looked up by its address. The contents are
+// checked on each hit, so a buffer reused for another key is not mistaken
+// for the key it held before.
+v8::Local<v8::String> GetCachedKey(v8::Isolate* isolate,
+                                   const char* key,
+                                   size_t length);
+
+}  // namespace internal
+
+// Converts a property key to V8, char arrays (usually string literals) are
+// served from the key cache while other strings are created on each call.
+inline v8::Local<v8::String> KeyToV8(v8::Isolate* isolate,
+                                     const base::StringPiece& key) {
+  return StringToV8(isolate, key);
+}
+
+template <size_t N>
+inline v8::Local<v8::String> KeyToV8(v8::Isolate* isolate,
+                                     const char (&key)[N]) {
+  // A buffer can hold a string shorter than itself.
+  return internal::GetCachedKey(isolate, key, strnlen(key, N - 1));
+}
+
+// Drops the keys cached for the current thread, must be called before the
+// isolate of the thread is disposed.
+void ClearKeyCache();
+
+}  // namespace mate
+
+#endif  // NATIVE_MATE_KEY_CACHE_H_
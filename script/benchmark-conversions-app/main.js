@@ -0,0 +1,50 @@
+// Times the APIs that convert many native objects with string keys to
+// JavaScript, and reports the average time of a call in microseconds.
+const { app, session } = require('electron')
+
+const iterations = Number(process.env.BENCHMARK_ITERATIONS) || 10000
+const cookieCount = 200
+
+function time (iterations, fn) {
+  const start = process.hrtime()
+  for (let i = 0; i < iterations; i++) fn()
+  const [seconds, nanoseconds] = process.hrtime(start)
+  return (seconds * 1e6 + nanoseconds / 1e3) / iterations
+}
+
+function setCookies (cookies, count) {
+  const pending = []
+  for (let i = 0; i < count; i++) {
+    pending.push(new Promise((resolve, reject) => {
+      cookies.set({ url: 'http://example.com', name: `cookie${i}`, value: `${i}` },
+        error => error ? reject(error) : resolve())
+    }))
+  }
+  return Promise.all(pending)
+}
+
+async function timeCookies (cookies, iterations) {
+  const start = process.hrtime()
+  for (let i = 0; i < iterations; i++) {
+    await new Promise((resolve, reject) => {
+      cookies.get({}, (error, list) => error ? reject(error) : resolve(list))
+    })
+  }
+  const [seconds, nanoseconds] = process.hrtime(start)
+  return (seconds * 1e6 + nanoseconds / 1e3) / iterations
+}
+
+app.on('ready', async () => {
+  const { cookies } = session.fromPartition('benchmark-conversions')
+  await setCookies(cookies, cookieCount)
+
+  const results = {
+    'process.getHeapStatistics()': time(iterations, () => process.getHeapStatistics()),
+    'process.getSystemMemoryInfo()': time(iterations, () => process.getSystemMemoryInfo()),
+    'app.getAppMetrics()': time(iterations, () => app.getAppMetrics()),
+    [`cookies.get() of ${cookieCount} cookies`]: await timeCookies(cookies, iterations / 100)
+  }
+  process.stdout.write(JSON.stringify(results))
+  process.stdout.end()
+  app.quit()
+})
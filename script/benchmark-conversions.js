@@ -0,0 +1,58 @@
+#!/usr/bin/env node
+
+// Launches Electron repeatedly and reports percentiles of the time taken by
+// the APIs that convert many native objects to JavaScript, to measure the
+// native_mate key cache and other conversion changes between builds.
+//
+// Usage: npm run benchmark-conversions -- [--runs=N] [--iterations=N] [--xvfb]
+//
+//   --runs        Number of runs, defaults to 10.
+//   --iterations  Number of calls of each API in a run, defaults to 10000.
+//   --xvfb        Run Electron under xvfb-run (Linux).
+
+const cp = require('child_process')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const args = require('minimist')(process.argv.slice(2), {
+  boolean: ['xvfb'],
+  default: { runs: 10, iterations: 10000 }
+})
+
+const electronPath = utils.getAbsoluteElectronExec()
+const appPath = path.resolve(__dirname, 'benchmark-conversions-app')
+
+function launch () {
+  const command = args.xvfb ? 'xvfb-run' : electronPath
+  const commandArgs = args.xvfb ? ['-a', electronPath, appPath] : [appPath]
+  const env = Object.assign({}, process.env, {
+    BENCHMARK_ITERATIONS: String(args.iterations)
+  })
+  const child = cp.spawnSync(command, commandArgs, { encoding: 'utf8', env })
+  if (child.status !== 0) {
+    throw new Error(`Electron exited with ${child.status}: ${child.stderr}`)
+  }
+  return JSON.parse(child.stdout)
+}
+
+function percentile (samples, p) {
+  const sorted = samples.slice().sort((a, b) => a - b)
+  const index = Math.min(sorted.length - 1, Math.ceil(p / 100 * sorted.length) - 1)
+  return sorted[Math.max(0, index)]
+}
+
+function summarize (name, samples) {
+  const p50 = percentile(samples, 50).toFixed(2)
+  const p90 = percentile(samples, 90).toFixed(2)
+  console.log(`${name.padEnd(40)} p50 ${p50}us  p90 ${p90}us`)
+}
+
+const runs = []
+for (let i = 0; i < args.runs; i++) {
+  runs.push(launch())
+}
+
+for (const name of Object.keys(runs[0])) {
+  summarize(name, runs.map(run => run[name]))
+}
@@ -0,0 +1,19 @@
+// Opens the default app page and reports the startup timeline of the main
+// and renderer processes once it has loaded, then quits.
+const { app, BrowserWindow } = require('electron')
+const path = require('path')
+
+app.on('ready', () => {
+  const window = new BrowserWindow({ show: false })
+  window.webContents.once('did-finish-load', async () => {
+    const renderer = await window.webContents.executeJavaScript(
+      'process.getStartupTimeline()')
+    process.stdout.write(JSON.stringify({
+      browser: process.getStartupTimeline(),
+      renderer
+    }))
+    process.stdout.end()
+    app.quit()
+  })
+  window.loadFile(path.resolve(__dirname, '..', '..', 'default_app', 'index.html'))
+})
@@ -0,0 +1,116 @@
+#!/usr/bin/env node
+
+// Launches Electron repeatedly and reports percentiles of the cold and warm
+// startup times, together with the duration of each startup phase.
+//
+// Usage: npm run benchmark-startup -- [--runs=N] [--cold-runs=N] [--xvfb]
+//                                      [--drop-caches] [--compare-code-cache]
+//
+//   --runs         Number of warm runs, defaults to 20.
+//   --cold-runs    Number of cold runs, defaults to 1.
+//   --xvfb         Run Electron under xvfb-run (Linux).
+//   --drop-caches  Drop the page cache before each cold run (Linux, needs
+//                  root). Without it only the first run is really cold.
+//   --compare-code-cache
+//                  Also run with ELECTRON_DISABLE_INIT_CODE_CACHE set, to
+//                  compare builds with enable_init_code_cache. The renderer
+//                  LoadEnvironment phase is the time to the first user script.
+
+const cp = require('child_process')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const args = require('minimist')(process.argv.slice(2), {
+  boolean: ['xvfb', 'drop-caches', 'compare-code-cache'],
+  default: { runs: 20, 'cold-runs': 1 }
+})
+
+const electronPath = utils.getAbsoluteElectronExec()
+const appPath = path.resolve(__dirname, 'benchmark-startup-app')
+
+function dropCaches () {
+  cp.execSync('sync')
+  cp.execSync('echo 3 > /proc/sys/vm/drop_caches')
+}
+
+function launch (env = process.env) {
+  const command = args.xvfb ? 'xvfb-run' : electronPath
+  const commandArgs = args.xvfb ? ['-a', electronPath, appPath] : [appPath]
+  const start = process.hrtime()
+  const child = cp.spawnSync(command, commandArgs, { encoding: 'utf8', env })
+  const [seconds, nanoseconds] = process.hrtime(start)
+  if (child.status !== 0) {
+    throw new Error(`Electron exited with ${child.status}: ${child.stderr}`)
+  }
+  return {
+    total: seconds * 1e3 + nanoseconds / 1e6,
+    timeline: JSON.parse(child.stdout)
+  }
+}
+
+function percentile (samples, p) {
+  const sorted = samples.slice().sort((a, b) => a - b)
+  const index = Math.min(sorted.length - 1, Math.ceil(p / 100 * sorted.length) - 1)
+  return sorted[Math.max(0, index)]
+}
+
+function summarize (name, samples) {
+  const p50 = percentile(samples, 50).toFixed(1)
+  const p90 = percentile(samples, 90).toFixed(1)
+  const p99 = percentile(samples, 99).toFixed(1)
+  console.log(`${name.padEnd(40)} p50 ${p50}ms  p90 ${p90}ms  p99 ${p99}ms`)
+}
+
+// Groups the phase durations of all runs by process and phase name.
+function collectPhases (runs) {
+  const phases = {}
+  for (const run of runs) {
+    for (const type of ['browser', 'renderer']) {
+      for (const phase of run.timeline[type]) {
+        const key = `${type} ${phase.name}`
+        if (!phases[key]) phases[key] = []
+        phases[key].push(phase.end - phase.start)
+      }
+    }
+  }
+  return phases
+}
+
+const cold = []
+for (let i = 0; i < args['cold-runs']; i++) {
+  if (args['drop-caches']) dropCaches()
+  cold.push(launch())
+}
+
+const warm = []
+for (let i = 0; i < args.runs; i++) {
+  warm.push(launch())
+}
+
+summarize('Cold start', cold.map(run => run.total))
+summarize('Warm start', warm.map(run => run.total))
+console.log('')
+
+const phases = collectPhases(warm)
+for (const key of Object.keys(phases)) {
+  summarize(key, phases[key])
+}
+
+if (args['compare-code-cache']) {
+  const env = Object.assign({}, process.env, {
+    ELECTRON_DISABLE_INIT_CODE_CACHE: '1'
+  })
+  const uncached = []
+  for (let i = 0; i < args.runs; i++) {
+    uncached.push(launch(env))
+  }
+
+  console.log('')
+  console.log('Without init code cache:')
+  summarize('Warm start', uncached.map(run => run.total))
+  const uncachedPhases = collectPhases(uncached)
+  for (const key of Object.keys(uncachedPhases)) {
+    summarize(key, uncachedPhases[key])
+  }
+}
@@ -0,0 +1,77 @@
+// Measures the latency of libuv timers and sockets in the main process, and
+// reports the mean, median and maximum in milliseconds.
+const { app } = require('electron')
+const net = require('net')
+
+const iterations = Number(process.env.UV_LATENCY_ITERATIONS) || 200
+
+const summarize = (samples) => {
+  samples.sort((a, b) => a - b)
+  const total = samples.reduce((sum, sample) => sum + sample, 0)
+  return {
+    mean: total / samples.length,
+    median: samples[Math.floor(samples.length / 2)],
+    max: samples[samples.length - 1]
+  }
+}
+
+const now = () => {
+  const [seconds, nanoseconds] = process.hrtime()
+  return seconds * 1e3 + nanoseconds / 1e6
+}
+
+// Difference between when a 1ms timer fires and when it was due.
+const measureTimerJitter = () => new Promise((resolve) => {
+  const samples = []
+  const next = () => {
+    const start = now()
+    setTimeout(() => {
+      samples.push(now() - start - 1)
+      if (samples.length === iterations) {
+        resolve(summarize(samples))
+      } else {
+        next()
+      }
+    }, 1)
+  }
+  next()
+})
+
+// Round trip of a message echoed by a local TCP server.
+const measureEchoRoundTrip = () => new Promise((resolve, reject) => {
+  const server = net.createServer((socket) => socket.pipe(socket))
+  server.listen(0, '127.0.0.1', () => {
+    const samples = []
+    const client = net.connect(server.address().port, '127.0.0.1')
+    let start
+    const send = () => {
+      start = now()
+      client.write('x')
+    }
+    client.on('connect', send)
+    client.on('data', () => {
+      samples.push(now() - start)
+      if (samples.length === iterations) {
+        client.end()
+        server.close()
+        resolve(summarize(samples))
+      } else {
+        send()
+      }
+    })
+    client.on('error', reject)
+  })
+})
+
+app.on('ready', async () => {
+  const result = {
+    timerJitter: await measureTimerJitter(),
+    echoRoundTrip: await measureEchoRoundTrip()
+  }
+  process.stdout.write(JSON.stringify(result))
+  process.stdout.end()
+
+  setImmediate(() => {
+    app.quit()
+  })
+})
@@ -0,0 +1,68 @@
+#!/usr/bin/env node
+
+// Launches Electron repeatedly with and without --uv-message-pump and reports
+// percentiles of the latency of libuv timers and sockets in the main process.
+//
+// Usage: npm run benchmark-uv-latency -- [--runs=N] [--iterations=N] [--xvfb]
+//
+//   --runs        Number of runs of each mode, defaults to 10.
+//   --iterations  Number of samples of each measure in a run, defaults to 200.
+//   --xvfb        Run Electron under xvfb-run.
+
+const cp = require('child_process')
+const path = require('path')
+
+const utils = require('./lib/utils')
+
+const args = require('minimist')(process.argv.slice(2), {
+  boolean: ['xvfb'],
+  default: { runs: 10, iterations: 200 }
+})
+
+const electronPath = utils.getAbsoluteElectronExec()
+const appPath = path.resolve(__dirname, 'benchmark-uv-latency-app')
+
+function launch (switches) {
+  const command = args.xvfb ? 'xvfb-run' : electronPath
+  const commandArgs = [...switches, appPath]
+  if (args.xvfb) commandArgs.unshift('-a', electronPath)
+  const env = Object.assign({}, process.env, {
+    UV_LATENCY_ITERATIONS: String(args.iterations)
+  })
+  const child = cp.spawnSync(command, commandArgs, { encoding: 'utf8', env })
+  if (child.status !== 0) {
+    throw new Error(`Electron exited with ${child.status}: ${child.stderr}`)
+  }
+  return JSON.parse(child.stdout)
+}
+
+function percentile (samples, p) {
+  const sorted = samples.slice().sort((a, b) => a - b)
+  const index = Math.min(sorted.length - 1, Math.ceil(p / 100 * sorted.length) - 1)
+  return sorted[Math.max(0, index)]
+}
+
+function summarize (name, samples) {
+  const p50 = percentile(samples, 50).toFixed(3)
+  const p90 = percentile(samples, 90).toFixed(3)
+  console.log(`${name.padEnd(40)} p50 ${p50}ms  p90 ${p90}ms`)
+}
+
+const modes = {
+  'Embed thread': [],
+  '--uv-message-pump': ['--uv-message-pump']
+}
+
+for (const mode of Object.keys(modes)) {
+  const runs = []
+  for (let i = 0; i < args.runs; i++) {
+    runs.push(launch(modes[mode]))
+  }
+
+  console.log(`${mode}:`)
+  for (const measure of ['timerJitter', 'echoRoundTrip']) {
+    summarize(`${measure} mean`, runs.map(run => run[measure].mean))
+    summarize(`${measure} max`, runs.map(run => run[measure].max))
+  }
+  console.log('')
+}
@@ -2191,6 +2191,71 @@ describe('BrowserWindow module', () => {
     })
   })
 
+  describe('draggable regions', () => {
+    beforeEach(async () => {
+      await openTheWindow({ show: false, frame: false, width: 400, height: 400 })
+    })
+
+    // Waits until the browser's list of draggable regions satisfies |check|.
+    const waitForRegions = async (check) => {
+      for (let i = 0; i < 100; i++) {
+        const regions = w._getDraggableRegions()
+        if (check(regions)) return regions
+        await new Promise((resolve) => setTimeout(resolve, 50))
+      }
+      throw new Error('Draggable regions were not updated')
+    }
+
+    const loadRegions = async (hash = '') => {
+      w.loadFile(path.join(fixtures, 'pages', 'draggable-regions.html'), { hash })
+      await emittedOnce(w.webContents, 'did-finish-load')
+    }
+
+    it('applies changes to single regions', async () => {
+      await loadRegions()
+      const [first, second] = await waitForRegions((regions) => regions.length === 2)
+      expect(first.draggable).to.be.true()
+      expect(second.draggable).to.be.true()
+
+      w.webContents.executeJavaScript(`document.getElementById('second').style.top = '80px'`)
+      const moved = await waitForRegions((regions) => regions.length === 2 &&
+        regions[1].bounds.y !== second.bounds.y)
+      expect(moved[0]).to.deep.equal(first)
+      expect(moved[1].bounds.x).to.equal(second.bounds.x)
+      expect(moved[1].bounds.y).to.be.above(second.bounds.y)
+
+      w.webContents.executeJavaScript(`document.getElementById('second').remove()`)
+      const removed = await waitForRegions((regions) => regions.length === 1)
+      expect(removed[0]).to.deep.equal(first)
+    })
+
+    it('starts over when the page is reloaded', async () => {
+      await loadRegions()
+      await waitForRegions((regions) => regions.length === 2)
+      w.webContents.executeJavaScript(`document.getElementById('second').remove()`)
+      await waitForRegions((regions) => regions.length === 1)
+
+      w.webContents.reload()
+      await emittedOnce(w.webContents, 'did-finish-load')
+      await waitForRegions((regions) => regions.length === 2)
+    })
+
+    it('asks for the whole list after updates from another frame', async () => {
+      await loadRegions('iframe')
+      // Wait until both frames had a chance to send their regions.
+      await waitForRegions((regions) => regions.length > 0)
+      await new Promise((resolve) => setTimeout(resolve, 200))
+
+      // An update following the other frame's cannot be applied, so the page
+      // has to send its whole list again.
+      w.webContents.executeJavaScript(`document.getElementById('second').style.top = '80px'`)
+      const regions = await waitForRegions((regions) => regions.length === 2 &&
+        regions[1].bounds.y >= 3 * regions[0].bounds.height)
+      expect(regions[0].bounds.x).to.equal(0)
+      expect(regions[1].bounds.x).to.equal(0)
+    })
+  })
+
   describe('new-window event', () => {
     before(function () {
       if (isCI && process.platform === 'darwin') {
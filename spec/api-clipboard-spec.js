@@ -136,4 +136,49 @@ describe('clipboard module', () => {
       expect(buffer.equals(clipboard.readBuffer('public.utf8-plain-text'))).to.equal(true)
     })
   })
+
+  describe('async methods', () => {
+    it('reads text', async () => {
+      const text = '千江有水千江月，万里无云万里天'
+      clipboard.writeText(text)
+      expect(await clipboard.readTextAsync()).to.equal(text)
+    })
+
+    it('reads markup and RTF', async () => {
+      const rtf = '{\\rtf1\\utf8 text}'
+      clipboard.write({ html: '<b>Hi</b>', rtf })
+      expect(await clipboard.readHTMLAsync()).to.equal(clipboard.readHTML())
+      expect(await clipboard.readRTFAsync()).to.equal(rtf)
+    })
+
+    it('reads the available formats', async () => {
+      clipboard.writeText('formats')
+      expect(await clipboard.availableFormatsAsync()).to.deep.equal(clipboard.availableFormats())
+    })
+
+    it('writes and reads images', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png')
+      const i = nativeImage.createFromPath(p)
+      await clipboard.writeImageAsync(i)
+      const image = await clipboard.readImageAsync()
+      expect(image.toDataURL()).to.equal(i.toDataURL())
+    })
+
+    it('writes images from encoded data', async () => {
+      const p = path.join(fixtures, 'assets', 'logo.png')
+      const i = nativeImage.createFromPath(p)
+      await clipboard.writeImageAsync(i.toPNG())
+      expect(clipboard.readImage().toDataURL()).to.equal(i.toDataURL())
+    })
+
+    it('rejects invalid encoded data', async () => {
+      let error
+      try {
+        await clipboard.writeImageAsync(Buffer.from('not an image'))
+      } catch (e) {
+        error = e
+      }
+      expect(error).to.be.an('error')
+    })
+  })
 })
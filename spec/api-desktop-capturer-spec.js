@@ -63,6 +63,61 @@ describe('desktopCapturer', () => {
     desktopCapturer.getSources({ types: ['screen'] }, callback)
   })
 
+  it('returns sources without thumbnails for an empty thumbnailSize', done => {
+    desktopCapturer.getSources({
+      types: ['screen'],
+      thumbnailSize: { width: 0, height: 0 }
+    }, (error, sources) => {
+      expect(error).to.be.null()
+      expect(sources).to.be.an('array').that.is.not.empty()
+      for (const { thumbnail } of sources) {
+        expect(thumbnail.isEmpty()).to.be.true()
+      }
+      done()
+    })
+  })
+
+  it('streams the thumbnails before calling the callback', done => {
+    const streamed = []
+    desktopCapturer.getSources({
+      types: ['screen'],
+      onThumbnail: source => streamed.push(source.id)
+    }, (error, sources) => {
+      expect(error).to.be.null()
+      for (const id of streamed) {
+        expect(sources.map(source => source.id)).to.include(id)
+      }
+      done()
+    })
+  })
+
+  it('reuses recent sources with maxAge', done => {
+    desktopCapturer.getSources({ types: ['screen'] }, (error, sources) => {
+      expect(error).to.be.null()
+      desktopCapturer.getSources({ types: ['screen'], maxAge: 60000 }, (error, cachedSources) => {
+        expect(error).to.be.null()
+        expect(cachedSources.map(source => source.id)).to.deep.equal(sources.map(source => source.id))
+        done()
+      })
+    })
+  })
+
+  it('streams the thumbnails of sources reused with maxAge', done => {
+    desktopCapturer.getSources({ types: ['screen'] }, (error, sources) => {
+      expect(error).to.be.null()
+      const streamed = []
+      desktopCapturer.getSources({
+        types: ['screen'],
+        maxAge: 60000,
+        onThumbnail: source => streamed.push(source.id)
+      }, (error, cachedSources) => {
+        expect(error).to.be.null()
+        expect(streamed).to.deep.equal(cachedSources.map(source => source.id))
+        done()
+      })
+    })
+  })
+
   it('returns an empty display_id for window sources on Windows and Mac', done => {
     // Linux doesn't return any window sources.
     if (process.platform !== 'win32' && process.platform !== 'darwin') {
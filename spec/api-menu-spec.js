@@ -629,6 +629,60 @@ describe('Menu module', () => {
     })
   })
 
+  describe('Menu item state', () => {
+    it('reflects changes made after the item is inserted', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: '1', type: 'checkbox' },
+        { label: '2', visible: false }
+      ])
+      expect(menu.isItemCheckedAt(0)).to.be.false()
+      expect(menu.isEnabledAt(0)).to.be.true()
+      expect(menu.isVisibleAt(1)).to.be.false()
+
+      menu.items[0].checked = true
+      menu.items[0].enabled = false
+      menu.items[1].visible = true
+      expect(menu.isItemCheckedAt(0)).to.be.true()
+      expect(menu.isEnabledAt(0)).to.be.false()
+      expect(menu.isVisibleAt(1)).to.be.true()
+    })
+
+    it('unchecks the other items of a radio group', () => {
+      const menu = Menu.buildFromTemplate([
+        { label: '1', type: 'radio', checked: true },
+        { label: '2', type: 'radio' }
+      ])
+      expect(menu.isItemCheckedAt(0)).to.be.true()
+
+      menu.items[1].checked = true
+      expect(menu.isItemCheckedAt(0)).to.be.false()
+      expect(menu.isItemCheckedAt(1)).to.be.true()
+    })
+
+    it('pushes accelerators changed after the item is inserted', () => {
+      const calls = ipcRenderer.sendSync('eval', `(() => {
+        const { Menu } = require('electron')
+        const menu = Menu.buildFromTemplate([
+          { label: '1', accelerator: 'CmdOrCtrl+A' },
+          { label: '2', role: 'copy' }
+        ])
+        const calls = []
+        menu.setCommandAccelerator = (id, accelerator, defaultAccelerator) => {
+          calls.push([menu.getIndexOfCommandId(id), accelerator, defaultAccelerator])
+        }
+        menu.items[0].accelerator = 'CmdOrCtrl+B'
+        menu.items[1].accelerator = 'CmdOrCtrl+K'
+        menu.items[1].accelerator = null
+        return calls
+      })()`)
+      expect(calls).to.deep.equal([
+        [0, 'CmdOrCtrl+B', null],
+        [1, 'CmdOrCtrl+K', null],
+        [1, null, 'CommandOrControl+C']
+      ])
+    })
+  })
+
   describe('Menu.popup', () => {
     let w = null
     let menu
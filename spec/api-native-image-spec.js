@@ -3,6 +3,8 @@
 const chai = require('chai')
 const dirtyChai = require('dirty-chai')
 const { nativeImage } = require('electron')
+const fs = require('fs')
+const os = require('os')
 const path = require('path')
 
 const { expect } = chai
@@ -300,6 +302,78 @@ describe('nativeImage module', () => {
       expect(image.getSize()).to.deep.equal({ width: 538, height: 190 })
     })
 
+    describe('when the files change', () => {
+      let tmpDir
+
+      beforeEach(() => {
+        tmpDir = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-native-image-'))
+      })
+
+      afterEach(() => {
+        for (const name of fs.readdirSync(tmpDir)) {
+          fs.unlinkSync(path.join(tmpDir, name))
+        }
+        fs.rmdirSync(tmpDir)
+      })
+
+      const copyAsset = (name, target) => {
+        const targetPath = path.join(tmpDir, target)
+        fs.copyFileSync(path.join(__dirname, 'fixtures', 'assets', name), targetPath)
+        return targetPath
+      }
+
+      // Makes sure the modification is noticed on file systems with a coarse
+      // modification time.
+      const touch = (target) => {
+        const future = new Date(Date.now() + 60 * 1000)
+        fs.utimesSync(target, future, future)
+      }
+
+      it('finds scale factor variants added after the directory was read', () => {
+        const imagePath = copyAsset('1x1.png', 'icon.png')
+        const imageA = nativeImage.createFromPath(imagePath)
+        expect(imageA.toBitmap({ scaleFactor: 2.0 })).to.have.lengthOf(1 * 1 * 4)
+
+        copyAsset('2x2.jpg', 'icon@2x.png')
+        touch(tmpDir)
+        const imageB = nativeImage.createFromPath(imagePath)
+        expect(imageB.getSize()).to.deep.equal({ width: 1, height: 1 })
+        expect(imageB.toBitmap({ scaleFactor: 2.0 })).to.have.lengthOf(2 * 2 * 4)
+      })
+
+      it('loads images added after the directory was read', () => {
+        copyAsset('1x1.png', 'other.png')
+        nativeImage.createFromPath(path.join(tmpDir, 'other.png'))
+
+        // No touch, the listing of the directory may be out of date.
+        const imagePath = copyAsset('3x3.png', 'icon.png')
+        const image = nativeImage.createFromPath(imagePath)
+        expect(image.getSize()).to.deep.equal({ width: 3, height: 3 })
+      })
+
+      it('does not share writable pixels between images of the same file', () => {
+        const imagePath = copyAsset('1x1.png', 'icon.png')
+        const imageA = nativeImage.createFromPath(imagePath)
+        const imageB = nativeImage.createFromPath(imagePath)
+        const expected = imageB.toBitmap()
+
+        imageA.getBitmap().fill(0x7f)
+        expect(imageB.toBitmap().equals(expected)).to.be.true()
+        expect(imageA.toBitmap().equals(expected)).to.be.true()
+      })
+
+      it('reloads images modified after they were loaded', () => {
+        const imagePath = copyAsset('1x1.png', 'icon.png')
+        const imageA = nativeImage.createFromPath(imagePath)
+        expect(imageA.getSize()).to.deep.equal({ width: 1, height: 1 })
+
+        copyAsset('3x3.png', 'icon.png')
+        touch(imagePath)
+        const imageB = nativeImage.createFromPath(imagePath)
+        expect(imageB.getSize()).to.deep.equal({ width: 3, height: 3 })
+      })
+    })
+
     it('Gets an NSImage pointer on macOS', function () {
       if (process.platform !== 'darwin') {
         // FIXME(alexeykuzmin): Skip the test.
@@ -537,4 +611,75 @@ describe('nativeImage module', () => {
       expect(image.toDataURL({ scaleFactor: 2.0 })).to.equal(imageDataTwo.dataUrl)
     })
   })
+
+  describe('async methods', () => {
+    const logoPath = path.join(__dirname, 'fixtures', 'assets', 'logo.png')
+
+    it('toPNGAsync() returns the same image as toPNG()', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      for (const options of [{}, { scaleFactor: 2.0 }, { compressionLevel: 0 }, { compressionLevel: 9 }]) {
+        const buffer = await image.toPNGAsync(options)
+        const decoded = nativeImage.createFromBuffer(buffer)
+        expect(decoded.getSize()).to.deep.equal(image.getSize())
+        expect(decoded.toBitmap().equals(image.toBitmap())).to.be.true()
+      }
+    })
+
+    it('toPNGAsync() supports a compression level', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const stored = await image.toPNGAsync({ compressionLevel: 0 })
+      const compressed = await image.toPNGAsync({ compressionLevel: 9 })
+      expect(compressed).to.have.lengthOf.below(stored.length)
+      expect(() => image.toPNGAsync({ compressionLevel: 10 })).to.throw()
+    })
+
+    it('toJPEGAsync() returns a JPEG buffer', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const buffer = await image.toJPEGAsync(80)
+      expect(buffer).to.have.lengthOf.above(0)
+      expect(nativeImage.createFromBuffer(buffer).getSize()).to.deep.equal(image.getSize())
+    })
+
+    it('toDataURLAsync() returns a PNG data URL', async () => {
+      const imageData = getImage({ width: 3, height: 3 })
+      const image = nativeImage.createFromBuffer(nativeImage.createFromPath(imageData.path).toBitmap(), {
+        width: 3,
+        height: 3
+      })
+      const dataUrl = await image.toDataURLAsync()
+      expect(dataUrl.startsWith('data:image/png;base64,')).to.be.true()
+      const decoded = nativeImage.createFromDataURL(dataUrl)
+      expect(decoded.toBitmap().equals(image.toBitmap())).to.be.true()
+    })
+
+    it('createFromBufferAsync() decodes the buffer', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const decoded = await nativeImage.createFromBufferAsync(image.toPNG())
+      expect(decoded.getSize()).to.deep.equal(image.getSize())
+
+      const empty = await nativeImage.createFromBufferAsync(Buffer.from([]))
+      expect(empty.isEmpty()).to.be.true()
+    })
+
+    it('resizeAsync() returns a resized image', async () => {
+      const image = nativeImage.createFromPath(logoPath)
+      const resized = await image.resizeAsync({ width: 269 })
+      expect(resized.getSize()).to.deep.equal({ width: 269, height: 95 })
+      expect(resized.toBitmap().equals(image.resize({ width: 269 }).toBitmap())).to.be.true()
+
+      const empty = await nativeImage.createEmpty().resizeAsync({ width: 1, height: 1 })
+      expect(empty.isEmpty()).to.be.true()
+    })
+
+    it('resizeImages() resizes all the images', async () => {
+      const images = getImages({ format: ImageFormat.PNG })
+        .map(i => nativeImage.createFromPath(i.path))
+      const resized = await nativeImage.resizeImages(images, { height: 10 })
+      expect(resized).to.have.lengthOf(images.length)
+      resized.forEach((image, i) => {
+        expect(image.getSize()).to.deep.equal(images[i].resize({ height: 10 }).getSize())
+      })
+      expect(await nativeImage.resizeImages([], {})).to.deep.equal([])
+    })
+  })
 })
@@ -57,6 +57,40 @@ describe('process module', () => {
     })
   })
 
+  describe('process.getStartupTimeline()', () => {
+    it('returns the startup phases of the renderer', () => {
+      const timeline = process.getStartupTimeline()
+      const names = timeline.map(phase => phase.name)
+      expect(names).to.include.members(['CreateEnvironment', 'LoadEnvironment'])
+      for (const phase of timeline) {
+        expect(phase.end).to.be.at.least(phase.start)
+      }
+    })
+
+    it('returns the startup phases of the main process', () => {
+      const names = remote.process.getStartupTimeline().map(phase => phase.name)
+      expect(names).to.include.members([
+        'JavascriptEnvironment',
+        'CreateEnvironment',
+        'LoadEnvironment',
+        'PreMainMessageLoopRun',
+        'AppReady',
+        'FirstBrowserWindow'
+      ])
+    })
+  })
+
+  describe('process.getCodeCacheStatistics()', () => {
+    it('returns the code cache statistics', () => {
+      const stats = process.getCodeCacheStatistics()
+      expect(stats.produced).to.be.a('number')
+      expect(stats.accepted).to.be.a('number')
+      expect(stats.rejected).to.be.a('number')
+      // The asar support script always goes through the code cache.
+      expect(stats.produced + stats.accepted + stats.rejected).to.be.at.least(1)
+    })
+  })
+
   describe('process.getHeapStatistics()', () => {
     it('returns heap statistics object', () => {
       const heapStats = process.getHeapStatistics()
@@ -72,6 +106,23 @@ describe('process module', () => {
     })
   })
 
+  describe('process.getGCStatistics()', () => {
+    it('returns the GC pause statistics of the main process', () => {
+      const stats = remote.process.getGCStatistics()
+      expect(stats.scavengeCount).to.be.a('number')
+      expect(stats.markSweepCount).to.be.a('number')
+      expect(stats.incrementalMarkingCount).to.be.a('number')
+      expect(stats.idleGCCount).to.be.a('number')
+      expect(stats.fullGCCount).to.be.a('number')
+      expect(stats.totalPauseTime).to.be.at.least(stats.maxPauseTime)
+      expect(stats.maxPauseTime).to.be.at.least(stats.lastPauseTime)
+    })
+
+    it('is not available in the renderer process', () => {
+      expect(process.getGCStatistics).to.be.undefined()
+    })
+  })
+
   describe('process.takeHeapSnapshot()', () => {
     it('returns true on success', () => {
       const filePath = path.join(remote.app.getPath('temp'), 'test.heapsnapshot')
@@ -99,4 +150,70 @@ describe('process module', () => {
       expect(success).to.be.false()
     })
   })
+
+  describe('process.startSamplingHeapProfiler()', () => {
+    it('returns the sampled allocations when stopped', () => {
+      expect(process.startSamplingHeapProfiler({ samplingInterval: 1024 })).to.be.true()
+      const allocations = []
+      for (let i = 0; i < 1000; i++) allocations.push(new Array(100).fill(i))
+      const profile = process.stopSamplingHeapProfiler()
+      expect(profile.head).to.have.property('callFrame')
+      expect(profile.head.id).to.be.a('number')
+      expect(profile.head.children).to.be.an('array')
+    })
+
+    it('throws on invalid options', () => {
+      expect(() => {
+        process.startSamplingHeapProfiler({ samplingInterval: 0 })
+      }).to.throw(/Invalid sampling options/)
+    })
+  })
+
+  describe('process.startCpuProfile()', () => {
+    it('saves the profile when stopped', async () => {
+      const filePath = path.join(remote.app.getPath('temp'), 'test.cpuprofile')
+      expect(process.startCpuProfile({ samplingInterval: 100 })).to.be.true()
+      expect(process.startCpuProfile()).to.be.false()
+      let sum = 0
+      for (let i = 0; i < 100000; i++) sum += Math.sqrt(i)
+      expect(sum).to.be.above(0)
+      try {
+        await process.stopCpuProfile(filePath)
+        const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+        expect(profile.nodes).to.be.an('array').that.is.not.empty()
+        expect(profile.samples).to.be.an('array')
+        expect(profile.timeDeltas).to.have.lengthOf(profile.samples.length)
+        expect(profile.endTime).to.be.at.least(profile.startTime)
+      } finally {
+        try {
+          fs.unlinkSync(filePath)
+        } catch (e) {
+          // ignore error
+        }
+      }
+    })
+
+    it('leaves the file alone when no profile is recorded', async () => {
+      const filePath = path.join(remote.app.getPath('temp'), 'test-existing.cpuprofile')
+      fs.writeFileSync(filePath, 'existing')
+      try {
+        let error
+        try {
+          await process.stopCpuProfile(filePath)
+        } catch (e) {
+          error = e
+        }
+        expect(error).to.be.an('error')
+        expect(fs.readFileSync(filePath, 'utf8')).to.equal('existing')
+      } finally {
+        fs.unlinkSync(filePath)
+      }
+    })
+
+    it('throws on invalid options', () => {
+      expect(() => {
+        process.startCpuProfile({ samplingInterval: 0 })
+      }).to.throw(/Invalid sampling interval/)
+    })
+  })
 })
@@ -960,6 +960,138 @@ describe('protocol module', () => {
     })
   })
 
+  describe('protocol.enableResponseCache', () => {
+    const url = protocolName + '://fake-host/cached'
+
+    afterEach((done) => {
+      protocol.disableResponseCache(protocolName, () => done())
+    })
+
+    function request () {
+      return new Promise((resolve, reject) => {
+        $.ajax({
+          url,
+          success: resolve,
+          error: (xhr, errorType, error) => reject(error)
+        })
+      })
+    }
+
+    it('does not call the handler again for cached responses', (done) => {
+      let count = 0
+      const handler = (request, callback) => {
+        count++
+        callback(text)
+      }
+      protocol.registerStringProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        protocol.enableResponseCache(protocolName, { maxAge: 60 }, (error) => {
+          if (error) return done(error)
+          request().then((data) => {
+            assert.strictEqual(data, text)
+            return request()
+          }).then((data) => {
+            assert.strictEqual(data, text)
+            assert.strictEqual(count, 1)
+            done()
+          }).catch(done)
+        })
+      })
+    })
+
+    it('can be called with only the scheme', (done) => {
+      let count = 0
+      const handler = (request, callback) => {
+        count++
+        callback({ data: text, cache: { maxAge: 60 } })
+      }
+      protocol.registerStringProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        protocol.enableResponseCache(protocolName)
+        // Both calls run on the IO thread in order, so the cache is enabled
+        // once this one answers.
+        protocol.isProtocolHandled(protocolName, () => {
+          request().then(request).then((data) => {
+            assert.strictEqual(data, text)
+            assert.strictEqual(count, 1)
+            done()
+          }).catch(done)
+        })
+      })
+    })
+
+    it('does not answer POST requests from the cache', (done) => {
+      let count = 0
+      const handler = (request, callback) => {
+        count++
+        callback(request.method)
+      }
+      protocol.registerStringProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        protocol.enableResponseCache(protocolName, { maxAge: 60 }, (error) => {
+          if (error) return done(error)
+          request().then((data) => {
+            assert.strictEqual(data, 'GET')
+            return new Promise((resolve, reject) => {
+              $.ajax({
+                url,
+                type: 'POST',
+                data: postData,
+                success: resolve,
+                error: (xhr, errorType, error) => reject(error)
+              })
+            })
+          }).then((data) => {
+            assert.strictEqual(data, 'POST')
+            assert.strictEqual(count, 2)
+            done()
+          }).catch(done)
+        })
+      })
+    })
+
+    it('honors the Cache-Control header of the response', (done) => {
+      let count = 0
+      const handler = (request, callback) => {
+        count++
+        callback({ data: text, headers: { 'Cache-Control': 'no-store' } })
+      }
+      protocol.registerStringProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        protocol.enableResponseCache(protocolName, { maxAge: 60 }, (error) => {
+          if (error) return done(error)
+          request().then(request).then((data) => {
+            assert.strictEqual(data, text)
+            assert.strictEqual(count, 2)
+            done()
+          }).catch(done)
+        })
+      })
+    })
+
+    it('calls the handler again after clearing the cache', (done) => {
+      let count = 0
+      const handler = (request, callback) => {
+        count++
+        callback({ data: text, cache: { maxAge: 60 } })
+      }
+      protocol.registerStringProtocol(protocolName, handler, (error) => {
+        if (error) return done(error)
+        protocol.enableResponseCache(protocolName, (error) => {
+          if (error) return done(error)
+          request().then(() => {
+            return new Promise((resolve) => {
+              protocol.clearResponseCache(protocolName, () => resolve())
+            })
+          }).then(request).then(() => {
+            assert.strictEqual(count, 2)
+            done()
+          }).catch(done)
+        })
+      })
+    })
+  })
+
   describe('protocol.registerStandardSchemes', () => {
     const standardScheme = remote.getGlobal('standardScheme')
     const origin = `${standardScheme}://fake-host`
@@ -1,6 +1,8 @@
 const assert = require('assert')
+const ChildProcess = require('child_process')
 const http = require('http')
 const https = require('https')
+const os = require('os')
 const path = require('path')
 const fs = require('fs')
 const send = require('send')
@@ -59,6 +61,72 @@ describe('session module', () => {
       const ses2 = session.fromPartition(partition)
       assert.notStrictEqual(ses2.getUserAgent(), userAgent)
     })
+
+    it('throws a TypeError for an unknown cacheBackend', () => {
+      assert.throws(() => {
+        session.fromPartition('persist:unknown-cache-backend', { cacheBackend: 'unknown' })
+      }, TypeError)
+    })
+
+    describe('the preferences of a persistent session', () => {
+      const appPath = path.join(fixtures, 'api', 'async-preferences')
+      let server
+      let userData
+
+      before((done) => {
+        server = http.createServer((req, res) => res.end('<html></html>'))
+        server.listen(0, '127.0.0.1', done)
+      })
+
+      after(() => server.close())
+
+      beforeEach(() => {
+        userData = fs.mkdtempSync(path.join(os.tmpdir(), 'electron-preferences-'))
+      })
+
+      // Loads a page in a session of an app using |userData| and returns the
+      // zoom level of the page.
+      const runApp = (env) => new Promise((resolve, reject) => {
+        const appProcess = ChildProcess.spawn(remote.process.execPath, [appPath], {
+          env: {
+            ...remote.process.env,
+            TEST_USER_DATA: userData,
+            TEST_URL: `${url}:${server.address().port}`,
+            ...env
+          }
+        })
+        let output = ''
+        appProcess.stdout.on('data', (data) => { output += data })
+        appProcess.once('exit', () => {
+          try {
+            resolve(JSON.parse(output))
+          } catch (error) {
+            reject(error)
+          }
+        })
+      })
+
+      it('are read lazily', async () => {
+        assert.strictEqual(await runApp({ TEST_ZOOM_LEVEL: '2' }), 2)
+        assert.strictEqual(await runApp({}), 2)
+      })
+
+      it('are read in the background with asyncPreferences', async () => {
+        const async = { TEST_ASYNC_PREFERENCES: 'true' }
+        assert.strictEqual(await runApp({ ...async, TEST_ZOOM_LEVEL: '2' }), 2)
+        assert.strictEqual(await runApp(async), 2)
+        assert.strictEqual(await runApp({}), 2)
+      })
+
+      it('are loaded when whenPreferencesLoaded() resolves', async () => {
+        const ses = session.fromPartition('persist:when-preferences-loaded')
+        await ses.whenPreferencesLoaded()
+        const asyncSes = session.fromPartition('persist:when-preferences-loaded-async', {
+          asyncPreferences: true
+        })
+        await asyncSes.whenPreferencesLoaded()
+      })
+    })
   })
 
   describe('ses.cookies', () => {
@@ -197,6 +265,59 @@ describe('session module', () => {
       })
     })
 
+    it('emits the changes in batches with the changes event', (done) => {
+      const { cookies } = session.fromPartition('cookies-changes')
+
+      const names = []
+      const onChanges = (event, changes) => {
+        assert.ok(Array.isArray(changes))
+        for (const change of changes) {
+          assert.strictEqual(change.cause, 'explicit')
+          assert.strictEqual(change.removed, false)
+          names.push(change.cookie.name)
+        }
+        if (names.length < 2) return
+        cookies.removeListener('changes', onChanges)
+        assert.deepStrictEqual(names.sort(), ['a', 'b'])
+        done()
+      }
+      cookies.on('changes', onChanges)
+
+      cookies.setMany([
+        { url, name: 'a', value: '1' },
+        { url, name: 'b', value: '2' }
+      ], (error) => {
+        if (error) return done(error)
+      })
+    })
+
+    it('sets, filters and removes many cookies at once', (done) => {
+      const { cookies } = session.fromPartition('cookies-many')
+      cookies.setMany([
+        { url: 'http://example.com', name: 'a', value: '1' },
+        { url: 'http://sub.example.com', name: 'b', value: '2' },
+        { url: 'http://notexample.com', name: 'c', value: '3' },
+        { name: 'missing-url' }
+      ], (error, failed) => {
+        assert.ok(error)
+        assert.deepStrictEqual(failed, [3])
+        cookies.get({ domain: 'example.com' }, (error, list) => {
+          if (error) return done(error)
+          assert.deepStrictEqual(list.map(cookie => cookie.name).sort(), ['a', 'b'])
+          cookies.removeMany([
+            { url: 'http://example.com', name: 'a' },
+            { url: 'http://sub.example.com', name: 'b' }
+          ], () => {
+            cookies.get({}, (error, list) => {
+              if (error) return done(error)
+              assert.deepStrictEqual(list.map(cookie => cookie.name), ['c'])
+              done()
+            })
+          })
+        })
+      })
+    })
+
     describe('ses.cookies.flushStore(callback)', () => {
       it('flushes the cookies to disk and invokes the callback when done', (done) => {
         session.defaultSession.cookies.set({
@@ -568,7 +689,8 @@ describe('session module', () => {
       }
 
       server = https.createServer(options, (req, res) => {
-        res.writeHead(200)
+        // Every request needs a new connection and certificate verification.
+        res.writeHead(200, { Connection: 'close' })
         res.end('<title>hello</title>')
       })
       server.listen(0, '127.0.0.1', done)
@@ -616,6 +738,37 @@ describe('session module', () => {
       })
       w.loadURL(url)
     })
+
+    it('reuses the results of the proc within cacheTTL', (done) => {
+      let calls = 0
+      session.defaultSession.setCertificateVerifyProc((request, callback) => {
+        calls++
+        callback(0)
+      }, { cacheTTL: 60000 })
+
+      const url = `https://127.0.0.1:${server.address().port}`
+      w.webContents.once('did-finish-load', () => {
+        w.webContents.once('did-finish-load', () => {
+          assert.strictEqual(calls, 1)
+          session.defaultSession.getCertificateVerifyCacheStatistics(({ hits, misses, size }) => {
+            assert(hits > 0, hits)
+            assert.strictEqual(misses, 1)
+            assert.strictEqual(size, 1)
+
+            // Setting a new proc clears the cache.
+            session.defaultSession.setCertificateVerifyProc((request, callback) => callback(0))
+            session.defaultSession.getCertificateVerifyCacheStatistics(({ hits, misses, size }) => {
+              assert.strictEqual(hits, 0)
+              assert.strictEqual(misses, 0)
+              assert.strictEqual(size, 0)
+              done()
+            })
+          })
+        })
+        w.loadURL(`${url}/again`)
+      })
+      w.loadURL(url)
+    })
   })
 
   describe('ses.createInterruptedDownload(options)', () => {
@@ -747,6 +900,46 @@ describe('session module', () => {
     })
   })
 
+  describe('ses.getCacheStatistics(callback)', () => {
+    it('counts the requests served by the cache', (done) => {
+      const ses = session.fromPartition('cache-statistics', {
+        memoryCacheMaxSize: 1024 * 1024
+      })
+      const server = http.createServer((req, res) => {
+        res.setHeader('Cache-Control', 'max-age=60')
+        res.end('cached')
+      })
+      server.listen(0, '127.0.0.1', () => {
+        const port = server.address().port
+        function issueRequest (callback) {
+          const request = net.request({
+            url: `http://127.0.0.1:${port}/cached`,
+            session: ses
+          })
+          request.on('response', (response) => {
+            response.on('data', () => {})
+            response.on('end', () => callback())
+            response.on('error', (error) => { done(error) })
+          })
+          request.end()
+        }
+        issueRequest(() => {
+          issueRequest(() => {
+            ses.getCacheStatistics((statistics) => {
+              server.close()
+              assert.strictEqual(statistics.misses, 1)
+              assert.strictEqual(statistics.hits, 1)
+              assert.strictEqual(statistics.updates, 0)
+              assert.strictEqual(statistics.entries, 1)
+              assert(statistics.bytes > 0)
+              done()
+            })
+          })
+        })
+      })
+    })
+  })
+
   describe('ses.setPermissionRequestHandler(handler)', () => {
     it('cancels any pending requests when cleared', (done) => {
       const ses = session.fromPartition('permissionTest')
@@ -329,6 +329,114 @@ describe('webContents module', () => {
     })
   })
 
+  describe('sendInputEvents(events[, callback])', () => {
+    beforeEach((done) => {
+      w.loadFile(path.join(fixtures, 'pages', 'key-events.html'))
+      w.webContents.once('did-finish-load', () => done())
+    })
+
+    it('sends the events in order', (done) => {
+      const keys = []
+      const onKeyDown = (event, key) => {
+        keys.push(key)
+        if (keys.length === 3) {
+          ipcMain.removeListener('keydown', onKeyDown)
+          assert.deepStrictEqual(keys, ['a', 'b', 'c'])
+          done()
+        }
+      }
+      ipcMain.on('keydown', onKeyDown)
+      const count = w.webContents.sendInputEvents([
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'keyDown', keyCode: 'B' },
+        { type: 'keyDown', keyCode: 'C' }
+      ])
+      assert.strictEqual(count, 3)
+    })
+
+    it('coalesces mouse moves and wheel scrolls', () => {
+      const count = w.webContents.sendInputEvents([
+        { type: 'mouseMove', x: 1, y: 1, movementX: 1, movementY: 1 },
+        { type: 'mouseMove', x: 2, y: 2, movementX: 1, movementY: 1 },
+        { type: 'mouseMove', x: 3, y: 3, movementX: 1, movementY: 1 },
+        { type: 'mouseWheel', x: 3, y: 3, deltaX: 0, deltaY: -10 },
+        { type: 'mouseWheel', x: 3, y: 3, deltaX: 0, deltaY: -10 },
+        { type: 'mouseMove', x: 4, y: 4, modifiers: ['shift'] }
+      ])
+      assert.strictEqual(count, 3)
+    })
+
+    it('reports the latency of the batch', (done) => {
+      w.webContents.sendInputEvents([
+        { type: 'keyDown', keyCode: 'A' },
+        { type: 'keyUp', keyCode: 'A' }
+      ], (latency) => {
+        assert.strictEqual(typeof latency, 'number')
+        assert(latency >= 0)
+        done()
+      })
+    })
+
+    it('throws for invalid events without sending any', () => {
+      ipcMain.once('keydown', () => {
+        assert.fail('unexpected keydown event')
+      })
+      assert.throws(() => {
+        w.webContents.sendInputEvents([
+          { type: 'keyDown', keyCode: 'A' },
+          { type: 'notAnEvent' }
+        ])
+      }, /Invalid event object at index 1/)
+      ipcMain.removeAllListeners('keydown')
+    })
+  })
+
+  describe('capturePixels([options, ]callback)', () => {
+    beforeEach(async () => {
+      w.loadURL('data:text/html,<body style="background-color: red"></body>')
+      await emittedOnce(w, 'ready-to-show')
+      w.show()
+    })
+
+    it('scales the capture to the requested size', async () => {
+      const pixels = await new Promise((resolve) => {
+        w.webContents.capturePixels({ size: { width: 40, height: 30 }, format: 'rgba' }, resolve)
+      })
+      if (pixels === null) return
+      expect(pixels.width).to.equal(40)
+      expect(pixels.height).to.equal(30)
+      expect(pixels.format).to.equal('rgba')
+      expect(pixels.data.length).to.be.at.least(40 * 30 * 4)
+    })
+
+    it('throws for an invalid format', () => {
+      expect(() => {
+        w.webContents.capturePixels({ format: 'yuv' }, () => {})
+      }).to.throw(/Invalid pixel format/)
+    })
+
+    it('captures many web contents with webContents.captureThumbnails', async () => {
+      const results = await new Promise((resolve) => {
+        webContents.captureThumbnails([w.webContents, w.webContents, w.webContents], {
+          size: { width: 20, height: 20 },
+          concurrency: 2
+        }, resolve)
+      })
+      expect(results).to.have.lengthOf(3)
+      for (const pixels of results) {
+        if (pixels !== null) expect(pixels.width).to.equal(20)
+      }
+    })
+
+    it('throws for an invalid concurrency in webContents.captureThumbnails', () => {
+      for (const concurrency of [0, -1, NaN, 1.5]) {
+        expect(() => {
+          webContents.captureThumbnails([w.webContents], { concurrency }, () => {})
+        }).to.throw(TypeError, /Concurrency must be a positive integer/)
+      }
+    })
+  })
+
   it('supports inserting CSS', (done) => {
     w.loadURL('about:blank')
     w.webContents.insertCSS('body { background-repeat: round; }')
@@ -734,6 +842,52 @@ describe('webContents module', () => {
       })
       w.loadFile(path.join(fixtures, 'pages', 'a.html'))
     })
+
+    it('is triggered again after all listeners were removed and re-added', (done) => {
+      const listener = () => {}
+      w.webContents.on('console-message', listener)
+      w.webContents.removeListener('console-message', listener)
+      w.webContents.on('console-message', (e, level, message) => {
+        if (message === 'a') {
+          done()
+        }
+      })
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+    })
+  })
+
+  describe('native events', () => {
+    afterEach(() => {
+      ipcRenderer.sendSync('eval', 'delete global.emittedEvents')
+    })
+
+    it('are not emitted when they have no listeners', async () => {
+      // Native code converts the arguments right before calling emit(), so an
+      // event that never reaches emit() never had its arguments converted.
+      ipcRenderer.sendSync('eval', `(() => {
+        const contents = require('electron').webContents.fromId(${w.webContents.id})
+        const { emit } = Object.getPrototypeOf(contents)
+        const emittedEvents = global.emittedEvents = []
+        contents.emit = function (name, ...args) {
+          emittedEvents.push(name)
+          return emit.call(this, name, ...args)
+        }
+      })()`)
+      const loaded = emittedOnce(w.webContents, 'did-finish-load')
+      w.loadFile(path.join(fixtures, 'pages', 'a.html'))
+      await loaded
+      const emittedEvents = ipcRenderer.sendSync('eval', 'global.emittedEvents')
+      expect(emittedEvents).to.include('did-finish-load')
+      expect(emittedEvents).to.not.include('did-frame-finish-load')
+    })
+
+    it('are tracked through newListener and removeListener listeners', () => {
+      const eventNames = ipcRenderer.sendSync('eval', `(() => {
+        const contents = require('electron').webContents.fromId(${w.webContents.id})
+        return contents.eventNames()
+      })()`)
+      expect(eventNames).to.include.members(['newListener', 'removeListener'])
+    })
   })
 
   describe('referrer', () => {
@@ -833,6 +987,31 @@ describe('webContents module', () => {
       }
     })
 
+    it('writes compressed snapshots and reports progress', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'test.heapsnapshot.gz')
+      let bytesWritten = 0
+
+      try {
+        await w.webContents.takeHeapSnapshot(filePath, {
+          compress: true,
+          onProgress: (bytes) => { bytesWritten = bytes }
+        })
+        const data = fs.readFileSync(filePath)
+        expect(data[0]).to.equal(0x1f)
+        expect(data[1]).to.equal(0x8b)
+        expect(bytesWritten).to.be.above(0)
+      } finally {
+        try {
+          fs.unlinkSync(filePath)
+        } catch (e) {
+          // ignore error
+        }
+      }
+    })
+
     it('fails with invalid file path', async () => {
       w.destroy()
       w = new BrowserWindow({
@@ -849,4 +1028,51 @@ describe('webContents module', () => {
       return expect(promise).to.be.eventually.rejectedWith(Error, 'takeHeapSnapshot failed')
     })
   })
+
+  describe('startCpuProfile()', () => {
+    it('saves the profile of the renderer', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'test.cpuprofile')
+
+      try {
+        await w.webContents.startCpuProfile({ samplingInterval: 100 })
+        await w.webContents.executeJavaScript('for (let i = 0; i < 100000; i++) Math.sqrt(i)')
+        await w.webContents.stopCpuProfile(filePath)
+        const profile = JSON.parse(fs.readFileSync(filePath, 'utf8'))
+        expect(profile.nodes).to.be.an('array').that.is.not.empty()
+      } finally {
+        try {
+          fs.unlinkSync(filePath)
+        } catch (e) {
+          // ignore error
+        }
+      }
+    })
+
+    it('fails when not started', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'test.cpuprofile')
+      const promise = w.webContents.stopCpuProfile(filePath)
+      return expect(promise).to.be.eventually.rejectedWith(Error, 'stopCpuProfile failed')
+    })
+
+    it('leaves the file alone when not started', async () => {
+      w.loadURL('about:blank')
+      await emittedOnce(w.webContents, 'did-finish-load')
+
+      const filePath = path.join(remote.app.getPath('temp'), 'test.cpuprofile')
+      fs.writeFileSync(filePath, 'existing')
+      try {
+        const promise = w.webContents.stopCpuProfile(filePath)
+        await expect(promise).to.be.eventually.rejectedWith(Error, 'stopCpuProfile failed')
+        expect(fs.readFileSync(filePath, 'utf8')).to.equal('existing')
+      } finally {
+        fs.unlinkSync(filePath)
+      }
+    })
+  })
 })
@@ -158,4 +158,74 @@ describe('webFrame module', function () {
     const [, text] = await spellCheckerFeedback
     expect(text).to.equal(misspelledWord)
   })
+
+  it('calls a batch spellcheck provider', async () => {
+    w = new BrowserWindow({ show: false })
+    w.loadFile(path.join(fixtures, 'pages', 'webframe-spell-check-words.html'))
+    await emittedOnce(w.webContents, 'did-finish-load')
+
+    const spellCheckerFeedback = emittedOnce(ipcMain, 'spec-spell-check-words')
+    const misspelledWord = 'spleling'
+    for (const keyCode of [...misspelledWord, ' ']) {
+      w.webContents.sendInputEvent({ type: 'char', keyCode })
+    }
+    const [, words] = await spellCheckerFeedback
+    expect(words).to.deep.equal([misspelledWord])
+  })
+
+  // Types |word| in the input of the batch spellcheck fixture and resolves
+  // with the position of the word once the provider's results are applied.
+  const typeCheckedWord = async (word) => {
+    const spellCheckDone = emittedOnce(ipcMain, 'spec-spell-check-words-done')
+    for (const keyCode of [...word, ' ']) {
+      w.webContents.sendInputEvent({ type: 'char', keyCode })
+    }
+    const [, position] = await spellCheckDone
+    return position
+  }
+
+  // Resolves with the misspelled word the context menu reports at |position|.
+  const getMisspelledWordAt = async ({ x, y }) => {
+    const contextMenu = emittedOnce(w.webContents, 'context-menu')
+    for (const type of ['mouseDown', 'mouseUp']) {
+      w.webContents.sendInputEvent({ type, x, y, button: 'right', clickCount: 1 })
+    }
+    const [, params] = await contextMenu
+    return params.misspelledWord
+  }
+
+  it('marks the words reported by a batch spellcheck provider', async () => {
+    w = new BrowserWindow({ show: false })
+    w.loadFile(path.join(fixtures, 'pages', 'webframe-spell-check-words.html'))
+    await emittedOnce(w.webContents, 'did-finish-load')
+
+    const misspelledWord = 'spleling'
+    const position = await typeCheckedWord(misspelledWord)
+    expect(await getMisspelledWordAt(position)).to.equal(misspelledWord)
+  })
+
+  it('does not mark the words accepted by a batch spellcheck provider', async () => {
+    w = new BrowserWindow({ show: false })
+    w.loadFile(path.join(fixtures, 'pages', 'webframe-spell-check-words.html'))
+    await emittedOnce(w.webContents, 'did-finish-load')
+
+    const position = await typeCheckedWord('hello')
+    expect(await getMisspelledWordAt(position)).to.equal('')
+  })
+
+  it('checks the words again after clearSpellCheckCache()', async () => {
+    w = new BrowserWindow({ show: false })
+    w.loadFile(path.join(fixtures, 'pages', 'webframe-spell-check-words.html'))
+    await emittedOnce(w.webContents, 'did-finish-load')
+
+    const misspelledWord = 'spleling'
+    await typeCheckedWord(misspelledWord)
+    await w.webContents.executeJavaScript(
+      `require('electron').webFrame.clearSpellCheckCache()`)
+
+    const spellCheckerFeedback = emittedOnce(ipcMain, 'spec-spell-check-words')
+    await typeCheckedWord(misspelledWord)
+    const [, words] = await spellCheckerFeedback
+    expect(words).to.include(misspelledWord)
+  })
 })
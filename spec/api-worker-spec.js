@@ -0,0 +1,81 @@
+const chai = require('chai')
+const dirtyChai = require('dirty-chai')
+const path = require('path')
+const { emittedOnce } = require('./events-helpers')
+
+const { remote } = require('electron')
+const { Worker } = remote
+const { expect } = chai
+
+chai.use(dirtyChai)
+
+describe('Worker module', () => {
+  const fixtures = path.resolve(__dirname, 'fixtures', 'api', 'worker')
+  let worker
+
+  afterEach(() => {
+    if (worker) worker.terminate()
+    worker = null
+  })
+
+  it('requires an absolute script path', () => {
+    expect(() => new Worker('echo.js')).to.throw(/must be absolute/)
+  })
+
+  it('exchanges messages with the worker', async () => {
+    worker = new Worker(path.join(fixtures, 'echo.js'))
+    const value = { string: 'hello', array: [1, 2, 3], nested: { number: 42 } }
+    worker.postMessage({ type: 'echo', value })
+    const [, message] = await emittedOnce(worker, 'message')
+    expect(message.string).to.equal('hello')
+    expect(message.array).to.deep.equal([1, 2, 3])
+    expect(message.nested.number).to.equal(42)
+  })
+
+  it('runs Node.js and nativeImage in the worker', async () => {
+    worker = new Worker(path.join(fixtures, 'echo.js'))
+    worker.postMessage({ type: 'environment' })
+    const [, message] = await emittedOnce(worker, 'message')
+    expect(message.type).to.equal('worker')
+    expect(message.isEmpty).to.be.true()
+  })
+
+  it('transfers ArrayBuffers without copying', (done) => {
+    const { roundTrip } = remote.require(path.join(fixtures, 'transfer.js'))
+    roundTrip((result) => {
+      expect(result.sentLength).to.equal(0)
+      expect(result.receivedLength).to.equal(16)
+      expect(result.receivedValue).to.equal(42)
+      expect(result.detachedLength).to.equal(0)
+      done()
+    })
+  })
+
+  it('emits "error" for uncaught exceptions', async () => {
+    worker = new Worker(path.join(fixtures, 'throw.js'))
+    const errored = emittedOnce(worker, 'error')
+    const exited = emittedOnce(worker, 'exit')
+    worker.postMessage({})
+    const [, error] = await errored
+    expect(error.message).to.equal('worker failed')
+    await exited
+    expect(worker.isRunning()).to.be.false()
+  })
+
+  it('stops the worker instead of the app on process.exit()', async () => {
+    worker = new Worker(path.join(fixtures, 'echo.js'))
+    const exited = emittedOnce(worker, 'exit')
+    worker.postMessage({ type: 'exit' })
+    await exited
+    expect(worker.isRunning()).to.be.false()
+    expect(() => worker.postMessage({})).to.throw(/has exited/)
+  })
+
+  it('emits "exit" after terminate()', async () => {
+    worker = new Worker(path.join(fixtures, 'echo.js'))
+    const exited = emittedOnce(worker, 'exit')
+    worker.terminate()
+    await exited
+    expect(worker.isRunning()).to.be.false()
+  })
+})
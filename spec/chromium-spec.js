@@ -876,6 +876,30 @@ describe('chromium feature', () => {
       document.body.appendChild(webview)
     })
 
+    it('Worker reuses node environments with nodeWorkerPoolSize', (done) => {
+      const w = new BrowserWindow({
+        show: false,
+        webPreferences: {
+          nodeIntegrationInWorker: true,
+          nodeWorkerPoolSize: 2
+        }
+      })
+      ipcMain.once('worker-statistics', (event, statistics) => {
+        closeWindow(w).then(() => {
+          // The page runs a monitor worker next to three workers, which run
+          // one after another, so all but the first one take an environment
+          // from the pool.
+          assert.strictEqual(statistics.workersCreated, 4)
+          assert.strictEqual(statistics.reused, true)
+          assert.strictEqual(statistics.workersReused, 2)
+          assert.ok(statistics.spawnTime >= 0)
+          assert.ok(statistics.averageSpawnTime >= 0)
+          done()
+        })
+      })
+      w.loadFile(path.join(fixtures, 'pages', 'worker-pool.html'))
+    })
+
     it('SharedWorker can work', (done) => {
       const worker = new SharedWorker('../fixtures/workers/shared_worker.js')
       const message = 'ping'
@@ -0,0 +1,22 @@
+const { app, session, BrowserWindow } = require('electron')
+
+app.setPath('userData', process.env.TEST_USER_DATA)
+
+app.on('ready', async () => {
+  const ses = session.fromPartition('persist:preferences', {
+    asyncPreferences: process.env.TEST_ASYNC_PREFERENCES === 'true'
+  })
+  const w = new BrowserWindow({ show: false, webPreferences: { session: ses } })
+  // Zoom levels are restored and saved once the preferences have been read.
+  await ses.whenPreferencesLoaded()
+  w.webContents.once('did-finish-load', () => {
+    if (process.env.TEST_ZOOM_LEVEL) {
+      w.webContents.setZoomLevel(Number(process.env.TEST_ZOOM_LEVEL))
+    }
+    w.webContents.getZoomLevel((level) => {
+      process.stdout.write(JSON.stringify(level))
+      app.quit()
+    })
+  })
+  w.loadURL(process.env.TEST_URL)
+})
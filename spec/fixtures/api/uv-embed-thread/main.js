@@ -0,0 +1,38 @@
+// Reports whether the main process polls libuv from an embed thread, and
+// whether uv timers and sockets still run.
+const { app } = require('electron')
+const fs = require('fs')
+const net = require('net')
+
+const hasEmbedThread = () => fs.readdirSync('/proc/self/task').some((tid) => {
+  const name = fs.readFileSync(`/proc/self/task/${tid}/comm`, 'utf8').trim()
+  return name === 'NodeEmbedThread'
+})
+
+const echo = () => new Promise((resolve, reject) => {
+  const server = net.createServer((socket) => socket.pipe(socket))
+  server.listen(0, '127.0.0.1', () => {
+    const client = net.connect(server.address().port, '127.0.0.1')
+    client.on('connect', () => client.write('x'))
+    client.on('data', (data) => {
+      client.end()
+      server.close()
+      resolve(data.toString())
+    })
+    client.on('error', reject)
+  })
+})
+
+app.on('ready', async () => {
+  const result = {
+    embedThread: hasEmbedThread(),
+    timer: await new Promise((resolve) => setTimeout(() => resolve(true), 1)),
+    echo: await echo()
+  }
+  process.stdout.write(JSON.stringify(result))
+  process.stdout.end()
+
+  setImmediate(() => {
+    app.quit()
+  })
+})
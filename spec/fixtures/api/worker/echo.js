@@ -0,0 +1,25 @@
+const { nativeImage, parentPort } = require('electron')
+
+parentPort.on('message', (message) => {
+  switch (message.type) {
+    case 'echo':
+      parentPort.postMessage(message.value)
+      break
+    case 'environment':
+      parentPort.postMessage({
+        type: process.type,
+        isEmpty: nativeImage.createEmpty().isEmpty()
+      })
+      break
+    case 'transfer': {
+      const { buffer } = message
+      new Uint8Array(buffer)[0] += 1
+      parentPort.postMessage({ buffer }, [buffer])
+      parentPort.postMessage({ detachedLength: buffer.byteLength })
+      break
+    }
+    case 'exit':
+      process.exit(0)
+      break
+  }
+})
@@ -0,0 +1,5 @@
+const { parentPort } = require('electron')
+
+parentPort.on('message', () => {
+  throw new Error('worker failed')
+})
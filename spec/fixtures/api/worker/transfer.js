@@ -0,0 +1,23 @@
+const { Worker } = require('electron')
+const path = require('path')
+
+// Transfers an ArrayBuffer from the main process to a worker and back.
+exports.roundTrip = (callback) => {
+  const worker = new Worker(path.join(__dirname, 'echo.js'))
+  const buffer = new ArrayBuffer(16)
+  new Uint8Array(buffer)[0] = 41
+
+  const messages = []
+  worker.on('message', (event, message) => {
+    messages.push(message)
+    if (messages.length < 2) return
+    worker.terminate()
+    callback({
+      sentLength: buffer.byteLength,
+      receivedLength: messages[0].buffer.byteLength,
+      receivedValue: new Uint8Array(messages[0].buffer)[0],
+      detachedLength: messages[1].detachedLength
+    })
+  })
+  worker.postMessage({ type: 'transfer', buffer }, [buffer])
+}
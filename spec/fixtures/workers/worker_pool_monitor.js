@@ -0,0 +1,11 @@
+// Tells the page each time a finished worker returned its environment to the
+// pool, the pool is shared by all the workers of the process.
+let { idleCount } = process.getWorkerStatistics()
+const poll = () => {
+  const statistics = process.getWorkerStatistics()
+  if (statistics.idleCount > idleCount) self.postMessage('returned')
+  idleCount = statistics.idleCount
+  setTimeout(poll)
+}
+self.postMessage('ready')
+poll()
@@ -0,0 +1 @@
+self.postMessage(process.getWorkerStatistics())
@@ -277,6 +277,41 @@ describe('node feature', () => {
         })
       })
     })
+
+    describe('--uv-message-pump', () => {
+      before(function () {
+        if (process.platform !== 'linux') this.skip()
+      })
+
+      const runEmbedThreadApp = (args) => new Promise((resolve, reject) => {
+        const appPath = path.join(fixtures, 'api', 'uv-embed-thread')
+        const appProcess = ChildProcess.spawn(remote.process.execPath, [...args, appPath])
+        let output = ''
+        appProcess.stdout.on('data', (data) => { output += data })
+        appProcess.on('error', reject)
+        appProcess.on('close', () => {
+          try {
+            resolve(JSON.parse(output))
+          } catch (error) {
+            reject(error)
+          }
+        })
+      })
+
+      it('runs uv timers and sockets from the message loop', async () => {
+        const result = await runEmbedThreadApp(['--uv-message-pump'])
+        assert.strictEqual(result.embedThread, false)
+        assert.strictEqual(result.timer, true)
+        assert.strictEqual(result.echo, 'x')
+      })
+
+      it('still polls from the embed thread by default', async () => {
+        const result = await runEmbedThreadApp([])
+        assert.strictEqual(result.embedThread, true)
+        assert.strictEqual(result.timer, true)
+        assert.strictEqual(result.echo, 'x')
+      })
+    })
   })
 
   describe('net.connect', () => {